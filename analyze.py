@@ -8,6 +8,8 @@ import toml
 from datetime import datetime
 import pytz
 
+from trajectory import read_dataframe
+
 # Force matplotlib to not use any Xwindows/Qt backend.
 import matplotlib
 matplotlib.use('Agg')
@@ -42,8 +44,7 @@ def get_settling_time(df, threshold=0.02):
 
 def process_run(csv_path, toml_path, threshold):
     try:
-        df = pd.read_csv(csv_path)
-        df.columns = df.columns.str.strip()
+        df = read_dataframe(csv_path)
     except Exception as e:
         return None, None
 
@@ -2,6 +2,10 @@ import pandas as pd
 import numpy as np
 import argparse
 import sys
+import time
+
+from telemetry import Telemetry
+from trajectory import read_dataframe
 
 # WGS84 Constants
 EARTH_RADIUS_M = 6378137.0
@@ -58,10 +62,9 @@ def check_quaternion_norm(df):
     return max_error
 
 
-def inspect(filename, stable_threshold):
+def inspect(filename, stable_threshold, t_start=None, t_end=None):
     try:
-        df = pd.read_csv(filename)
-        df.columns = df.columns.str.strip()
+        df = read_dataframe(filename, t_start=t_start, t_end=t_end)
     except FileNotFoundError:
         print(f"Error: File '{filename}' not found.")
         sys.exit(1)
@@ -167,10 +170,40 @@ def inspect(filename, stable_threshold):
     print("=" * 60)
 
 
+def live(name, period):
+    """Print the newest state of a running simulation every `period` seconds until it ends (or Ctrl-C)."""
+    try:
+        telemetry = Telemetry(name)
+    except (FileNotFoundError, ValueError) as e:
+        print(f"Error attaching to '{name}': {e}")
+        sys.exit(1)
+
+    rods = [c for c in telemetry.columns if c.startswith("M_")]
+    try:
+        while True:
+            sample = telemetry.latest(1)
+            if not sample.empty:
+                row = sample.iloc[-1]
+                w = np.sqrt(row["w_x"] ** 2 + row["w_y"] ** 2 + row["w_z"] ** 2)
+                rod_text = " ".join(f"{c}={row[c]:.4g}" for c in rods)
+                print(
+                    f"t = {row['time']:.1f} s  |w| = {w:.6f} rad/s  "
+                    f"q = ({row['q_w']:.4f}, {row['q_x']:.4f}, {row['q_y']:.4f}, {row['q_z']:.4f})  {rod_text}"
+                )
+            if telemetry.finished:
+                print("Simulation finished")
+                break
+            time.sleep(period)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        telemetry.close()
+
+
 if __name__ == "__main__":
     parser = argparse.ArgumentParser(description="Inspect AOS Simulation Results")
     parser.add_argument(
-        "filename", nargs="?", default="output.csv", help="CSV file to inspect"
+        "filename", nargs="?", default="output.csv", help="Trajectory file (CSV, binary or <output>.segments manifest) to inspect"
     )
     parser.add_argument(
         "--threshold",
@@ -178,6 +211,13 @@ if __name__ == "__main__":
         default=0.02,
         help="Angular velocity threshold for stability [rad/s] (default: 0.02)",
     )
+    parser.add_argument("--start", type=float, default=None, help="Inspect only rows from this time on [s]")
+    parser.add_argument("--end", type=float, default=None, help="Inspect only rows up to this time [s]")
+    parser.add_argument("--live", default=None, help="Follow a running simulation's telemetry ring ([observer.telemetry] name)")
+    parser.add_argument("--period", type=float, default=1.0, help="Refresh period of --live [s] (default: 1.0)")
 
     args = parser.parse_args()
-    inspect(args.filename, args.threshold)
+    if args.live:
+        live(args.live, args.period)
+    else:
+        inspect(args.filename, args.threshold, args.start, args.end)
@@ -13,6 +13,8 @@ import matplotlib.pyplot as plt
 import numpy as np
 import pandas as pd
 
+from trajectory import read_dataframe
+
 
 # ---------------------------------------------------------
 # SIMULATION MANAGEMENT
@@ -102,8 +104,7 @@ def set_axes_equal(ax):
 
 def plot_data(filename, output_dir, prefix, plot_types, display_mode, dpi, t_start=None, t_end=None):
     try:
-        df = pd.read_csv(filename)
-        df.columns = df.columns.str.strip()
+        df = read_dataframe(filename)
     except FileNotFoundError:
         print(f"Error: File '{filename}' not found.")
         sys.exit(1)
@@ -0,0 +1,279 @@
+#include "batch_runner.hpp"
+
+#include "aos/batch/ensemble.hpp"
+#include "aos/components/spacecraft.hpp"
+#include "aos/core/ensemble_state.hpp"
+#include "aos/core/constants.hpp"
+#include "aos/core/state.hpp"
+#include "aos/core/types.hpp"
+#include "aos/environment/environment.hpp"
+#include "aos/environment/orbital_mechanics.hpp"
+#include "aos/simulation/config.hpp"
+#include "aos/simulation/dynamics.hpp"
+#include "aos/simulation/observer.hpp"
+#include "aos/simulation/simulation.hpp"
+#include "aos/simulation/statistics_observer.hpp"
+#include "aos/simulation/stop_criteria.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <print>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aos {
+
+namespace {
+
+constexpr auto status_names = std::to_array<std::string_view>({"completed", "converged", "deorbited", "unstable", "failed"});
+
+}  // namespace
+
+batch_runner::batch_runner(const environment_properties& environment, std::size_t num_threads) : _pool(num_threads) {
+    _environments.reserve(_pool.size());
+    _environments.push_back(environment::create(environment));
+    while (_environments.size() < _pool.size()) {
+        _environments.push_back(_environments.front()->clone());
+    }
+}
+
+auto batch_runner::num_threads() const -> std::size_t {
+    return _pool.size();
+}
+
+auto batch_runner::run(const batch_design& design, std::size_t ensemble_lanes) -> std::vector<batch_result> {
+    using clock = std::chrono::steady_clock;
+
+    const auto&               jobs = design.jobs;
+    const std::span           all_jobs(jobs);
+    std::vector<batch_result> results(jobs.size());
+    std::atomic<std::size_t>  finished{0};
+
+    // one unit per job, or per pack of consecutive jobs integrated as an ensemble
+    struct work_unit {
+        std::size_t first;
+        std::size_t count;
+        real        cost;
+    };
+
+    const bool packed = ensemble_lanes > 1;
+    const auto lanes  = packed ? std::min(ensemble_lanes, static_cast<std::size_t>(ensemble_state::max_lanes)) : std::size_t{1};
+
+    std::vector<work_unit> units;
+    for (std::size_t first = 0; first < jobs.size(); first += lanes) {
+        const auto count = std::min(lanes, jobs.size() - first);
+        real       cost  = 0.0;
+        for (const auto& job : all_jobs.subspan(first, count)) {
+            cost += estimate_cost(job.properties);
+        }
+        units.push_back({.first = first, .count = count, .cost = cost});
+    }
+
+    // longest first, the pool deals each unit to the least loaded worker
+    std::ranges::stable_sort(units, std::ranges::greater{}, &work_unit::cost);
+
+    const auto start = clock::now();
+    _pool.reset_statistics();
+
+    for (const auto& unit : units) {
+        _pool.submit(
+            [&, unit](std::size_t worker) {
+                if (packed) {
+                    const auto pack_results = run_ensemble(all_jobs.subspan(unit.first, unit.count), _environments[worker], _tables);
+                    std::ranges::copy(pack_results, results.begin() + static_cast<std::ptrdiff_t>(unit.first));
+                } else {
+                    results[unit.first] = run_job(jobs[unit.first], _environments[worker], _tables);
+                }
+                std::print("Runs: {} / {}\r", finished += unit.count, jobs.size());
+            },
+            unit.cost);
+    }
+
+    _pool.wait();
+    std::print("\n");
+    print_utilization(std::chrono::duration<real>(clock::now() - start).count());
+    return results;
+}
+
+auto batch_runner::estimate_cost(const simulation_properties& properties) -> real {
+    const auto& orbit       = properties.orbit;
+    const real  perigee_m   = (orbit.semi_major_axis_m * (1.0 - orbit.eccentricity)) - earth_radius_m;
+    real        duration_s  = properties.t_end - properties.t_start;
+    const real  mean_motion = std::sqrt(earth_mu_m3_s2 / std::pow(orbit.semi_major_axis_m, 3));
+
+    if (perigee_m <= reentry_altitude_m) {
+        return 0.0;
+    }
+
+    // drag shortens low orbits: e-folding of the lifetime per atmospheric scale height
+    if (properties.models.drag) {
+        const real lifetime_s = reference_lifetime_s * std::exp((perigee_m - reference_lifetime_altitude_m) / lifetime_scale_height_m);
+        duration_s            = std::min(duration_s, lifetime_s);
+    }
+
+    // adaptive steps shrink with the spin rate, the orbital rate bounds them for a settled spacecraft
+    return duration_s * (mean_motion + properties.angular_velocity.norm());
+}
+
+void batch_runner::print_utilization(real wall_s) const {
+    const auto& statistics = _pool.statistics();
+
+    real busy_s = 0.0;
+    for (std::size_t worker = 0; worker < statistics.size(); ++worker) {
+        const auto& entry = statistics[worker];
+        busy_s += entry.busy_s;
+        std::println("Worker {:>3}: {:>5} runs, {:>4} stolen, busy {:>8.2f} s ({:5.1f} %)",  //
+                     worker, entry.tasks, entry.stolen, entry.busy_s, 100.0 * entry.busy_s / wall_s);
+    }
+    std::println("Utilization: {:.1f} % of {} workers over {:.2f} s",  //
+                 100.0 * busy_s / (wall_s * static_cast<real>(statistics.size())), statistics.size(), wall_s);
+}
+
+auto batch_runner::run_job(const batch_job& job, const std::shared_ptr<environment>& environment, table_cache& tables) -> batch_result {
+    using clock = std::chrono::steady_clock;
+
+    const auto   start = clock::now();
+    batch_result result;
+
+    try {
+        const auto& properties = job.properties;
+        auto        satellite  = spacecraft::create(properties.satellite, tables);
+        auto        dynamics   = dynamics::create(satellite, environment, properties.models);
+        auto        statistics = properties.observer.format == observer_format_statistics
+                                     ? statistics_observer::create("", satellite, environment, properties.satellite, properties.observer, dynamics)
+                                     : nullptr;
+        auto        sim        = std::make_unique<simulation>(properties, satellite, environment, dynamics, statistics ? statistics : observer::create_null());
+        sim->set_verbose(false);
+        sim->run();
+
+        if (statistics) {
+            result.statistics = statistics->statistics();
+        }
+
+        const auto& state = sim->current_state();
+        result.state      = state;
+        result.t_end      = sim->current_time();
+
+        if (state.has_nan()) {
+            result.status = batch_status_unstable;
+        } else if (state.altitude_m() <= reentry_altitude_m) {
+            result.status = batch_status_deorbited;
+        } else if (sim->converged()) {
+            result.status = batch_status_converged;
+        } else {
+            result.status = batch_status_completed;
+        }
+
+        result.pointing_deg = std::numeric_limits<real>::quiet_NaN();
+        if (result.status != batch_status_unstable) {
+            const auto effects  = environment->compute_effects(result.t_end, state.position_m, state.velocity_m_s);
+            result.pointing_deg = stop_criteria::pointing_error_deg(state.attitude, satellite->magnet().magnetic_moment(), effects.magnetic_field_eci_T);
+        }
+    } catch (const std::exception& ex) {
+        std::println(stderr, "Error: {}", ex.what());
+        result.status = batch_status_failed;
+    }
+
+    result.wall_s = std::chrono::duration<real>(clock::now() - start).count();
+    return result;
+}
+
+auto batch_runner::run_ensemble(std::span<const batch_job> jobs, const std::shared_ptr<environment>& environment, table_cache& tables)
+    -> std::vector<batch_result> {
+    try {
+        ensemble::check_compatible(jobs);
+    } catch (const std::exception& ex) {
+        std::println(stderr, "Ensemble: {}, running members one by one", ex.what());
+
+        std::vector<batch_result> results;
+        results.reserve(jobs.size());
+        for (const auto& job : jobs) {
+            results.push_back(run_job(job, environment, tables));
+        }
+        return results;
+    }
+
+    try {
+        ensemble members(jobs, environment, tables);
+        return members.run();
+    } catch (const std::exception& ex) {
+        std::println(stderr, "Error: {}", ex.what());
+        return std::vector<batch_result>(jobs.size());
+    }
+}
+
+void batch_runner::write_table(const std::string& filename, const batch_design& design, const std::vector<batch_result>& results) {
+    std::filesystem::path file_path(filename);
+    if (file_path.has_parent_path()) {
+        std::filesystem::create_directories(file_path.parent_path());
+    }
+
+    std::ofstream file(filename);
+    if (not file.is_open()) {
+        throw std::runtime_error("Batch runner could not open results file: " + filename);
+    }
+
+    std::print(file, "index");
+    for (const auto& name : design.parameter_names) {
+        std::print(file, ",{}", name);
+    }
+    std::print(file, ",status,t_end,altitude_km,w,w_x,w_y,w_z,pointing_deg,wall_s");
+
+    const bool with_statistics = std::ranges::any_of(results, [](const batch_result& result) { return result.statistics.has_value(); });
+    if (with_statistics) {
+        for (const auto& [name, value] : run_statistics{}.fields()) {
+            std::print(file, ",{}", name);
+        }
+    }
+    std::println(file, "");
+
+    auto print_statistics = [&](const batch_result& result) {
+        if (with_statistics) {
+            for (const auto& [name, value] : result.statistics.value_or(run_statistics{}).fields()) {
+                if (result.statistics) {
+                    std::print(file, ",{}", value);
+                } else {
+                    std::print(file, ",");
+                }
+            }
+        }
+        std::println(file, "");
+    };
+
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const auto& result = results[i];
+        const auto& omega  = result.state.angular_velocity_m_s;
+
+        std::print(file, "{}", i);
+        for (const real value : design.jobs[i].parameters) {
+            std::print(file, ",{}", value);
+        }
+
+        if (result.status == batch_status_failed) {
+            std::print(file, ",{},,,,,,,,{}", status_names[result.status], result.wall_s);
+            print_statistics(result);
+            continue;
+        }
+
+        std::print(file, ",{},{},{},{},{},{},{},{},{}",  //
+                   status_names[result.status], result.t_end, result.state.altitude_m() * meter_to_kilometer,
+                   omega.norm(), omega.x(), omega.y(), omega.z(), result.pointing_deg, result.wall_s);
+        print_statistics(result);
+    }
+}
+
+}  // namespace aos
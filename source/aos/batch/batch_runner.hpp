@@ -0,0 +1,98 @@
+#pragma once
+
+#include "aos/batch/thread_pool.hpp"
+#include "aos/components/table_cache.hpp"
+#include "aos/core/constants.hpp"
+#include "aos/core/state.hpp"
+#include "aos/core/types.hpp"
+#include "aos/environment/environment.hpp"
+#include "aos/simulation/config.hpp"
+#include "aos/simulation/statistics_observer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace aos {
+
+struct batch_job {
+    simulation_properties properties;
+    std::vector<real>     parameters;  // values of the varied parameters, in batch_design::parameter_names order
+};
+
+// variants of one base configuration, all sharing its environment
+struct batch_design {
+    std::vector<std::string> parameter_names;
+    std::vector<batch_job>   jobs;
+};
+
+enum batch_status : uint8_t {
+    batch_status_completed,  // reached t_end
+    batch_status_converged,  // met the [stop] criteria before t_end
+    batch_status_deorbited,  // altitude fell below the reentry altitude
+    batch_status_unstable,   // NaN in the state
+    batch_status_failed,     // the run threw
+};
+
+struct batch_result {
+    system_state                  state;           // final state
+    real                          t_end{};         // [s] time reached
+    real                          pointing_deg{};  // [deg] angle between the magnet moment and the local field at t_end
+    real                          wall_s{};        // [s] run time
+    batch_status                  status{batch_status_failed};
+    std::optional<run_statistics> statistics;  // with [observer] format = "statistics"
+};
+
+/**
+ * @brief Runs many simulations in one process.
+ *
+ * The environment (gravity and magnetic models, space weather) is loaded once; every worker evaluates it through its own
+ * clone. Runs write no trajectory, only the final state of each run is kept for the results table, plus the streaming
+ * statistics of statistics_observer when the configuration asks for format = "statistics". Jobs are submitted
+ * longest first by estimate_cost() and balanced by the work-stealing pool. Hysteresis, Everett and face tables are
+ * built once per distinct material or geometry and shared by all runs, see table_cache.
+ */
+class batch_runner {
+public:
+
+    static constexpr real reference_lifetime_s          = seconds_per_year;  // [s] ~1 year for a CubeSat at 400 km
+    static constexpr real reference_lifetime_altitude_m = 400e3;             // [m]
+    static constexpr real lifetime_scale_height_m       = 60e3;              // [m] lifetime grows by e per scale height
+
+    batch_runner(const environment_properties& environment, std::size_t num_threads);
+
+    [[nodiscard]] auto num_threads() const -> std::size_t;
+
+    // results in job order, prints the per-worker utilization at the end; with ensemble_lanes > 1, runs of consecutive
+    // jobs are integrated in lockstep, see ensemble
+    [[nodiscard]] auto run(const batch_design& design, std::size_t ensemble_lanes = 0) -> std::vector<batch_result>;
+
+    // one row per job: index, parameters, status, final state summary and, if any run has them, the run statistics
+    static void write_table(const std::string& filename, const batch_design& design, const std::vector<batch_result>& results);
+
+protected:
+
+    // relative run time of a job for the longest-first schedule: simulated time, capped by a rough drag lifetime, times
+    // a step rate that grows with the initial spin. Only the ordering matters; early terminations are absorbed by stealing
+    [[nodiscard]] static auto estimate_cost(const simulation_properties& properties) -> real;
+
+    void print_utilization(real wall_s) const;
+
+    [[nodiscard]] static auto run_job(const batch_job& job, const std::shared_ptr<environment>& environment, table_cache& tables) -> batch_result;
+
+    // all jobs as one ensemble, falls back to run_job for jobs that cannot be packed
+    [[nodiscard]] static auto run_ensemble(std::span<const batch_job> jobs, const std::shared_ptr<environment>& environment, table_cache& tables)
+        -> std::vector<batch_result>;
+
+private:
+
+    std::vector<std::shared_ptr<environment>> _environments;  // one per worker
+    table_cache                               _tables;        // shared by all workers, outlives the runs of the pool
+    thread_pool                               _pool;
+};
+
+}  // namespace aos
@@ -0,0 +1,585 @@
+#include "ensemble.hpp"
+
+#include "aos/batch/batch_runner.hpp"
+#include "aos/components/hysteresis_rod.hpp"
+#include "aos/components/spacecraft.hpp"
+#include "aos/components/spacecraft_face.hpp"
+#include "aos/components/spacecraft_shape.hpp"
+#include "aos/core/constants.hpp"
+#include "aos/core/ensemble_state.hpp"
+#include "aos/core/force_models.hpp"
+#include "aos/core/langevin.hpp"
+#include "aos/core/state.hpp"
+#include "aos/core/types.hpp"
+#include "aos/environment/details/environment_impl.hpp"
+#include "aos/environment/environment.hpp"
+#include "aos/environment/orbital_mechanics.hpp"
+#include "aos/simulation/config.hpp"
+#include "aos/simulation/observer.hpp"
+#include "aos/simulation/stop_criteria.hpp"
+
+#include <boost/numeric/odeint.hpp>
+#include <boost/numeric/odeint/algebra/vector_space_algebra.hpp>
+#include <boost/numeric/odeint/integrate/integrate_adaptive.hpp>
+#include <boost/numeric/odeint/stepper/generation/make_controlled.hpp>
+#include <boost/numeric/odeint/stepper/runge_kutta_cash_karp54.hpp>
+#include <boost/numeric/odeint/stepper/runge_kutta_dopri5.hpp>
+#include <boost/numeric/odeint/stepper/runge_kutta_fehlberg78.hpp>
+
+#include <Eigen/Core>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace aos {
+
+namespace {
+
+// fixed capacity, the temporaries of the right-hand side live on the stack
+using lane_row = Eigen::Array<real, 1, Eigen::Dynamic, Eigen::RowMajor, 1, ensemble_state::max_lanes>;
+
+// one vector per lane, each component a row across the lanes
+struct lane_vec3 {
+    lane_row x;
+    lane_row y;
+    lane_row z;
+};
+
+auto broadcast(const vec3& v, Eigen::Index lanes) -> lane_vec3 {
+    return {lane_row::Constant(lanes, v.x()), lane_row::Constant(lanes, v.y()), lane_row::Constant(lanes, v.z())};
+}
+
+template <typename derived>
+auto rows_of(const Eigen::ArrayBase<derived>& array, Eigen::Index first) -> lane_vec3 {
+    return {array.row(first), array.row(first + 1), array.row(first + 2)};
+}
+
+auto cross(const lane_vec3& a, const lane_vec3& b) -> lane_vec3 {
+    return {(a.y * b.z) - (a.z * b.y), (a.z * b.x) - (a.x * b.z), (a.x * b.y) - (a.y * b.x)};
+}
+
+auto dot(const lane_vec3& a, const lane_vec3& b) -> lane_row {
+    return (a.x * b.x) + (a.y * b.y) + (a.z * b.z);
+}
+
+void add_to(lane_vec3& sum, const lane_vec3& term) {
+    sum.x += term.x;
+    sum.y += term.y;
+    sum.z += term.z;
+}
+
+// per-lane 3x3 matrix (9 rows, row-major) times per-lane vector
+auto multiply(const lane_array& matrix, const lane_vec3& v) -> lane_vec3 {
+    auto row = [&](Eigen::Index i) -> lane_row { return (matrix.row(3 * i) * v.x) + (matrix.row((3 * i) + 1) * v.y) + (matrix.row((3 * i) + 2) * v.z); };
+    return {row(0), row(1), row(2)};
+}
+
+// rotate by the conjugate of the unit quaternions (u, w): v' = v + w * t + u x t with t = 2 * (u x v) and u = -(x, y, z)
+auto rotate_inverse(const lane_vec3& u_conj, const lane_row& w, const lane_vec3& v) -> lane_vec3 {
+    lane_vec3 t = cross(u_conj, v);
+    t.x *= 2.0;
+    t.y *= 2.0;
+    t.z *= 2.0;
+    lane_vec3 result = cross(u_conj, t);
+    result.x += v.x + (w * t.x);
+    result.y += v.y + (w * t.y);
+    result.z += v.z + (w * t.z);
+    return result;
+}
+
+// whether both shapes produce the same faces (and face table), so that drag and SRP accelerate them alike
+auto same_faces(const spacecraft_shape& a, const spacecraft_shape& b) -> bool {
+    if (a.index() != b.index()) {
+        return false;
+    }
+
+    if (const auto* uniform = std::get_if<spacecraft_uniform>(&a)) {
+        const auto& other = std::get<spacecraft_uniform>(b);
+        return uniform->dimensions_m == other.dimensions_m && uniform->drag_coefficient == other.drag_coefficient &&
+               uniform->specular_reflection_coefficient == other.specular_reflection_coefficient &&
+               uniform->diffuse_reflection_coefficient == other.diffuse_reflection_coefficient;
+    }
+
+    const auto& custom = std::get<spacecraft_custom>(a);
+    const auto& other  = std::get<spacecraft_custom>(b);
+    return custom.face_table == other.face_table && custom.faces == other.faces;
+}
+
+}  // namespace
+
+ensemble::ensemble(std::span<const batch_job> jobs, std::shared_ptr<environment> environment, table_cache& tables)
+    : _environment(std::move(environment)),
+      _environment_impl(dynamic_cast<const environment_impl*>(_environment.get())),
+      _models(jobs.front().properties.models),
+      _t_start(jobs.front().properties.t_start),
+      _t_end(jobs.front().properties.t_end),
+      _t_now(_t_start),
+      _dt_initial(jobs.front().properties.dt_initial),
+      _checkpoint_interval(jobs.front().properties.checkpoint_interval),
+      _absolute_error(jobs.front().properties.absolute_error),
+      _relative_error(jobs.front().properties.relative_error),
+      _stepper_function(jobs.front().properties.stepper_function) {
+    check_compatible(jobs);
+
+    const auto lanes = static_cast<Eigen::Index>(jobs.size());
+    const auto rods  = static_cast<Eigen::Index>(jobs.front().properties.satellite.rods.size());
+
+    _inertia.resize(9, lanes);          // NOLINT(readability-magic-numbers)
+    _inertia_inverse.resize(9, lanes);  // NOLINT(readability-magic-numbers)
+    _magnet_moment.resize(3, lanes);
+    _rod_orientation.resize(3 * rods, lanes);
+    _rod_volume.resize(rods, lanes);
+    _rod_ms.resize(rods, lanes);
+    _rod_a.resize(rods, lanes);
+    _rod_k.resize(rods, lanes);
+    _rod_c.resize(rods, lanes);
+    _rod_alpha.resize(rods, lanes);
+
+    const auto [position, velocity] = orbital_converter::to_cartesian(jobs.front().properties.orbit);
+    _state                          = ensemble_state(lanes, rods);
+    _state.position_m()             = position;
+    _state.velocity_m_s()           = velocity;
+
+    _satellites.reserve(jobs.size());
+    for (Eigen::Index lane = 0; lane < lanes; ++lane) {
+        const auto& properties = jobs[lane].properties;
+        const auto& satellite  = _satellites.emplace_back(spacecraft::create(properties.satellite, tables));
+
+        for (Eigen::Index i = 0; i < 3; ++i) {
+            for (Eigen::Index j = 0; j < 3; ++j) {
+                _inertia((3 * i) + j, lane)         = satellite->inertia().value()(i, j);
+                _inertia_inverse((3 * i) + j, lane) = satellite->inertia().inverse()(i, j);
+            }
+        }
+        _magnet_moment.col(lane) = satellite->magnet().magnetic_moment().array();
+
+        const auto rod_models = satellite->hystresis().rods();
+        for (Eigen::Index rod = 0; rod < rods; ++rod) {
+            const auto& hysteresis = rod_models[rod].hysteresis();
+
+            _rod_orientation.block(3 * rod, lane, 3, 1) = properties.satellite.rods[rod].orientation.normalized().array();
+            _rod_volume(rod, lane)                      = properties.satellite.rods[rod].volume_m3;
+            _rod_ms(rod, lane)                          = hysteresis.ms;
+            _rod_a(rod, lane)                           = hysteresis.a;
+            _rod_k(rod, lane)                           = hysteresis.k;
+            _rod_c(rod, lane)                           = hysteresis.c;
+            _rod_alpha(rod, lane)                       = hysteresis.alpha;
+        }
+
+        _state.attitude().col(lane)             = quat::Identity().coeffs().array();
+        _state.angular_velocity_m_s().col(lane) = properties.angular_velocity.array();
+    }
+
+    for (const auto& rod : _satellites.front()->hystresis().rods()) {
+        _rod_langevin.push_back(rod.hysteresis().langevin);
+    }
+
+    const bool any_stop = std::ranges::any_of(jobs, [](const batch_job& job) { return job.properties.stop.enabled(); });
+    if (any_stop) {
+        _stop.reserve(jobs.size());
+        for (const auto& job : jobs) {
+            _stop.emplace_back(job.properties.stop, job.properties.satellite);
+        }
+    }
+
+    _active = lane_mask::Constant(lanes, true);
+    _lane_t_end.assign(jobs.size(), _t_start);
+    _lane_pointing_deg.assign(jobs.size(), std::numeric_limits<real>::quiet_NaN());
+    _lane_status.assign(jobs.size(), batch_status_completed);
+}
+
+ensemble::~ensemble() = default;
+
+auto ensemble::num_lanes() const -> Eigen::Index {
+    return _state.num_lanes();
+}
+
+void ensemble::check_compatible(std::span<const batch_job> jobs) {
+    if (jobs.empty() || std::ssize(jobs) > ensemble_state::max_lanes) {
+        throw std::runtime_error("Ensemble needs 1 to " + std::to_string(ensemble_state::max_lanes) + " members");
+    }
+
+    const auto& first       = jobs.front().properties;
+    const auto  first_orbit = orbital_converter::to_cartesian(first.orbit);
+
+    for (const auto& job : jobs) {
+        const auto& other = job.properties;
+        auto        check = [](bool shared, const char* setting) {
+            if (not shared) {
+                throw std::runtime_error(std::string("Ensemble members differ in ") + setting);
+            }
+        };
+
+        const auto orbit = orbital_converter::to_cartesian(other.orbit);
+        check(orbit.first == first_orbit.first && orbit.second == first_orbit.second, "orbit");
+        check(other.t_start == first.t_start && other.t_end == first.t_end, "time span");
+        check(other.dt_initial == first.dt_initial && other.checkpoint_interval == first.checkpoint_interval, "time step");
+        check(other.absolute_error == first.absolute_error && other.relative_error == first.relative_error, "tolerances");
+        check(other.stepper_function == first.stepper_function, "stepper");
+        check(other.models.index() == first.models.index(), "force models");
+        check(other.satellite.rods.size() == first.satellite.rods.size(), "rod count");
+
+        // the lanes share one orbit, drag and SRP only move it like a single run if every lane feels the same acceleration
+        if (first.models.needs_faces()) {
+            check(other.satellite.mass_kg == first.satellite.mass_kg, "mass (drag/SRP act on the shared orbit)");
+            check(same_faces(other.satellite.shape, first.satellite.shape), "faces (drag/SRP act on the shared orbit)");
+        }
+
+        for (std::size_t rod = 0; rod < other.satellite.rods.size(); ++rod) {
+            const auto& rod_properties = other.satellite.rods[rod];
+            check(not rod_properties.preisach, "rod model (Preisach rods cannot be packed)");
+
+            const auto& hysteresis       = rod_properties.hysteresis ? *rod_properties.hysteresis : other.satellite.hysteresis;
+            const auto& first_properties = first.satellite.rods[rod];
+            const auto& first_hysteresis = first_properties.hysteresis ? *first_properties.hysteresis : first.satellite.hysteresis;
+            check(hysteresis.langevin == first_hysteresis.langevin, "langevin evaluator");
+        }
+    }
+
+    if (first.stepper_function < 0 || first.stepper_function > 2) {
+        throw std::runtime_error("Unknown stepper function: " + std::to_string(first.stepper_function));
+    }
+
+    if (std::ranges::any_of(jobs, [](const batch_job& job) { return job.properties.observer.format == observer_format_statistics; })) {
+        throw std::runtime_error("Ensemble members do not collect run statistics");
+    }
+}
+
+auto ensemble::run() -> std::vector<batch_result> {
+    using boost::numeric::odeint::make_controlled;
+    using boost::numeric::odeint::runge_kutta_cash_karp54;
+    using boost::numeric::odeint::runge_kutta_dopri5;
+    using boost::numeric::odeint::runge_kutta_fehlberg78;
+    using boost::numeric::odeint::range_algebra;
+    using stepper_type_f78 = runge_kutta_fehlberg78<ensemble_state, real, ensemble_state, real, range_algebra>;
+    using stepper_type_dp5 = runge_kutta_dopri5<ensemble_state, real, ensemble_state, real, range_algebra>;
+    using stepper_type_k54 = runge_kutta_cash_karp54<ensemble_state, real, ensemble_state, real, range_algebra>;
+    using clock            = std::chrono::steady_clock;
+
+    const auto start = clock::now();
+
+    switch (_stepper_function) {
+        case 2: {
+            auto stepper = make_controlled<stepper_type_f78>(_absolute_error, _relative_error);
+            integrate(stepper);
+        } break;
+        case 1: {
+            auto stepper = make_controlled<stepper_type_dp5>(_absolute_error, _relative_error);
+            integrate(stepper);
+        } break;
+        default: {
+            auto stepper = make_controlled<stepper_type_k54>(_absolute_error, _relative_error);
+            integrate(stepper);
+        } break;
+    }
+
+    const auto lanes     = num_lanes();
+    const bool deorbited = _state.altitude_m() <= reentry_altitude_m;
+    const auto effects   = _environment->compute_effects(_t_now, _state.position_m(), _state.velocity_m_s());
+    const auto wall_s    = std::chrono::duration<real>(clock::now() - start).count() / static_cast<real>(lanes);
+
+    std::vector<batch_result> results(static_cast<std::size_t>(lanes));
+    for (Eigen::Index lane = 0; lane < lanes; ++lane) {
+        auto& result  = results[lane];
+        result.state  = _state.lane(lane);
+        result.wall_s = wall_s;
+
+        if (not _active(lane)) {
+            result.status       = _lane_status[lane];
+            result.t_end        = _lane_t_end[lane];
+            result.pointing_deg = _lane_pointing_deg[lane];
+            continue;
+        }
+
+        result.status = deorbited ? batch_status_deorbited : batch_status_completed;
+        result.t_end  = _t_now;
+
+        const vec3 moment_body = _satellites[lane]->magnet().magnetic_moment();
+        result.pointing_deg    = stop_criteria::pointing_error_deg(result.state.attitude, moment_body, effects.magnetic_field_eci_T);
+    }
+    return results;
+}
+
+template <typename stepper_type>
+void ensemble::integrate(stepper_type& stepper) {
+    using boost::numeric::odeint::integrate_adaptive;
+
+    auto system  = [this](const ensemble_state& current_state, ensemble_state& state_derivative, real t_sec) { step(current_state, state_derivative, t_sec); };
+    auto observe = [this](ensemble_state& observed_state, real t_sec) { accept(observed_state, t_sec); };
+
+    // without checkpoints the whole span is one section, as in simulation::run
+    if (_checkpoint_interval < 1.0) {
+        _time_offset = 0.0;
+        _checkpoint  = _state;
+        try {
+            integrate_adaptive(stepper, system, _state, _t_start, _t_end, _dt_initial, observe);
+        } catch (const std::runtime_error&) {
+            if (not _stopped) {
+                throw;
+            }
+        }
+        return;
+    }
+
+    while (_t_now < _t_end && _active.any()) {
+        const auto section_period = std::min(_checkpoint_interval, _t_end - _t_now);
+
+        _time_offset = _t_now;
+        _checkpoint  = _state;
+        integrate_adaptive(stepper, system, _state, 0.0, section_period, _dt_initial, observe);
+
+        fix_integration_errors();
+        _t_now = _time_offset + section_period;
+        check_convergence(_state, _t_now);
+
+        if (_state.altitude_m() <= reentry_altitude_m) {
+            break;
+        }
+    }
+}
+
+void ensemble::step(const ensemble_state& current_state, ensemble_state& state_derivative, real t_sec) const {
+    const auto  lanes = current_state.num_lanes();
+    const auto  rods  = current_state.num_rods();
+    const auto  env   = compute_environment(_time_offset + t_sec, current_state);
+    const auto  q     = current_state.attitude();
+
+    // normalize to prevent drift
+    const lane_row  q_norm = q.colwise().norm();
+    const lane_vec3 u      = {q.row(0) / q_norm, q.row(1) / q_norm, q.row(2) / q_norm};
+    const lane_row  w      = q.row(3) / q_norm;
+    const lane_vec3 u_conj = {-u.x, -u.y, -u.z};
+    const lane_vec3 omega  = rows_of(current_state.angular_velocity_m_s(), 0);
+
+    // gyroscopic torque: -w x (I * w)
+    const lane_vec3 i_omega = multiply(_inertia, omega);
+    lane_vec3       torque  = cross(i_omega, omega);
+
+    lane_vec3 b_body = broadcast(vec3::Zero(), lanes);
+    if (_models.needs_magnetic_field()) {
+        b_body = rotate_inverse(u_conj, w, broadcast(env.magnetic_field_eci_T, lanes));
+    }
+
+    if (_models.magnet) {
+        add_to(torque, cross(rows_of(_magnet_moment, 0), b_body));
+    }
+
+    if (_models.gravity_gradient) {
+        // tau_gg = (3 * mu / r^5) * (r_body x (I * r_body)), |r| is shared by the lanes
+        const real      r_sq   = current_state.position_m().squaredNorm();
+        const real      coef   = (3.0 * env.earth_mu) / (r_sq * r_sq * std::sqrt(r_sq));
+        const lane_vec3 r_body = rotate_inverse(u_conj, w, broadcast(current_state.position_m(), lanes));
+        lane_vec3       term   = cross(r_body, multiply(_inertia, r_body));
+        term.x *= coef;
+        term.y *= coef;
+        term.z *= coef;
+        add_to(torque, term);
+    }
+
+    auto rod_derivative = state_derivative.rod_magnetizations();
+    rod_derivative.setZero();
+    if (_models.rods && rods > 0) {
+        lane_vec3       b_dot_body = rotate_inverse(u_conj, w, broadcast(env.magnetic_field_dot_eci_T_s, lanes));
+        const lane_vec3 rotational = cross(omega, b_body);
+        b_dot_body.x -= rotational.x;
+        b_dot_body.y -= rotational.y;
+        b_dot_body.z -= rotational.z;
+
+        // Jiles-Atherton, see hysteresis_rod::compute_effects; branches become selects over the lanes
+        for (Eigen::Index rod = 0; rod < rods; ++rod) {
+            const lane_vec3 orientation = rows_of(_rod_orientation, 3 * rod);
+            const auto      ms          = _rod_ms.row(rod);
+            const auto      k           = _rod_k.row(rod);
+            const auto      c           = _rod_c.row(rod);
+            const auto      alpha       = _rod_alpha.row(rod);
+            const auto      evaluator   = _rod_langevin[rod];
+            const auto      m_irr       = current_state.rod_magnetizations().row(rod);
+
+            const lane_row h_applied     = dot(b_body, orientation) / vacuum_permeability;
+            const lane_row dh_dt         = dot(b_dot_body, orientation) / vacuum_permeability;
+            const lane_row m_irr_clamped = m_irr.max(-ms).min(ms);
+            const lane_row h_eff         = h_applied + (alpha * m_irr_clamped);
+            const lane_row x             = h_eff / _rod_a.row(rod);
+            const lane_row m_an          = ms * x.unaryExpr([evaluator](real value) { return langevin(value, evaluator); });
+            const lane_row m_total       = ((1.0 - c) * m_irr_clamped) + (c * m_an);
+            const lane_row moment        = m_total * _rod_volume.row(rod);
+
+            add_to(torque, cross({moment * orientation.x, moment * orientation.y, moment * orientation.z}, b_body));
+
+            const lane_row delta       = (dh_dt > 0.0).select(lane_row::Ones(lanes), -lane_row::Ones(lanes));
+            const lane_row numerator   = m_an - m_irr_clamped;
+            const lane_row denominator = (k * delta) - (alpha * numerator);
+            const lane_row max_chi     = ms / k.max(hysteresis_rod::min_k_value);
+            const lane_row capped      = (numerator < 0.0).select(-max_chi, max_chi);
+            const lane_row singular    = (numerator.abs() < hysteresis_rod::epsilon_denominator).select(lane_row::Zero(lanes), capped);
+            const lane_row regular     = (numerator / denominator).max(-max_chi).min(max_chi);
+            const lane_row dmirr_dh    = (denominator.abs() < hysteresis_rod::epsilon_denominator).select(singular, regular);
+            const lane_row dm_irr_dt   = dmirr_dh * dh_dt;
+
+            const auto locked  = ((m_irr >= ms) && (dh_dt > 0.0)) || ((m_irr <= -ms) && (dh_dt < 0.0)) || (dh_dt.abs() < hysteresis_rod::epsilon_dh_dt);
+            const auto acausal = ((dh_dt > 0.0) && (dm_irr_dt < -hysteresis_rod::tolerance_causality))
+                                 || ((dh_dt < 0.0) && (dm_irr_dt > hysteresis_rod::tolerance_causality));
+
+            rod_derivative.row(rod) = (locked || acausal).select(lane_row::Zero(lanes), dm_irr_dt);
+        }
+    }
+
+    state_derivative.position_m()   = current_state.velocity_m_s();
+    state_derivative.velocity_m_s() = env.gravity_eci_m_s2;
+
+    if (_models.needs_faces()) {
+        // per-lane face sums, the orbit takes the mean acceleration of the active lanes
+        vec3 acceleration = vec3::Zero();
+        int  contributing = 0;
+        for (Eigen::Index lane = 0; lane < lanes; ++lane) {
+            if (not _active(lane)) {
+                continue;
+            }
+
+            const quat  q_att(w(lane), u.x(lane), u.y(lane), u.z(lane));
+            const quat  q_inv = q_att.conjugate();
+            const vec3  omega_body(omega.x(lane), omega.y(lane), omega.z(lane));
+            const auto& faces = _satellites[lane]->faces();
+
+            face_effects effects{};
+            if (_models.drag && _models.srp) {
+                effects = faces.compute_face_effects<true, true>(env, q_att, q_inv, omega_body);
+            } else if (_models.drag) {
+                effects = faces.compute_face_effects<true, false>(env, q_att, q_inv, omega_body);
+            } else {
+                effects = faces.compute_face_effects<false, true>(env, q_att, q_inv, omega_body);
+            }
+
+            torque.x(lane) += effects.torque_body.x();
+            torque.y(lane) += effects.torque_body.y();
+            torque.z(lane) += effects.torque_body.z();
+
+            if (effects.force_eci.allFinite()) {
+                acceleration += effects.force_eci / _satellites[lane]->mass_kg();
+                ++contributing;
+            }
+        }
+
+        if (contributing > 0) {
+            state_derivative.velocity_m_s() += acceleration / static_cast<real>(contributing);
+        }
+    }
+
+    // dq/dt = 0.5 * q * (0, w)
+    const std::array<lane_row, 4> attitude_derivative = {
+        0.5 * ((w * omega.x) + (u.y * omega.z) - (u.z * omega.y)),
+        0.5 * ((w * omega.y) + (u.z * omega.x) - (u.x * omega.z)),
+        0.5 * ((w * omega.z) + (u.x * omega.y) - (u.y * omega.x)),
+        -0.5 * dot(u, omega),
+    };
+    const lane_vec3 omega_derivative = multiply(_inertia_inverse, torque);
+
+    // retired lanes stay where they were restored to
+    const lane_row active         = _active.select(lane_row::Ones(lanes), lane_row::Zero(lanes));
+    auto           attitude_rates = state_derivative.attitude();
+    auto           omega_rates    = state_derivative.angular_velocity_m_s();
+    for (Eigen::Index i = 0; i < 4; ++i) {
+        attitude_rates.row(i) = active * attitude_derivative[i];
+    }
+    omega_rates.row(0) = active * omega_derivative.x;
+    omega_rates.row(1) = active * omega_derivative.y;
+    omega_rates.row(2) = active * omega_derivative.z;
+    rod_derivative.rowwise() *= active;
+}
+
+auto ensemble::compute_environment(real t_sec, const ensemble_state& state) const -> environment_effects {
+    if (_environment_impl != nullptr) {
+        return _environment_impl->compute_effects_for(_models, t_sec, state.position_m(), state.velocity_m_s());
+    }
+    return _environment->compute_effects(t_sec, state.position_m(), state.velocity_m_s());
+}
+
+void ensemble::accept(ensemble_state& state, real t_sec) {
+    _t_now = _time_offset + t_sec;
+
+    for (Eigen::Index lane = 0; lane < state.num_lanes(); ++lane) {
+        if (state.lane_has_nan(lane)) {
+            if (_active(lane)) {
+                retire(lane, _t_now, batch_status_unstable);
+            }
+            state.set_lane(lane, _checkpoint.lane(lane));
+        }
+    }
+
+    if (_checkpoint_interval >= 1.0) {
+        return;
+    }
+
+    check_convergence(state, _t_now);
+
+    if (state.altitude_m() <= reentry_altitude_m) {
+        _stopped = true;
+        throw std::runtime_error("Deorbited");
+    }
+
+    if (not _active.any()) {
+        _stopped = true;
+        throw std::runtime_error("All members retired");
+    }
+}
+
+void ensemble::check_convergence(const ensemble_state& state, real t_sec) {
+    if (_stop.empty()) {
+        return;
+    }
+
+    // the lanes share the orbit, one field evaluation serves all of them
+    std::optional<vec3> field_eci;
+    auto                field = [&]() -> const vec3& {
+        if (not field_eci) {
+            field_eci = _environment->compute_effects(t_sec, state.position_m(), state.velocity_m_s()).magnetic_field_eci_T;
+        }
+        return *field_eci;
+    };
+
+    const vec3 no_field = vec3::Zero();
+    for (Eigen::Index lane = 0; lane < state.num_lanes(); ++lane) {
+        if (not _active(lane)) {
+            continue;
+        }
+
+        auto&      criteria   = _stop[lane];
+        const auto lane_state = state.lane(lane);
+        if (criteria.update(lane_state, criteria.needs_magnetic_field() ? field() : no_field, t_sec)) {
+            retire(lane, t_sec, batch_status_converged);
+            _lane_pointing_deg[lane] = stop_criteria::pointing_error_deg(lane_state.attitude, _satellites[lane]->magnet().magnetic_moment(), field());
+        }
+    }
+}
+
+void ensemble::retire(Eigen::Index lane, real t_sec, batch_status status) {
+    _active(lane)      = false;
+    _lane_t_end[lane]  = t_sec;
+    _lane_status[lane] = status;
+}
+
+void ensemble::fix_integration_errors() {
+    // fix drift
+    auto           attitude = _state.attitude();
+    const lane_row norms    = attitude.colwise().norm();
+    attitude.rowwise() /= norms;
+
+    // in case of integrator overshot
+    auto magnetizations = _state.rod_magnetizations();
+    magnetizations      = magnetizations.max(-_rod_ms).min(_rod_ms);
+}
+
+}  // namespace aos
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "aos/batch/batch_runner.hpp"
+#include "aos/components/spacecraft.hpp"
+#include "aos/core/ensemble_state.hpp"
+#include "aos/core/force_models.hpp"
+#include "aos/core/langevin.hpp"
+#include "aos/core/types.hpp"
+#include "aos/environment/details/environment_impl.hpp"
+#include "aos/environment/environment.hpp"
+#include "aos/simulation/stop_criteria.hpp"
+
+#include <Eigen/Core>
+
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace aos {
+
+/**
+ * @brief Lockstep integration of variants of one spacecraft flying the same orbit.
+ *
+ * The members (lanes) must share the orbit, the time span, the integrator settings, the force models and the rod
+ * layout, see check_compatible(); with drag or SRP they must also share mass and faces, every other spacecraft
+ * parameter may differ. All lanes are packed into one ensemble_state and advanced by a single controlled stepper with
+ * worst-lane error control. The environment is evaluated once per right-hand side for all lanes, the rigid-body,
+ * magnet, gravity gradient and Jiles-Atherton rod terms are evaluated row-wise across the lanes. Drag and SRP torques
+ * are evaluated lane by lane; the shared orbit takes the mean of their accelerations over the active lanes.
+ *
+ * A lane that turns NaN is retired: it is restored to its last checkpoint, masked out of the right-hand side and
+ * reported as unstable at the time it diverged. A lane that meets its own [stop] criteria is retired as converged,
+ * tested at the same points as a single run (every step, or every checkpoint). Deorbit ends all lanes, and so does
+ * the retirement of the last active lane. Rods always evaluate the Langevin function directly (hysteresis tables are
+ * not used).
+ */
+class ensemble {
+public:
+
+    ensemble(const ensemble&)                    = delete;
+    ensemble(ensemble&&)                         = delete;
+    auto operator=(const ensemble&) -> ensemble& = delete;
+    auto operator=(ensemble&&) -> ensemble&      = delete;
+
+    // the lanes take their component tables from tables, see table_cache
+    ensemble(std::span<const batch_job> jobs, std::shared_ptr<environment> environment, table_cache& tables);
+    ~ensemble();
+
+    [[nodiscard]] auto num_lanes() const -> Eigen::Index;
+
+    // integrate all lanes, results in lane order, wall_s is the ensemble run time split evenly over the lanes
+    [[nodiscard]] auto run() -> std::vector<batch_result>;
+
+    // right-hand side of all lanes, retired lanes have zero derivatives
+    void step(const ensemble_state& current_state, ensemble_state& state_derivative, real t_sec) const;
+
+    // throws std::runtime_error naming the first setting the jobs do not share
+    static void check_compatible(std::span<const batch_job> jobs);
+
+protected:
+
+    template <typename stepper_type>
+    void integrate(stepper_type& stepper);
+
+    [[nodiscard]] auto compute_environment(real t_sec, const ensemble_state& state) const -> environment_effects;
+
+    // called once per accepted step, retires lanes that diverged
+    void accept(ensemble_state& state, real t_sec);
+
+    // retires the active lanes whose stop criteria are met at the absolute time t_sec
+    void check_convergence(const ensemble_state& state, real t_sec);
+
+    void retire(Eigen::Index lane, real t_sec, batch_status status);
+
+    void fix_integration_errors();
+
+private:
+
+    using lane_mask = Eigen::Array<bool, 1, Eigen::Dynamic>;
+
+    std::vector<std::shared_ptr<spacecraft>> _satellites;          // one per lane, for the face models
+    std::shared_ptr<environment>             _environment;
+    const environment_impl*                  _environment_impl{};  // set if the environment is the built-in one
+    force_model_set                          _models;
+
+    // per-lane parameters, one column per lane
+    lane_array                      _inertia;          // [kg*m^2] 9 x lanes, row-major 3x3
+    lane_array                      _inertia_inverse;  // [1/(kg*m^2)] 9 x lanes, row-major 3x3
+    lane_array                      _magnet_moment;    // [A*m^2] 3 x lanes, body frame
+    lane_array                      _rod_orientation;  // [-] 3*rods x lanes, unit vectors
+    lane_array                      _rod_volume;       // [m^3] rods x lanes
+    lane_array                      _rod_ms;           // [A/m] rods x lanes
+    lane_array                      _rod_a;            // [A/m] rods x lanes
+    lane_array                      _rod_k;            // [A/m] rods x lanes
+    lane_array                      _rod_c;            // [-] rods x lanes
+    lane_array                      _rod_alpha;        // [-] rods x lanes
+    std::vector<langevin_evaluator> _rod_langevin;     // per rod, shared by the lanes
+    std::vector<stop_criteria>      _stop;             // per lane, empty if no member has stop criteria
+
+    ensemble_state            _state;
+    ensemble_state            _checkpoint;         // state at the start of the current section
+    lane_mask                 _active;
+    std::vector<real>         _lane_t_end;         // [s] time a lane was retired
+    std::vector<real>         _lane_pointing_deg;  // [deg] pointing of a converged lane when it was retired
+    std::vector<batch_status> _lane_status;
+
+    real _t_start;
+    real _t_end;
+    real _t_now;
+    real _time_offset{};
+    real _dt_initial;
+    real _checkpoint_interval;
+    real _absolute_error;
+    real _relative_error;
+    int  _stepper_function;
+    bool _stopped{};  // accept() ended a run without checkpoints
+};
+
+}  // namespace aos
@@ -0,0 +1,188 @@
+#include "monte_carlo.hpp"
+
+#include "aos/batch/batch_runner.hpp"
+#include "aos/components/permanent_magnet.hpp"
+#include "aos/core/types.hpp"
+#include "aos/simulation/config.hpp"
+
+#include <toml++/toml.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace aos {
+
+namespace {
+
+auto distribution_name(distribution_type type) -> std::string_view {
+    switch (type) {
+        case distribution_type_uniform:
+            return "uniform";
+        case distribution_type_normal:
+            return "normal";
+        default:
+            return "none";
+    }
+}
+
+void print_distribution(std::string_view name, const parameter_distribution& distribution) {
+    std::cout << "\n  " << name << distribution_name(distribution.type) << ' ' << distribution.spread;
+}
+
+}  // namespace
+
+auto parameter_distribution::draw(std::mt19937_64& generator) const -> real {
+    switch (type) {
+        case distribution_type_uniform:
+            return std::uniform_real_distribution<real>(-spread, spread)(generator);
+        case distribution_type_normal:
+            return std::normal_distribution<real>(0.0, spread)(generator);
+        default:
+            return 0.0;
+    }
+}
+
+auto parameter_distribution::enabled() const -> bool {
+    return type != distribution_type_none && spread > 0.0;
+}
+
+void parameter_distribution::from_toml(const toml_table& table) {
+    const auto name = table["distribution"].value_or<std::string>("uniform");
+    if (name == "uniform") {
+        type = distribution_type_uniform;
+    } else if (name == "normal") {
+        type = distribution_type_normal;
+    } else if (name == "none") {
+        type = distribution_type_none;
+    } else {
+        throw std::runtime_error("Unknown Monte Carlo distribution: " + name);
+    }
+
+    spread = table["spread"].value_or(0.0);
+    if (spread < 0.0) {
+        throw std::runtime_error("Monte Carlo 'spread' must not be negative");
+    }
+}
+
+void monte_carlo_properties::from_toml(const toml_table& table) {
+    samples = table["samples"].value_or<std::size_t>(40);  // NOLINT(readability-magic-numbers)
+    seed    = table["seed"].value_or<std::uint64_t>(1);
+
+    const auto read = [&](std::string_view key, parameter_distribution& distribution) {
+        if (const auto* entry = table[key].as_table()) {
+            distribution.from_toml(*entry);
+        }
+    };
+
+    read("mass", mass);
+    read("magnet_remanence", magnet_remanence);
+    read("magnet_dimensions", magnet_dimensions);
+    read("rod_volume", rod_volume);
+    read("angular_velocity", angular_velocity);
+}
+
+void monte_carlo_properties::debug_print() const {
+    std::cout << "--  monte carlo properties  --"     //
+              << "\n  samples:           " << samples  //
+              << "\n  seed:              " << seed;
+    print_distribution("mass:              ", mass);
+    print_distribution("magnet remanence:  ", magnet_remanence);
+    print_distribution("magnet dimensions: ", magnet_dimensions);
+    print_distribution("rod volume:        ", rod_volume);
+    print_distribution("angular velocity:  ", angular_velocity);
+    std::cout << '\n';
+}
+
+auto sample_monte_carlo(const simulation_properties& base, const monte_carlo_properties& properties) -> batch_design {
+    batch_design design;
+    auto&        names = design.parameter_names;
+
+    if (properties.mass.enabled()) {
+        names.emplace_back("mass");
+    }
+    if (properties.magnet_remanence.enabled()) {
+        names.emplace_back("magnet_remanence");
+    }
+    if (properties.magnet_dimensions.enabled()) {
+        std::visit(
+            [&](auto&& shape) {
+                using shape_type = std::decay_t<decltype(shape)>;
+                if constexpr (std::is_same_v<shape_type, permanent_magnet_cylindrical>) {
+                    names.insert(names.end(), {"magnet_length", "magnet_radius"});
+                } else if constexpr (std::is_same_v<shape_type, permanent_magnet_rectangular>) {
+                    names.insert(names.end(), {"magnet_width", "magnet_height", "magnet_length"});
+                }
+            },
+            base.satellite.magnet.shape);
+    }
+    if (properties.rod_volume.enabled()) {
+        for (std::size_t i = 0; i < base.satellite.rods.size(); ++i) {
+            names.push_back(std::format("rod_volume_{}", i));
+        }
+    }
+    if (properties.angular_velocity.enabled()) {
+        names.insert(names.end(), {"w0_x", "w0_y", "w0_z"});
+    }
+
+    std::mt19937_64 generator(properties.seed);
+    design.jobs.reserve(properties.samples);
+
+    for (std::size_t sample = 0; sample < properties.samples; ++sample) {
+        auto& job       = design.jobs.emplace_back(base);
+        auto& satellite = job.properties.satellite;
+        auto& values    = job.parameters;
+
+        // scale a value by a relative deviation and record it
+        const auto vary = [&](const parameter_distribution& distribution, real& value) {
+            value *= 1.0 + distribution.draw(generator);
+            values.push_back(value);
+        };
+
+        if (properties.mass.enabled()) {
+            vary(properties.mass, satellite.mass_kg);
+        }
+        if (properties.magnet_remanence.enabled()) {
+            vary(properties.magnet_remanence, satellite.magnet.remanence_t);
+        }
+        if (properties.magnet_dimensions.enabled()) {
+            std::visit(
+                [&](auto&& shape) {
+                    using shape_type = std::decay_t<decltype(shape)>;
+                    if constexpr (std::is_same_v<shape_type, permanent_magnet_cylindrical>) {
+                        vary(properties.magnet_dimensions, shape.length_m);
+                        vary(properties.magnet_dimensions, shape.radius_m);
+                    } else if constexpr (std::is_same_v<shape_type, permanent_magnet_rectangular>) {
+                        vary(properties.magnet_dimensions, shape.width_m);
+                        vary(properties.magnet_dimensions, shape.height_m);
+                        vary(properties.magnet_dimensions, shape.length_m);
+                    }
+                },
+                satellite.magnet.shape);
+        }
+        if (properties.rod_volume.enabled()) {
+            for (auto& rod : satellite.rods) {
+                vary(properties.rod_volume, rod.volume_m3);
+            }
+        }
+        if (properties.angular_velocity.enabled()) {
+            for (int axis = 0; axis < 3; ++axis) {
+                auto& omega = job.properties.angular_velocity[axis];
+                omega += properties.angular_velocity.draw(generator);
+                values.push_back(omega);
+            }
+        }
+    }
+
+    return design;
+}
+
+}  // namespace aos
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "aos/batch/batch_runner.hpp"
+#include "aos/core/types.hpp"
+#include "aos/simulation/config.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+namespace aos {
+
+enum distribution_type : uint8_t {
+    distribution_type_none,     // parameter keeps its nominal value
+    distribution_type_uniform,  // uniform in [-spread, spread]
+    distribution_type_normal,   // normal with standard deviation spread
+};
+
+struct parameter_distribution {
+    distribution_type type{distribution_type_none};
+    real              spread{};
+
+    // deviation from the nominal value
+    [[nodiscard]] auto draw(std::mt19937_64& generator) const -> real;
+
+    [[nodiscard]] auto enabled() const -> bool;
+
+    void from_toml(const toml_table& table);
+};
+
+/**
+ * @brief Monte Carlo distribution spec (`[monte_carlo]` table).
+ *
+ * Relative deviations scale the nominal value by (1 + deviation), the angular velocity deviation is added in rad/s.
+ * Magnet dimensions, rod volumes and angular velocity components are drawn independently of each other.
+ */
+struct monte_carlo_properties {
+    std::size_t            samples{};
+    std::uint64_t          seed{};
+    parameter_distribution mass;               // [-] relative
+    parameter_distribution magnet_remanence;   // [-] relative
+    parameter_distribution magnet_dimensions;  // [-] relative
+    parameter_distribution rod_volume;         // [-] relative
+    parameter_distribution angular_velocity;   // [rad/s] absolute
+
+    void from_toml(const toml_table& table);
+    void debug_print() const;
+};
+
+// draw the samples in order from one generator, so a seed reproduces the same batch regardless of the thread count
+[[nodiscard]] auto sample_monte_carlo(const simulation_properties& base, const monte_carlo_properties& properties) -> batch_design;
+
+}  // namespace aos
@@ -0,0 +1,300 @@
+#include "parameter_sweep.hpp"
+
+#include "aos/batch/batch_runner.hpp"
+#include "aos/components/permanent_magnet.hpp"
+#include "aos/core/types.hpp"
+#include "aos/simulation/config.hpp"
+
+#include <toml++/toml.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace aos {
+
+namespace {
+
+using unit_points = std::vector<std::vector<real>>;  // [point][axis] in [0, 1]
+
+// primitive polynomial (degree, coefficients) and initial direction numbers, Joe & Kuo (2008) dimensions 2..16
+struct sobol_direction {
+    unsigned                degree;
+    unsigned                coefficients;
+    std::array<unsigned, 6> initial;
+};
+
+constexpr auto sobol_directions = std::to_array<sobol_direction>({
+    {1, 0, {1}},
+    {2, 1, {1, 3}},
+    {3, 1, {1, 3, 1}},
+    {3, 2, {1, 1, 1}},
+    {4, 1, {1, 1, 3, 3}},
+    {4, 4, {1, 3, 5, 13}},
+    {5, 2, {1, 1, 5, 5, 17}},
+    {5, 4, {1, 1, 5, 5, 5}},
+    {5, 7, {1, 1, 7, 11, 19}},
+    {5, 11, {1, 1, 5, 1, 1}},
+    {5, 13, {1, 1, 1, 3, 11}},
+    {5, 14, {1, 3, 5, 5, 31}},
+    {6, 1, {1, 3, 3, 9, 7, 49}},
+    {6, 13, {1, 1, 1, 15, 21, 21}},
+    {6, 16, {1, 3, 1, 13, 27, 49}},
+});
+
+auto design_name(sweep_design_type design) -> std::string_view {
+    switch (design) {
+        case sweep_design_latin_hypercube:
+            return "latin_hypercube";
+        case sweep_design_sobol:
+            return "sobol";
+        default:
+            return "grid";
+    }
+}
+
+auto grid_points(const std::vector<sweep_axis>& axes) -> unit_points {
+    const auto num_points = std::accumulate(axes.begin(), axes.end(), std::size_t{1}, [](std::size_t n, const sweep_axis& axis) { return n * axis.steps; });
+
+    unit_points points(num_points, std::vector<real>(axes.size()));
+    for (std::size_t i = 0; i < num_points; ++i) {
+        // the last axis varies fastest
+        std::size_t remainder = i;
+        for (std::size_t axis = axes.size(); axis-- > 0;) {
+            const auto steps = axes[axis].steps;
+            const auto step  = remainder % steps;
+            remainder /= steps;
+            points[i][axis] = steps > 1 ? static_cast<real>(step) / static_cast<real>(steps - 1) : 0.0;
+        }
+    }
+    return points;
+}
+
+auto latin_hypercube_points(std::size_t num_points, std::size_t num_axes, std::uint64_t seed) -> unit_points {
+    std::mt19937_64                      generator(seed);
+    std::uniform_real_distribution<real> jitter(0.0, 1.0);
+    std::vector<std::size_t>             strata(num_points);
+
+    unit_points points(num_points, std::vector<real>(num_axes));
+    for (std::size_t axis = 0; axis < num_axes; ++axis) {
+        std::iota(strata.begin(), strata.end(), std::size_t{0});
+        std::ranges::shuffle(strata, generator);
+        for (std::size_t i = 0; i < num_points; ++i) {
+            points[i][axis] = (static_cast<real>(strata[i]) + jitter(generator)) / static_cast<real>(num_points);
+        }
+    }
+    return points;
+}
+
+auto sobol_points(std::size_t num_points, std::size_t num_axes) -> unit_points {
+    constexpr unsigned bits = 32;
+
+    if (num_axes > sobol_directions.size() + 1) {
+        throw std::runtime_error("Sobol sweep supports at most " + std::to_string(sobol_directions.size() + 1) + " axes");
+    }
+
+    // direction numbers scaled to 32 bit integers, the first axis is the van der Corput sequence
+    std::vector<std::array<std::uint32_t, bits>> directions(num_axes);
+    for (std::size_t axis = 0; axis < num_axes; ++axis) {
+        auto& v = directions[axis];
+        if (axis == 0) {
+            for (unsigned k = 0; k < bits; ++k) {
+                v[k] = std::uint32_t{1} << (bits - 1 - k);
+            }
+            continue;
+        }
+
+        const auto& [s, a, m] = sobol_directions[axis - 1];
+        for (unsigned k = 0; k < bits; ++k) {
+            if (k < s) {
+                v[k] = m[k] << (bits - 1 - k);
+                continue;
+            }
+            v[k] = v[k - s] ^ (v[k - s] >> s);
+            for (unsigned j = 1; j < s; ++j) {
+                if (((a >> (s - 1 - j)) & 1U) != 0) {
+                    v[k] ^= v[k - j];
+                }
+            }
+        }
+    }
+
+    // gray code order, each point differs from the previous one by one direction number
+    constexpr real             scale = 1.0 / 4294967296.0;  // 2^-32
+    std::vector<std::uint32_t> x(num_axes, 0);
+    unit_points                points(num_points, std::vector<real>(num_axes, 0.0));
+    for (std::size_t i = 1; i < num_points; ++i) {
+        const auto c = static_cast<unsigned>(std::countr_one(i - 1));
+        if (c >= bits) {
+            throw std::runtime_error("Sobol sweep supports at most 2^32 samples");
+        }
+        for (std::size_t axis = 0; axis < num_axes; ++axis) {
+            x[axis] ^= directions[axis][c];
+            points[i][axis] = static_cast<real>(x[axis]) * scale;
+        }
+    }
+    return points;
+}
+
+template <typename shape_type>
+auto magnet_shape(simulation_properties& properties, std::string_view parameter) -> shape_type& {
+    auto* shape = std::get_if<shape_type>(&properties.satellite.magnet.shape);
+    if (shape == nullptr) {
+        throw std::runtime_error("Sweep parameter '" + std::string(parameter) + "' does not match the magnet shape");
+    }
+    return *shape;
+}
+
+}  // namespace
+
+auto sweep_axis::value_at(real unit) const -> real {
+    if (logarithmic) {
+        return min * std::pow(max / min, unit);
+    }
+    return min + ((max - min) * unit);
+}
+
+void sweep_axis::from_toml(const toml_table& table) {
+    parameter   = table["parameter"].value_or<std::string>("");
+    min         = table["min"].value_or(0.0);
+    max         = table["max"].value_or(0.0);
+    steps       = table["steps"].value_or<std::size_t>(2);
+    logarithmic = table["log"].value_or(false);
+
+    if (parameter.empty()) {
+        throw std::runtime_error("Sweep axis needs a 'parameter'");
+    }
+    if (steps == 0) {
+        throw std::runtime_error("Sweep axis 'steps' must be positive");
+    }
+    if (logarithmic && (min <= 0.0 || max <= 0.0)) {
+        throw std::runtime_error("Logarithmic sweep axis needs a positive range");
+    }
+}
+
+void sweep_properties::from_toml(const toml_table& table) {
+    const auto name = table["design"].value_or<std::string>("grid");
+    if (name == "grid") {
+        design = sweep_design_grid;
+    } else if (name == "latin_hypercube") {
+        design = sweep_design_latin_hypercube;
+    } else if (name == "sobol") {
+        design = sweep_design_sobol;
+    } else {
+        throw std::runtime_error("Unknown sweep design: " + name);
+    }
+
+    samples = table["samples"].value_or<std::size_t>(64);  // NOLINT(readability-magic-numbers)
+    seed    = table["seed"].value_or<std::uint64_t>(1);
+
+    axes.clear();
+    if (const auto* entries = table["axes"].as_array()) {
+        for (const auto& entry : *entries) {
+            if (const auto* axis = entry.as_table()) {
+                axes.emplace_back().from_toml(*axis);
+            }
+        }
+    }
+}
+
+void sweep_properties::debug_print() const {
+    std::cout << "--  sweep properties  --"              //
+              << "\n  design:  " << design_name(design)  //
+              << "\n  samples: " << samples              //
+              << "\n  seed:    " << seed;
+    for (const auto& axis : axes) {
+        std::cout << "\n  axis:    " << axis.parameter << " [" << axis.min << ", " << axis.max << "] steps " << axis.steps << (axis.logarithmic ? " log" : "");
+    }
+    std::cout << '\n';
+}
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+void set_sweep_parameter(simulation_properties& properties, std::string_view parameter, real value) {
+    auto& satellite = properties.satellite;
+
+    if (parameter == "mass") {
+        satellite.mass_kg = value;
+    } else if (parameter == "magnet_remanence") {
+        satellite.magnet.remanence_t = value;
+    } else if (parameter == "magnet_length") {
+        std::visit([&](auto&& shape) { shape.length_m = value; }, satellite.magnet.shape);
+    } else if (parameter == "magnet_radius") {
+        magnet_shape<permanent_magnet_cylindrical>(properties, parameter).radius_m = value;
+    } else if (parameter == "magnet_width") {
+        magnet_shape<permanent_magnet_rectangular>(properties, parameter).width_m = value;
+    } else if (parameter == "magnet_height") {
+        magnet_shape<permanent_magnet_rectangular>(properties, parameter).height_m = value;
+    } else if (parameter == "rod_volume") {
+        for (auto& rod : satellite.rods) {
+            rod.volume_m3 = value;
+        }
+    } else if (parameter == "hysteresis_ms") {
+        satellite.hysteresis.ms = value;
+    } else if (parameter == "hysteresis_a") {
+        satellite.hysteresis.a = value;
+    } else if (parameter == "hysteresis_k") {
+        satellite.hysteresis.k = value;
+    } else if (parameter == "hysteresis_c") {
+        satellite.hysteresis.c = value;
+    } else if (parameter == "hysteresis_alpha") {
+        satellite.hysteresis.alpha = value;
+    } else if (parameter == "angular_velocity_x") {
+        properties.angular_velocity.x() = value;
+    } else if (parameter == "angular_velocity_y") {
+        properties.angular_velocity.y() = value;
+    } else if (parameter == "angular_velocity_z") {
+        properties.angular_velocity.z() = value;
+    } else {
+        throw std::runtime_error("Unknown sweep parameter: " + std::string(parameter));
+    }
+}
+
+auto sample_sweep(const simulation_properties& base, const sweep_properties& properties) -> batch_design {
+    const auto& axes = properties.axes;
+    if (axes.empty()) {
+        throw std::runtime_error("Sweep needs at least one axis");
+    }
+
+    unit_points points;
+    switch (properties.design) {
+        case sweep_design_latin_hypercube:
+            points = latin_hypercube_points(properties.samples, axes.size(), properties.seed);
+            break;
+        case sweep_design_sobol:
+            points = sobol_points(properties.samples, axes.size());
+            break;
+        default:
+            points = grid_points(axes);
+            break;
+    }
+
+    batch_design design;
+    for (const auto& axis : axes) {
+        design.parameter_names.push_back(axis.parameter);
+    }
+
+    design.jobs.reserve(points.size());
+    for (const auto& point : points) {
+        auto& job = design.jobs.emplace_back(base);
+        for (std::size_t axis = 0; axis < axes.size(); ++axis) {
+            const real value = axes[axis].value_at(point[axis]);
+            set_sweep_parameter(job.properties, axes[axis].parameter, value);
+            job.parameters.push_back(value);
+        }
+    }
+
+    return design;
+}
+
+}  // namespace aos
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "aos/batch/batch_runner.hpp"
+#include "aos/core/types.hpp"
+#include "aos/simulation/config.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aos {
+
+enum sweep_design_type : uint8_t {
+    sweep_design_grid,             // Cartesian product of the axis steps
+    sweep_design_latin_hypercube,  // one sample per stratum and axis, randomly paired
+    sweep_design_sobol,            // low-discrepancy sequence, best with a power of two samples
+};
+
+struct sweep_axis {
+    std::string parameter;  // see set_sweep_parameter()
+    real        min{};
+    real        max{};
+    std::size_t steps{};        // grid points along this axis
+    bool        logarithmic{};  // uniform in log(value), for ranges over decades
+
+    // value at a position in [0, 1] along the axis
+    [[nodiscard]] auto value_at(real unit) const -> real;
+
+    void from_toml(const toml_table& table);
+};
+
+// parameter sweep spec (`[sweep]` table with `[[sweep.axes]]` entries)
+struct sweep_properties {
+    sweep_design_type       design{sweep_design_grid};
+    std::size_t             samples{};  // latin hypercube and sobol only
+    std::uint64_t           seed{};     // latin hypercube only
+    std::vector<sweep_axis> axes;
+
+    void from_toml(const toml_table& table);
+    void debug_print() const;
+};
+
+/**
+ * @brief Set a named parameter of a configuration.
+ *
+ * mass, magnet_remanence, magnet_length, magnet_radius (cylindrical), magnet_width, magnet_height (rectangular),
+ * rod_volume (every rod), hysteresis_ms, hysteresis_a, hysteresis_k, hysteresis_c, hysteresis_alpha (spacecraft
+ * material, rods with their own material keep it), angular_velocity_x, angular_velocity_y, angular_velocity_z.
+ */
+void set_sweep_parameter(simulation_properties& properties, std::string_view parameter, real value);
+
+// unit-cube points of the design mapped onto the axes, one job per point
+[[nodiscard]] auto sample_sweep(const simulation_properties& base, const sweep_properties& properties) -> batch_design;
+
+}  // namespace aos
@@ -0,0 +1,197 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace aos {
+
+thread_pool::thread_pool(std::size_t num_threads) {
+    if (num_threads == 0) {
+        num_threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    _queues.reserve(num_threads);
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        _queues.push_back(std::make_unique<worker_queue>());
+    }
+
+    _statistics.resize(num_threads);
+
+    _threads.reserve(num_threads);
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        _threads.emplace_back([this, i] { worker_loop(i); });
+    }
+}
+
+thread_pool::~thread_pool() {
+    {
+        const std::scoped_lock lock(_mutex);
+        _stopping = true;
+    }
+    _work_available.notify_all();
+    _threads.clear();  // joins
+}
+
+auto thread_pool::size() const -> std::size_t {
+    return _queues.size();
+}
+
+void thread_pool::submit(task job, double cost) {
+    {
+        auto&                  queue = *_queues[least_loaded_queue()];
+        const std::scoped_lock lock(queue.mutex);
+        queue.tasks.push_back({.job = std::move(job), .cost = cost});
+        queue.cost += cost;
+    }
+
+    {
+        const std::scoped_lock lock(_mutex);
+        ++_queued;
+        ++_pending;
+    }
+    _work_available.notify_one();
+}
+
+void thread_pool::wait() {
+    std::unique_lock lock(_mutex);
+    _all_done.wait(lock, [this] { return _pending == 0; });
+
+    if (_error) {
+        std::rethrow_exception(std::exchange(_error, nullptr));
+    }
+}
+
+auto thread_pool::statistics() const -> const std::vector<worker_statistics>& {
+    return _statistics;
+}
+
+void thread_pool::reset_statistics() {
+    std::ranges::fill(_statistics, worker_statistics{});
+}
+
+void thread_pool::worker_loop(std::size_t worker) {
+    using clock = std::chrono::steady_clock;
+
+    auto& statistics = _statistics[worker];
+    while (true) {
+        task job;
+        bool stolen = false;
+        if (take(worker, job, stolen)) {
+            const auto start = clock::now();
+            try {
+                job(worker);
+            } catch (...) {
+                const std::scoped_lock lock(_mutex);
+                if (not _error) {
+                    _error = std::current_exception();
+                }
+            }
+
+            statistics.busy_s += std::chrono::duration<double>(clock::now() - start).count();
+            statistics.tasks += 1;
+            statistics.stolen += stolen ? 1 : 0;
+
+            {
+                auto&                  queue = *_queues[worker];
+                const std::scoped_lock queue_lock(queue.mutex);
+                queue.running = 0.0;
+            }
+
+            const std::scoped_lock lock(_mutex);
+            if (--_pending == 0) {
+                _all_done.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock lock(_mutex);
+        _work_available.wait(lock, [this] { return _stopping || _queued > 0; });
+        if (_stopping && _queued == 0) {
+            return;
+        }
+    }
+}
+
+auto thread_pool::take(std::size_t worker, task& job, bool& stolen) -> bool {
+    auto& own = *_queues[worker];
+    auto  pop = [&](worker_queue& queue, bool from_front) {
+        // a stolen task moves its cost from the victim's waiting work to the thief's running work under both locks
+        std::unique_lock queue_lock(queue.mutex, std::defer_lock);
+        std::unique_lock own_lock(own.mutex, std::defer_lock);
+        if (&queue == &own) {
+            queue_lock.lock();
+        } else {
+            std::lock(queue_lock, own_lock);
+        }
+        if (queue.tasks.empty()) {
+            return false;
+        }
+
+        auto& entry = from_front ? queue.tasks.front() : queue.tasks.back();
+        job         = std::move(entry.job);
+        queue.cost -= entry.cost;
+        own.running = entry.cost;
+        if (from_front) {
+            queue.tasks.pop_front();
+        } else {
+            queue.tasks.pop_back();
+        }
+        return true;
+    };
+
+    // the owner works through its queue in submission order, thieves take the last task of the fullest queue
+    stolen = false;
+    while (not pop(*_queues[worker], true)) {
+        const auto victim = most_loaded_queue(worker);
+        if (victim == worker) {
+            return false;
+        }
+        if (pop(*_queues[victim], false)) {
+            stolen = true;
+            break;
+        }
+    }
+
+    const std::scoped_lock count_lock(_mutex);
+    --_queued;
+    return true;
+}
+
+auto thread_pool::least_loaded_queue() const -> std::size_t {
+    std::size_t best      = 0;
+    double      best_cost = std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0; i < _queues.size(); ++i) {
+        const std::scoped_lock lock(_queues[i]->mutex);
+        if (_queues[i]->cost + _queues[i]->running < best_cost) {
+            best      = i;
+            best_cost = _queues[i]->cost + _queues[i]->running;
+        }
+    }
+    return best;
+}
+
+auto thread_pool::most_loaded_queue(std::size_t excluded) const -> std::size_t {
+    std::size_t best      = excluded;
+    double      best_cost = -1.0;
+    for (std::size_t i = 0; i < _queues.size(); ++i) {
+        if (i == excluded) {
+            continue;
+        }
+
+        const std::scoped_lock lock(_queues[i]->mutex);
+        if (not _queues[i]->tasks.empty() && _queues[i]->cost > best_cost) {
+            best      = i;
+            best_cost = _queues[i]->cost;
+        }
+    }
+    return best;
+}
+
+}  // namespace aos
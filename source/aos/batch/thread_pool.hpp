@@ -0,0 +1,93 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace aos {
+
+/**
+ * @brief Fixed set of worker threads with one task queue per worker.
+ *
+ * Every task carries a cost estimate. A task goes to the worker with the least estimated work, counting both its queue
+ * and the task it is running; submitting the longest tasks first makes this a longest-processing-time-first schedule. A
+ * worker takes its own tasks from the front and, once its queue runs dry, steals from the back of the queue with the
+ * most estimated work left, so a run that ends early (or an estimate that was wrong) frees its worker for the remaining
+ * tasks at once. Tasks get the index of the worker that runs them for per-worker scratch objects.
+ */
+class thread_pool {
+public:
+
+    using task = std::function<void(std::size_t worker)>;
+
+    struct worker_statistics {
+        std::size_t tasks{};   // tasks run
+        std::size_t stolen{};  // of those, taken from another worker's queue
+        double      busy_s{};  // [s] time spent in tasks
+    };
+
+    thread_pool(const thread_pool&)                    = delete;
+    thread_pool(thread_pool&&)                         = delete;
+    auto operator=(const thread_pool&) -> thread_pool& = delete;
+    auto operator=(thread_pool&&) -> thread_pool&      = delete;
+
+    // 0 threads uses every hardware thread
+    explicit thread_pool(std::size_t num_threads = 0);
+    ~thread_pool();
+
+    [[nodiscard]] auto size() const -> std::size_t;
+
+    // cost is an estimate in any unit, only relative values matter
+    void submit(task job, double cost = 1.0);
+
+    // block until every submitted task has finished, rethrows the first exception a task threw
+    void wait();
+
+    // per worker, accumulated since construction or the last reset; read after wait()
+    [[nodiscard]] auto statistics() const -> const std::vector<worker_statistics>&;
+    void reset_statistics();
+
+protected:
+
+    struct queued_task {
+        task   job;
+        double cost;
+    };
+
+    struct worker_queue {
+        std::mutex              mutex;
+        std::deque<queued_task> tasks;
+        double                  cost{};     // estimated work waiting in tasks
+        double                  running{};  // estimated work of the task the owner is running
+    };
+
+    void worker_loop(std::size_t worker);
+
+    // own queue first, then the other queue with the most estimated work; the cost of the task is counted as running
+    [[nodiscard]] auto take(std::size_t worker, task& job, bool& stolen) -> bool;
+
+    // queued plus running work
+    [[nodiscard]] auto least_loaded_queue() const -> std::size_t;
+    [[nodiscard]] auto most_loaded_queue(std::size_t excluded) const -> std::size_t;
+
+private:
+
+    std::vector<std::unique_ptr<worker_queue>> _queues;
+    std::vector<worker_statistics>             _statistics;  // each entry written only by its worker
+    std::vector<std::jthread>                  _threads;
+    std::mutex                                 _mutex;
+    std::condition_variable                    _work_available;
+    std::condition_variable                    _all_done;
+    std::size_t                                _queued{};   // tasks waiting in a queue
+    std::size_t                                _pending{};  // tasks queued or running
+    bool                                       _stopping{};
+    std::exception_ptr                         _error;
+};
+
+}  // namespace aos
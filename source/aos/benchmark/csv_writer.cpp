@@ -0,0 +1,199 @@
+#include "csv_writer.hpp"
+
+#include "aos/components/spacecraft.hpp"
+#include "aos/core/state.hpp"
+#include "aos/core/types.hpp"
+#include "aos/environment/environment.hpp"
+#include "aos/simulation/config.hpp"
+#include "aos/simulation/details/csv_sink_impl.hpp"
+#include "aos/simulation/dynamics.hpp"
+#include "aos/simulation/observer.hpp"
+#include "aos/simulation/row_sink.hpp"
+#include "aos/simulation/simulation.hpp"
+#include "aos/verify/details/verification_observer_impl.hpp"
+
+#include <toml++/toml.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iomanip>
+#include <ios>
+#include <memory>
+#include <print>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace aos {
+
+namespace {
+
+constexpr std::string_view scenario_path = "sample_short.toml";
+constexpr real             record_time   = 3000.0;  // [s] of the scenario whose steps provide the rows
+constexpr std::size_t      min_rows      = 200000;  // rows written per writer, the recorded rows are repeated
+constexpr real             bytes_per_mb  = 1e6;
+
+// keeps the states the integrator hands to the observer
+class state_recorder : public observer {
+public:
+
+    void write_header() override {}
+    void write(const system_state& state, real time) override { states.emplace_back(state, time); }
+
+    std::vector<std::pair<system_state, real>> states;
+};
+
+// the verification observer with its column hooks made public, its own output file stays empty
+class verification_rows : public verification_observer_impl {
+public:
+
+    using verification_observer_impl::append_columns;
+    using verification_observer_impl::append_values;
+    using verification_observer_impl::verification_observer_impl;
+};
+
+// the previous sink: iostream for fixed columns, std::print for shortest ones, one value at a time
+class stream_sink : public row_sink {
+public:
+
+    stream_sink(const std::string& filename, int precision) : _file(filename) { _file << std::fixed << std::setprecision(precision); }
+
+    void write_header(std::span<const observer_column> columns) override {
+        _formats.clear();
+        for (std::size_t i = 0; i < columns.size(); ++i) {
+            _file << (i == 0 ? "" : ",") << columns[i].name;
+            _formats.push_back(columns[i].format);
+        }
+        _file << '\n';
+        _bytes = static_cast<std::uint64_t>(_file.tellp());
+    }
+
+    void write_rows(std::span<const real> values, std::size_t num_rows) override {
+        const std::size_t width = _formats.size();
+        for (std::size_t row = 0; row < num_rows; ++row) {
+            for (std::size_t i = 0; i < width; ++i) {
+                if (i > 0) {
+                    _file << ',';
+                }
+                if (_formats[i] == column_format_fixed) {
+                    _file << values[(row * width) + i];
+                } else {
+                    std::print(_file, "{}", values[(row * width) + i]);
+                }
+            }
+            _file << '\n';
+        }
+        _bytes = static_cast<std::uint64_t>(_file.tellp());
+    }
+
+    void flush() override { _file.flush(); }
+
+    [[nodiscard]] auto size() const -> std::uint64_t override { return _bytes; }
+
+private:
+
+    std::ofstream              _file;
+    std::vector<column_format> _formats;
+    std::uint64_t              _bytes{};  // written so far, including what the stream still buffers
+};
+
+struct writer_result {
+    real        seconds;
+    std::size_t bytes;
+};
+
+// the rows go to the sink in batches like an async_writer hands them over
+auto measure(row_sink& sink, const std::filesystem::path& path, std::span<const observer_column> columns, std::span<const real> rows, std::size_t repetitions)
+    -> writer_result {
+    using clock = std::chrono::steady_clock;
+
+    const std::size_t num_rows = rows.size() / columns.size();
+    const auto        start    = clock::now();
+    sink.write_header(columns);
+    for (std::size_t r = 0; r < repetitions; ++r) {
+        sink.write_rows(rows, num_rows);
+    }
+    sink.flush();
+    const auto stop = clock::now();
+
+    return {
+        .seconds = std::chrono::duration<real>(stop - start).count(),
+        .bytes   = static_cast<std::size_t>(std::filesystem::file_size(path)),
+    };
+}
+
+}  // namespace
+
+void benchmark_csv_writer() {
+    if (not std::filesystem::exists(scenario_path)) {
+        throw std::runtime_error(std::format("csv writer benchmark needs {} in the working directory", scenario_path));
+    }
+
+    simulation_properties properties;
+    properties.from_toml(toml::parse_file(scenario_path));
+    properties.t_end = properties.t_start + record_time;
+
+    auto sat      = spacecraft::create(properties.satellite);
+    auto env      = environment::create(properties.environment);
+    auto recorder = std::make_shared<state_recorder>();
+    simulation sim(properties, sat, env, dynamics::create(sat, env, properties.models), recorder);
+    sim.set_verbose(false);
+    sim.run();
+
+    const auto                   directory = std::filesystem::temp_directory_path();
+    std::vector<observer_column> columns;
+    std::vector<real>            rows;
+    {
+        const verification_rows verification((directory / "pmaos_csv_unused.csv").string(), sat, env, properties.observer, nullptr);
+        verification.append_columns(columns);
+        for (const auto& [state, time] : recorder->states) {
+            verification.append_values(state, time, rows);
+        }
+    }
+
+    const std::size_t num_rows    = recorder->states.size();
+    const std::size_t repetitions = (min_rows + num_rows - 1) / num_rows;
+    const auto        total_rows  = static_cast<real>(num_rows * repetitions);
+    const int         precision   = properties.observer.precission;
+
+    std::println("csv writer: {} columns, {} rows", columns.size(), num_rows * repetitions);
+
+    const auto stream_path   = directory / "pmaos_csv_stream.csv";
+    const auto fixed_path    = directory / "pmaos_csv_fixed.csv";
+    const auto shortest_path = directory / "pmaos_csv_shortest.csv";
+
+    writer_result stream{};
+    writer_result fixed{};
+    writer_result shortest{};
+    {
+        stream_sink sink(stream_path.string(), precision);
+        stream = measure(sink, stream_path, columns, rows, repetitions);
+    }
+    {
+        csv_sink_impl sink(fixed_path.string(), precision);
+        fixed = measure(sink, fixed_path, columns, rows, repetitions);
+    }
+    {
+        csv_sink_impl sink(shortest_path.string(), precision, true);
+        shortest = measure(sink, shortest_path, columns, rows, repetitions);
+    }
+
+    std::println("  {:<18} {:>14} {:>10} {:>9}", "writer", "rows/s", "MB", "speedup");
+    for (const auto& [name, result] : {std::pair{"iostream", stream}, std::pair{"to_chars", fixed}, std::pair{"to_chars shortest", shortest}}) {
+        std::println("  {:<18} {:>14.0f} {:>10.1f} {:>8.2f}x",  //
+                     name, total_rows / result.seconds, static_cast<real>(result.bytes) / bytes_per_mb, stream.seconds / result.seconds);
+    }
+
+    for (const auto& path : {stream_path, fixed_path, shortest_path, directory / "pmaos_csv_unused.csv"}) {
+        std::filesystem::remove(path);
+    }
+}
+
+}  // namespace aos
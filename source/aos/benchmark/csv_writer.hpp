@@ -0,0 +1,8 @@
+#pragma once
+
+namespace aos {
+
+// Compare rows per second of the iostream CSV writer and the to_chars sink on the verification column set (sample_short.toml)
+void benchmark_csv_writer();
+
+}  // namespace aos
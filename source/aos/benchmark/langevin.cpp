@@ -0,0 +1,111 @@
+#include "langevin.hpp"
+
+#include "aos/core/langevin.hpp"
+#include "aos/core/types.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <print>
+#include <random>
+#include <vector>
+
+namespace aos {
+
+namespace {
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+constexpr std::size_t sample_count    = 1U << 16U;
+constexpr int         repetitions     = 200;
+constexpr real        sample_range    = 40.0;  // typical |H_eff / a| stays well inside this range
+constexpr int         reference_depth = 80;    // continued fraction depth for the reference values
+
+// Lambert continued fraction L(x) = x / (3 + x^2 / (5 + x^2 / (7 + ...))) in extended precision
+auto langevin_reference(real x) -> long double {
+    const long double xl = x;
+    if (std::abs(xl) > 20.0L) {
+        return (xl > 0 ? 1.0L : -1.0L) - (1.0L / xl) + std::copysign(2.0L * std::exp(-2.0L * std::abs(xl)), xl);
+    }
+
+    const long double t = xl * xl;
+    long double       d = (2.0L * reference_depth) + 1.0L;
+    for (int j = reference_depth - 1; j >= 1; --j) {
+        d = (2.0L * j) + 1.0L + (t / d);
+    }
+    return xl / d;
+}
+
+// NOLINTEND(readability-magic-numbers)
+
+template <typename Function>
+auto measure(const std::vector<real>& samples, Function&& function) -> std::pair<real, real> {
+    using clock = std::chrono::steady_clock;
+
+    real       checksum = 0.0;
+    const auto start    = clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+        for (const real x : samples) {
+            checksum += function(x);
+        }
+    }
+    const auto   stop    = clock::now();
+    const real   seconds = std::chrono::duration<real>(stop - start).count();
+    const real   calls   = static_cast<real>(samples.size()) * repetitions;
+    return {seconds * 1e9 / calls, checksum};  // NOLINT(readability-magic-numbers)
+}
+
+auto max_relative_error(const std::vector<real>& samples, langevin_evaluator evaluator) -> std::pair<real, real> {
+    real worst   = 0.0;
+    real worst_x = 0.0;
+    for (const real x : samples) {
+        const long double expected = langevin_reference(x);
+        if (expected == 0.0L) {
+            continue;
+        }
+
+        const auto error = static_cast<real>(std::abs((langevin(x, evaluator) - expected) / expected));
+        if (error > worst) {
+            worst   = error;
+            worst_x = x;
+        }
+    }
+    return {worst, worst_x};
+}
+
+}  // namespace
+
+void benchmark_langevin() {
+    std::mt19937_64                      generator(1);  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    std::uniform_real_distribution<real> uniform(-sample_range, sample_range);
+    std::uniform_real_distribution<real> exponent(-12.0, 0.0);  // NOLINT(readability-magic-numbers)
+
+    // mostly uniform samples, with a quarter log-distributed near zero where cancellation hurts
+    std::vector<real> samples(sample_count);
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        samples[i] = (i % 4 == 0) ? std::pow(10.0, exponent(generator)) : uniform(generator);  // NOLINT(readability-magic-numbers)
+    }
+
+    const auto [exact_ns, exact_sum] = measure(samples, [](real x) { return langevin_exact(x); });
+    const auto [fast_ns, fast_sum]   = measure(samples, [](real x) { return langevin_fast(x); });
+
+    // dense sweep over the segment structure of the fast evaluator
+    std::vector<real> sweep;
+    for (real x = 1e-12; x < 1.0; x *= 1.001) {  // NOLINT(readability-magic-numbers)
+        sweep.push_back(x);
+    }
+    for (real x = 1.0; x < sample_range; x += 1e-4) {  // NOLINT(readability-magic-numbers)
+        sweep.push_back(x);
+    }
+
+    const auto [exact_err, exact_err_x] = max_relative_error(sweep, langevin_evaluator_exact);
+    const auto [fast_err, fast_err_x]   = max_relative_error(sweep, langevin_evaluator_fast);
+
+    std::println("langevin: {} samples x {} repetitions", samples.size(), repetitions);
+    std::println("  {:<6} {:>10.3f} ns/call  max rel error {:.3e} (x = {:.6g})  checksum {:.6e}", "exact", exact_ns, exact_err, exact_err_x, exact_sum);
+    std::println("  {:<6} {:>10.3f} ns/call  max rel error {:.3e} (x = {:.6g})  checksum {:.6e}", "fast", fast_ns, fast_err, fast_err_x, fast_sum);
+    std::println("  speedup: {:.2f}x, documented bound: {:.1e}", exact_ns / std::max(fast_ns, 1e-12), langevin_fast_max_relative_error);  // NOLINT
+}
+
+}  // namespace aos
@@ -0,0 +1,8 @@
+#pragma once
+
+namespace aos {
+
+// Compare throughput and accuracy of the Langevin function evaluators
+void benchmark_langevin();
+
+}  // namespace aos
@@ -5,6 +5,7 @@
 #include <toml++/impl/parse_error.hpp>
 #include <toml++/impl/parser.hpp>
 
+#include <charconv>
 #include <cstddef>
 #include <filesystem>
 #include <print>
@@ -12,9 +13,33 @@
 #include <span>
 #include <string>
 #include <string_view>
+#include <system_error>
 
 namespace aos {
 
+namespace {
+
+auto load_config(const std::string& config_path, simulation_properties& properties, bool print_details) -> bool {
+    if (not std::filesystem::exists(config_path)) {
+        std::println(stderr, "Error: File '{}' not found.", config_path);
+        return false;
+    }
+
+    try {
+        auto table = toml::parse_file(config_path);
+        properties.from_toml(table);
+        if (print_details) {
+            properties.debug_print();
+        }
+        return true;
+    } catch (const toml::parse_error& err) {
+        std::println(stderr, "TOML Error: {}", err.description());
+        return false;
+    }
+}
+
+}  // namespace
+
 auto parse_cli(int argc, char** argv, simulation_properties& properties, std::string& output_path) -> bool {
     std::string config_path   = "config.toml";
     bool        print_details = false;
@@ -55,22 +80,76 @@ auto parse_cli(int argc, char** argv, simulation_properties& properties, std::st
         }
     }
 
-    if (not std::filesystem::exists(config_path)) {
-        std::println(stderr, "Error: File '{}' not found.", config_path);
-        return false;
-    }
+    return load_config(config_path, properties, print_details);
+}
 
-    try {
-        auto table = toml::parse_file(config_path);
-        properties.from_toml(table);
-        if (print_details) {
-            properties.debug_print();
+auto parse_batch_cli(int argc, char** argv, simulation_properties& properties, batch_cli_options& options) -> bool {
+    std::string config_path   = "config.toml";
+    bool        print_details = false;
+    options.output_path       = "results.csv";
+
+    auto args = std::span(argv, argc)                                                     //
+                | std::views::transform([](char* arg) { return std::string_view(arg); })  //
+                | std::views::drop(1);
+
+    size_t skip_count = 0;
+    for (auto [i, arg] : args | std::views::enumerate) {
+        if (skip_count > 0) {
+            --skip_count;
+            continue;
         }
-        return true;
-    } catch (const toml::parse_error& err) {
-        std::println(stderr, "TOML Error: {}", err.description());
+
+        if (arg == "-h" || arg == "--help") {
+            std::println(
+                "Usage: batch [config.toml] [options]\n"
+                "Options:\n"
+                "  -s, --spec <file>        Batch spec (default: the config file)\n"
+                "  -o, --output <file>      Results table (default: results.csv)\n"
+                "  -j, --threads <count>    Worker threads (default: all hardware threads)\n"
+                "  -e, --ensemble <lanes>   Integrate up to <lanes> jobs in lockstep (default: off)\n"
+                "  -d, --details            Print simulation details");
+            return false;
+        }
+
+        const bool has_value = i + 1 < std::ranges::ssize(args);
+        if ((arg == "-s" || arg == "--spec") && has_value) {
+            options.spec_path = args[i + 1];
+            skip_count        = 1;
+        } else if ((arg == "-o" || arg == "--output") && has_value) {
+            options.output_path = args[i + 1];
+            skip_count          = 1;
+        } else if ((arg == "-j" || arg == "--threads") && has_value) {
+            const auto value = args[i + 1];
+            if (std::from_chars(value.data(), value.data() + value.size(), options.threads).ec != std::errc{}) {
+                std::println(stderr, "Error: Invalid thread count '{}'", value);
+                return false;
+            }
+            skip_count = 1;
+        } else if ((arg == "-e" || arg == "--ensemble") && has_value) {
+            const auto value = args[i + 1];
+            if (std::from_chars(value.data(), value.data() + value.size(), options.ensemble_lanes).ec != std::errc{}) {
+                std::println(stderr, "Error: Invalid ensemble size '{}'", value);
+                return false;
+            }
+            skip_count = 1;
+        } else if (arg == "-d" || arg == "--details") {
+            print_details = true;
+        } else if (not arg.starts_with('-')) {
+            config_path = arg;
+        } else {
+            std::println(stderr, "Error: Unknown option '{}'", arg);
+            return false;
+        }
+    }
+
+    if (options.spec_path.empty()) {
+        options.spec_path = config_path;
+    } else if (not std::filesystem::exists(options.spec_path)) {
+        std::println(stderr, "Error: File '{}' not found.", options.spec_path);
         return false;
     }
+
+    return load_config(config_path, properties, print_details);
 }
 
 }  // namespace aos
@@ -2,10 +2,21 @@
 
 #include "aos/simulation/config.hpp"
 
+#include <cstddef>
 #include <string>
 
 namespace aos {
 
+struct batch_cli_options {
+    std::string spec_path;         // distribution or sweep spec, the config file when not given
+    std::string output_path;       // results table
+    std::size_t threads{};         // worker threads, 0 uses every hardware thread
+    std::size_t ensemble_lanes{};  // members integrated in lockstep per ensemble, 0 or 1 runs every job on its own
+};
+
 auto parse_cli(int argc, char** argv, simulation_properties& properties, std::string& output_path) -> bool;
 
+// command line of the in-process batch drivers
+auto parse_batch_cli(int argc, char** argv, simulation_properties& properties, batch_cli_options& options) -> bool;
+
 }  // namespace aos
@@ -0,0 +1,112 @@
+#include "everett_table.hpp"
+
+#include "aos/components/hysteresis_rod.hpp"
+#include "aos/core/types.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace aos {
+
+everett_table::everett_table(const preisach_parameters& params)
+    : _preisach(params),
+      _h_max(params.h_max_am),
+      _h_scale(params.hc + params.sigma_c + params.sigma_u),
+      _u_max(map_h(params.h_max_am)),
+      _inv_du(static_cast<real>(params.nodes - 1) / (2.0 * _u_max)),
+      _nodes(params.nodes) {
+    if (_preisach.ms <= 0.0) {
+        throw std::runtime_error("Preisach 'ms' must be positive");
+    }
+    if (_preisach.hc < 0.0) {
+        throw std::runtime_error("Preisach 'hc' must not be negative");
+    }
+    if (_preisach.sigma_c <= 0.0 || _preisach.sigma_u <= 0.0) {
+        throw std::runtime_error("Preisach 'sigma_c' and 'sigma_u' must be positive");
+    }
+    if (_h_max <= 0.0) {
+        throw std::runtime_error("Preisach 'h_max' must be positive");
+    }
+    if (_nodes < 2) {
+        throw std::runtime_error("Preisach table needs at least 2 nodes");
+    }
+
+    std::vector<real> edges(static_cast<std::size_t>(_nodes));
+    for (int i = 0; i < _nodes; ++i) {
+        edges[static_cast<std::size_t>(i)] = unmap_h((i / _inv_du) - _u_max);
+    }
+
+    // E(i, j) = E(i - 1, j) + E(i, j + 1) - E(i - 1, j + 1) + integral over the corner cell [a_i-1, a_i] x [b_j, b_j+1]
+    // cells on the diagonal are only half inside the triangle beta <= alpha
+    _values.assign(static_cast<std::size_t>(_nodes) * static_cast<std::size_t>(_nodes), 0.0);
+    for (int ia = 1; ia < _nodes; ++ia) {
+        const auto a0 = edges[static_cast<std::size_t>(ia - 1)];
+        const auto a1 = edges[static_cast<std::size_t>(ia)];
+        for (int ib = ia - 1; ib >= 0; --ib) {
+            const auto b0     = edges[static_cast<std::size_t>(ib)];
+            const auto b1     = edges[static_cast<std::size_t>(ib + 1)];
+            const real weight = ib + 1 == ia ? 0.5 : 1.0;
+            const real cell   = weight * density(0.5 * (a0 + a1), 0.5 * (b0 + b1)) * (a1 - a0) * (b1 - b0);
+
+            _values[index(ia, ib)] = _values[index(ia - 1, ib)] + _values[index(ia, ib + 1)] - _values[index(ia - 1, ib + 1)] + cell;
+        }
+    }
+
+    // hysterons outside the plane are always saturated, so the plane holds the whole population
+    const real total = _values[index(_nodes - 1, 0)];
+    std::ranges::transform(_values, _values.begin(), [total](real value) { return value / total; });
+}
+
+auto everett_table::parameters() const -> const preisach_parameters& {
+    return _preisach;
+}
+
+auto everett_table::h_max() const -> real {
+    return _h_max;
+}
+
+auto everett_table::evaluate(real alpha, real beta) const -> real {
+    const real fa = (map_h(alpha) + _u_max) * _inv_du;
+    const real fb = (map_h(beta) + _u_max) * _inv_du;
+    const int  ia = std::clamp(static_cast<int>(fa), 0, _nodes - 2);
+    const int  ib = std::clamp(static_cast<int>(fb), 0, _nodes - 2);
+    const real wa = fa - ia;
+    const real wb = fb - ib;
+
+    const real e00 = _values[index(ia, ib)];
+    const real e01 = _values[index(ia, ib + 1)];
+    const real e10 = _values[index(ia + 1, ib)];
+    const real e11 = _values[index(ia + 1, ib + 1)];
+
+    return ((1.0 - wa) * (((1.0 - wb) * e00) + (wb * e01))) + (wa * (((1.0 - wb) * e10) + (wb * e11)));
+}
+
+auto everett_table::create(const preisach_parameters& params) -> std::shared_ptr<const everett_table> {
+    return std::make_shared<const everett_table>(params);
+}
+
+auto everett_table::map_h(real h_am) const -> real {
+    // (-inf, inf) -> (-1, 1), linear with slope 1/h_scale around zero
+    return h_am / (std::abs(h_am) + _h_scale);
+}
+
+auto everett_table::unmap_h(real u) const -> real {
+    return _h_scale * u / (1.0 - std::abs(u));
+}
+
+auto everett_table::density(real alpha, real beta) const -> real {
+    // Lorentzian in the coercive field around hc, Lorentzian in the interaction field around zero
+    const real x_c = (((alpha - beta) * 0.5) - _preisach.hc) / _preisach.sigma_c;
+    const real x_u = ((alpha + beta) * 0.5) / _preisach.sigma_u;
+    return 1.0 / ((1.0 + (x_c * x_c)) * (1.0 + (x_u * x_u)));
+}
+
+auto everett_table::index(int ia, int ib) const -> std::size_t {
+    return (static_cast<std::size_t>(ia) * static_cast<std::size_t>(_nodes)) + static_cast<std::size_t>(ib);
+}
+
+}  // namespace aos
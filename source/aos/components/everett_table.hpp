@@ -0,0 +1,60 @@
+#pragma once
+
+#include "aos/components/hysteresis_rod.hpp"
+#include "aos/core/types.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace aos {
+
+/**
+ * @brief Everett function E(alpha, beta) of one Preisach material, normalized to E(h_max, -h_max) = 1.
+ *
+ * E is the integral of the hysteron density over the triangle beta <= beta' <= alpha' <= alpha. The density is a
+ * product of Lorentzians in the coercive field (alpha - beta) / 2 around hc and in the interaction field
+ * (alpha + beta) / 2 around zero. The table integrates it once over [-h_max, h_max]^2 and evaluates E by bilinear
+ * interpolation, E = 0 for alpha <= beta.
+ *
+ * Both axes are uniform in u = H / (|H| + h_scale) with h_scale = hc + sigma_c + sigma_u, so the nodes resolve the
+ * density peak of a few A/m while the plane still extends to h_max.
+ */
+class everett_table {
+public:
+
+    everett_table(const everett_table&)                    = delete;
+    everett_table(everett_table&&)                         = delete;
+    auto operator=(const everett_table&) -> everett_table& = delete;
+    auto operator=(everett_table&&) -> everett_table&      = delete;
+
+    explicit everett_table(const preisach_parameters& params);
+    ~everett_table() = default;
+
+    [[nodiscard]] auto parameters() const -> const preisach_parameters&;
+    [[nodiscard]] auto h_max() const -> real;
+
+    // alpha and beta must lie in [-h_max, h_max]
+    [[nodiscard]] auto evaluate(real alpha, real beta) const -> real;
+
+    static auto create(const preisach_parameters& params) -> std::shared_ptr<const everett_table>;
+
+protected:
+
+    [[nodiscard]] auto map_h(real h_am) const -> real;
+    [[nodiscard]] auto unmap_h(real u) const -> real;
+    [[nodiscard]] auto density(real alpha, real beta) const -> real;
+    [[nodiscard]] auto index(int ia, int ib) const -> std::size_t;
+
+private:
+
+    preisach_parameters _preisach;
+    real                _h_max;
+    real                _h_scale;
+    real                _u_max;
+    real                _inv_du;
+    int                 _nodes;
+    std::vector<real>   _values;  // row-major [i_alpha][i_beta]
+};
+
+}  // namespace aos
@@ -0,0 +1,351 @@
+#include "face_coefficient_table.hpp"
+
+#include "aos/components/spacecraft_face.hpp"
+#include "aos/core/types.hpp"
+
+#include <toml++/toml.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <numbers>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace aos {
+
+namespace {
+
+// [-] depth ties within this fraction of the bounding radius count as visible for the face being evaluated
+constexpr real depth_tolerance = 1e-9;
+
+}  // namespace
+
+void face_table_properties::from_toml(const toml_table& table) {
+    theta_nodes    = table["theta_nodes"].value_or(default_theta_nodes);
+    phi_nodes      = table["phi_nodes"].value_or(default_phi_nodes);
+    resolution     = table["resolution"].value_or(default_resolution);
+    self_shadowing = table["self_shadowing"].value_or(true);
+}
+
+void face_table_properties::debug_print() const {
+    std::cout << "--  spacecraft face table  --"          //
+              << "\n  theta nodes:    " << theta_nodes     //
+              << "\n  phi nodes:      " << phi_nodes       //
+              << "\n  resolution:     " << resolution      //
+              << "\n  self shadowing: " << self_shadowing  //
+              << '\n';
+}
+
+face_coefficient_table::face_coefficient_table(const spacecraft_face_list& faces, const face_table_properties& properties)
+    : _faces(faces),
+      _properties(properties),
+      _radius(0.0),
+      _d_theta(std::numbers::pi / (properties.theta_nodes - 1)),
+      _d_phi(2.0 * std::numbers::pi / properties.phi_nodes) {
+    if (_properties.theta_nodes < 2 || _properties.phi_nodes < 3) {
+        throw std::runtime_error("Face table needs at least 2 theta and 3 phi nodes");
+    }
+    if (_properties.resolution < 1) {
+        throw std::runtime_error("Face table 'resolution' must be positive");
+    }
+
+    // faces without an outline occlude as squares of their area
+    _outlines.reserve(_faces.size());
+    for (const auto& face : _faces) {
+        if (face.outline.size() >= 3) {
+            _outlines.push_back(face.outline);
+        } else {
+            const vec3& normal = face.surface_normal;
+            const vec3  t1     = normal.unitOrthogonal();
+            const vec3  t2     = normal.cross(t1);
+            const real  half   = 0.5 * std::sqrt(face.surface_area_m2);
+            const vec3& center = face.center_of_pressure_m;
+            _outlines.push_back({center - (half * t1) - (half * t2), center + (half * t1) - (half * t2), center + (half * t1) + (half * t2),
+                                 center - (half * t1) + (half * t2)});
+        }
+
+        for (const auto& vertex : _outlines.back()) {
+            _radius = std::max(_radius, vertex.norm());
+        }
+    }
+    _radius = std::max(_radius, std::numeric_limits<real>::min()) * (1.0 + 1e-9);  // NOLINT(readability-magic-numbers)
+
+    const auto num_theta = static_cast<std::size_t>(_properties.theta_nodes);
+    const auto num_phi   = static_cast<std::size_t>(_properties.phi_nodes);
+    _drag.resize(num_theta * num_phi);
+    _srp.resize(num_theta * num_phi);
+
+    raster            buffer;
+    std::vector<real> visible;
+    for (int it = 0; it < _properties.theta_nodes; ++it) {
+        const bool pole = it == 0 || it == _properties.theta_nodes - 1;
+        for (int ip = 0; ip < _properties.phi_nodes; ++ip) {
+            const auto index = (static_cast<std::size_t>(it) * num_phi) + static_cast<std::size_t>(ip);
+
+            // all phi nodes of a pole share one direction
+            if (pole && ip > 0) {
+                _drag[index] = _drag[index - 1];
+                _srp[index]  = _srp[index - 1];
+                continue;
+            }
+
+            const vec3 dir = node_direction(it, ip);
+
+            // air arrives from -flow_dir, light from sun_dir
+            compute_visibility(-dir, buffer, visible);
+            _drag[index] = direct_drag(dir, visible);
+
+            compute_visibility(dir, buffer, visible);
+            _srp[index] = direct_srp(dir, visible);
+        }
+    }
+
+    estimate_error(buffer, visible);
+}
+
+void face_coefficient_table::debug_print() const {
+    std::cout << "--  spacecraft face coefficient table  --"                                        //
+              << "\n  faces:          " << _faces.size()                                            //
+              << "\n  directions:     " << _properties.theta_nodes << 'x' << _properties.phi_nodes  //
+              << "\n  self shadowing: " << _properties.self_shadowing                               //
+              << "\n  max drag error: " << _error_drag                                              //
+              << "\n  max srp error:  " << _error_srp                                               //
+              << '\n';
+}
+
+auto face_coefficient_table::drag(const vec3& flow_dir) const -> face_drag_coefficients {
+    const drag_node node = interpolate(_drag, flow_dir);
+    return {
+        .force  = node(0),
+        .moment = node.tail<3>(),
+    };
+}
+
+auto face_coefficient_table::srp(const vec3& sun_dir) const -> face_srp_coefficients {
+    const srp_node node = interpolate(_srp, sun_dir);
+    return {
+        .force  = node.head<3>(),
+        .torque = node.tail<3>(),
+    };
+}
+
+auto face_coefficient_table::create(const spacecraft_face_list& faces, const face_table_properties& properties)
+    -> std::shared_ptr<const face_coefficient_table> {
+    return std::make_shared<const face_coefficient_table>(faces, properties);
+}
+
+auto face_coefficient_table::node_direction(int it, int ip) const -> vec3 {
+    const real theta = it * _d_theta;
+    const real phi   = ip * _d_phi;
+    return {std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta)};
+}
+
+template <typename node_type>
+auto face_coefficient_table::interpolate(const std::vector<node_type>& nodes, const vec3& dir) const -> node_type {
+    const real theta = std::acos(std::clamp(dir.z(), -1.0, 1.0));
+    real       phi   = std::atan2(dir.y(), dir.x());
+    if (phi < 0.0) {
+        phi += 2.0 * std::numbers::pi;
+    }
+
+    const real ft = theta / _d_theta;
+    const real fp = phi / _d_phi;
+    const int  it = std::clamp(static_cast<int>(ft), 0, _properties.theta_nodes - 2);
+    const int  ip = static_cast<int>(fp) % _properties.phi_nodes;
+    const real wt = ft - it;
+    const real wp = fp - std::floor(fp);
+
+    const auto num_phi = static_cast<std::size_t>(_properties.phi_nodes);
+    const auto row0    = static_cast<std::size_t>(it) * num_phi;
+    const auto row1    = row0 + num_phi;
+    const auto col0    = static_cast<std::size_t>(ip);
+    const auto col1    = static_cast<std::size_t>((ip + 1) % _properties.phi_nodes);
+
+    return ((1.0 - wt) * (((1.0 - wp) * nodes[row0 + col0]) + (wp * nodes[row0 + col1])))  //
+           + (wt * (((1.0 - wp) * nodes[row1 + col0]) + (wp * nodes[row1 + col1])));
+}
+
+void face_coefficient_table::compute_visibility(const vec3& toward_source, raster& buffer, std::vector<real>& visible) const {
+    const std::size_t num_faces = _faces.size();
+    visible.assign(num_faces, 1.0);
+    if (not _properties.self_shadowing) {
+        return;
+    }
+
+    // orthographic rays along -toward_source over the bounding sphere, depth = distance toward the source
+    const int  res   = _properties.resolution;
+    const real pixel = 2.0 * _radius / res;
+    const vec3 e1    = toward_source.unitOrthogonal();
+    const vec3 e2    = toward_source.cross(e1);
+
+    const auto num_pixels = static_cast<std::size_t>(res) * static_cast<std::size_t>(res);
+    buffer.depth.assign(num_pixels, -std::numeric_limits<real>::infinity());
+    buffer.stamp.assign(num_pixels, -1);
+    buffer.covered.assign(num_faces, 0);
+    buffer.visible.assign(num_faces, 0);
+
+    // calls visit(pixel, depth) for every ray that hits face i
+    auto rasterize = [&](std::size_t i, auto&& visit) {
+        const auto& outline = _outlines[i];
+
+        // fan triangulation around the first vertex
+        for (std::size_t k = 1; k + 1 < outline.size(); ++k) {
+            const vec3& a = outline[0];
+            const vec3& b = outline[k];
+            const vec3& c = outline[k + 1];
+
+            // pixel coordinates, pixel centers at integers
+            const real ax = ((a.dot(e1) + _radius) / pixel) - 0.5;
+            const real ay = ((a.dot(e2) + _radius) / pixel) - 0.5;
+            const real bx = ((b.dot(e1) + _radius) / pixel) - 0.5;
+            const real by = ((b.dot(e2) + _radius) / pixel) - 0.5;
+            const real cx = ((c.dot(e1) + _radius) / pixel) - 0.5;
+            const real cy = ((c.dot(e2) + _radius) / pixel) - 0.5;
+            const real az = a.dot(toward_source);
+            const real bz = b.dot(toward_source);
+            const real cz = c.dot(toward_source);
+
+            const real area = ((bx - ax) * (cy - ay)) - ((by - ay) * (cx - ax));
+            if (std::abs(area) <= std::numeric_limits<real>::epsilon()) {
+                continue;  // edge-on
+            }
+
+            const int x0 = std::max(0, static_cast<int>(std::ceil(std::min({ax, bx, cx}))));
+            const int x1 = std::min(res - 1, static_cast<int>(std::floor(std::max({ax, bx, cx}))));
+            const int y0 = std::max(0, static_cast<int>(std::ceil(std::min({ay, by, cy}))));
+            const int y1 = std::min(res - 1, static_cast<int>(std::floor(std::max({ay, by, cy}))));
+
+            for (int py = y0; py <= y1; ++py) {
+                for (int px = x0; px <= x1; ++px) {
+                    // barycentric weights, sign-independent of the projected winding
+                    const real wa = (((bx - px) * (cy - py)) - ((by - py) * (cx - px))) / area;
+                    const real wb = (((cx - px) * (ay - py)) - ((cy - py) * (ax - px))) / area;
+                    const real wc = 1.0 - wa - wb;
+                    if (wa < 0.0 || wb < 0.0 || wc < 0.0) {
+                        continue;
+                    }
+
+                    const auto pix = (static_cast<std::size_t>(py) * static_cast<std::size_t>(res)) + static_cast<std::size_t>(px);
+                    visit(pix, (wa * az) + (wb * bz) + (wc * cz));
+                }
+            }
+        }
+    };
+
+    // every face occludes, also when it faces away from the source
+    for (std::size_t i = 0; i < num_faces; ++i) {
+        rasterize(i, [&](std::size_t pix, real depth) { buffer.depth[pix] = std::max(buffer.depth[pix], depth); });
+    }
+
+    // a front face is hit by a ray unless another face lies strictly closer to the source, so coincident faces (both
+    // sides of a panel) and shared edges are not lost to rasterization order
+    const real tie = depth_tolerance * _radius;
+    for (std::size_t i = 0; i < num_faces; ++i) {
+        if (_faces[i].surface_normal.dot(toward_source) <= 0.0) {
+            continue;
+        }
+
+        rasterize(i, [&](std::size_t pix, real depth) {
+            if (buffer.stamp[pix] == static_cast<int>(i)) {
+                return;  // pixel on an inner edge of the fan
+            }
+            buffer.stamp[pix] = static_cast<int>(i);
+            ++buffer.covered[i];
+            if (depth >= buffer.depth[pix] - tie) {
+                ++buffer.visible[i];
+            }
+        });
+    }
+
+    for (std::size_t i = 0; i < num_faces; ++i) {
+        if (buffer.covered[i] > 0) {
+            visible[i] = static_cast<real>(buffer.visible[i]) / static_cast<real>(buffer.covered[i]);
+            continue;
+        }
+
+        // face smaller than a ray spacing: test its center against the depth of its pixel
+        const vec3& center = _faces[i].center_of_pressure_m;
+        const int   px     = std::clamp(static_cast<int>((center.dot(e1) + _radius) / pixel), 0, res - 1);
+        const int   py     = std::clamp(static_cast<int>((center.dot(e2) + _radius) / pixel), 0, res - 1);
+        const auto  pix    = (static_cast<std::size_t>(py) * static_cast<std::size_t>(res)) + static_cast<std::size_t>(px);
+        visible[i]         = buffer.depth[pix] <= center.dot(toward_source) + pixel ? 1.0 : 0.0;
+    }
+}
+
+auto face_coefficient_table::direct_drag(const vec3& flow_dir, const std::vector<real>& visible) const -> drag_node {
+    real force  = 0.0;
+    vec3 moment = vec3::Zero();
+    for (std::size_t i = 0; i < _faces.size(); ++i) {
+        const auto& face      = _faces[i];
+        const real  cos_theta = -face.surface_normal.dot(flow_dir);
+        if (cos_theta <= 0.0) {
+            continue;
+        }
+
+        const real k = 0.5 * face.drag_coefficient * face.surface_area_m2 * cos_theta * visible[i];
+        force += k;
+        moment += k * face.center_of_pressure_m;
+    }
+
+    drag_node node;
+    node << force, moment;
+    return node;
+}
+
+auto face_coefficient_table::direct_srp(const vec3& sun_dir, const std::vector<real>& visible) const -> srp_node {
+    vec3 force  = vec3::Zero();
+    vec3 torque = vec3::Zero();
+    for (std::size_t i = 0; i < _faces.size(); ++i) {
+        const auto& face      = _faces[i];
+        const real  cos_alpha = face.surface_normal.dot(sun_dir);
+        if (cos_alpha <= 0.0) {
+            continue;
+        }
+
+        // same split as spacecraft_face::compute_force_srp_body
+        const real scalar        = face.surface_area_m2 * cos_alpha * visible[i];
+        const real normal_scalar = scalar * (2.0 * face.specular_reflection_coefficient * cos_alpha + (2.0 / 3.0) * face.diffuse_reflection_coefficient);
+        const vec3 f             = (-sun_dir * scalar * (1.0 - face.specular_reflection_coefficient)) - (face.surface_normal * normal_scalar);
+        force += f;
+        torque += face.center_of_pressure_m.cross(f);
+    }
+
+    srp_node node;
+    node << force, torque;
+    return node;
+}
+
+void face_coefficient_table::estimate_error(raster& buffer, std::vector<real>& visible) {
+    constexpr int samples = 256;
+
+    // scales: largest force, and largest force times the body radius for moments and torques
+    real drag_scale = std::numeric_limits<real>::min();
+    real srp_scale  = std::numeric_limits<real>::min();
+    for (const auto& node : _drag) {
+        drag_scale = std::max(drag_scale, std::abs(node(0)));
+    }
+    for (const auto& node : _srp) {
+        srp_scale = std::max(srp_scale, node.head<3>().norm());
+    }
+
+    std::mt19937                   generator(1);
+    std::normal_distribution<real> normal;
+    for (int n = 0; n < samples; ++n) {
+        const vec3 dir = vec3(normal(generator), normal(generator), normal(generator)).normalized();
+
+        compute_visibility(-dir, buffer, visible);
+        const drag_node drag = direct_drag(dir, visible) - interpolate(_drag, dir);
+        _error_drag          = std::max({_error_drag, std::abs(drag(0)) / drag_scale, drag.tail<3>().norm() / (drag_scale * _radius)});
+
+        compute_visibility(dir, buffer, visible);
+        const srp_node srp = direct_srp(dir, visible) - interpolate(_srp, dir);
+        _error_srp         = std::max({_error_srp, srp.head<3>().norm() / srp_scale, srp.tail<3>().norm() / (srp_scale * _radius)});
+    }
+}
+
+}  // namespace aos
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "aos/components/spacecraft_face.hpp"
+#include "aos/core/types.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace aos {
+
+struct face_table_properties {
+    static constexpr int default_theta_nodes = 91;   // 2 deg
+    static constexpr int default_phi_nodes   = 180;  // 2 deg
+    static constexpr int default_resolution  = 64;
+
+    int  theta_nodes{default_theta_nodes};  // [-] Grid nodes from +z to -z (inclusive)
+    int  phi_nodes{default_phi_nodes};      // [-] Grid nodes around z (periodic)
+    int  resolution{default_resolution};    // [-] Rays per side of the shadowing raster
+    bool self_shadowing{true};              // [-] Cast rays for occlusion between faces
+
+    void from_toml(const toml_table& table);
+    void debug_print() const;
+
+    auto operator==(const face_table_properties&) const -> bool = default;
+};
+
+// drag: F = rho * |v|^2 * force * v_hat, T = rho * |v|^2 * moment x v_hat
+struct face_drag_coefficients {
+    real force;   //!< [m^2] Sum of 0.5 * Cd * A * cos(theta) over visible faces
+    vec3 moment;  //!< [m^3] Sum of the same terms weighted by the center of pressure
+};
+
+// srp: F = P * shadow * force, T = P * shadow * torque
+struct face_srp_coefficients {
+    vec3 force;   //!< [m^2] Force per unit radiation pressure
+    vec3 torque;  //!< [m^3] Torque per unit radiation pressure
+};
+
+/**
+ * @brief Body-frame drag and SRP coefficients of a face set, tabulated over directions.
+ *
+ * For a fixed geometry the drag force and torque depend only on the flow direction (up to rho * |v|^2), and the SRP
+ * force and torque only on the Sun direction (up to P * shadow). The table evaluates both on a latitude-longitude grid
+ * of unit directions and interpolates bilinearly, so a lookup costs the same for 6 or 600 faces. The rotational part
+ * of the flow velocity (omega x r) is neglected.
+ *
+ * Self-shadowing: for every grid direction a square grid of parallel rays is cast toward the faces (a depth buffer over
+ * the bounding sphere), the visible fraction of a face is the share of its rays that no other face intercepts closer to
+ * the source. Depth ties (both sides of a panel, shared edges) go to the face being evaluated. Faces without an outline
+ * are treated as squares of their area. Back-facing faces receive no flux but still occlude.
+ *
+ * The interpolation error is estimated at build time against direct evaluation in random directions and reported by
+ * debug_print().
+ */
+class face_coefficient_table {
+public:
+
+    face_coefficient_table(const face_coefficient_table&)                    = delete;
+    face_coefficient_table(face_coefficient_table&&)                         = delete;
+    auto operator=(const face_coefficient_table&) -> face_coefficient_table& = delete;
+    auto operator=(face_coefficient_table&&) -> face_coefficient_table&      = delete;
+
+    face_coefficient_table(const spacecraft_face_list& faces, const face_table_properties& properties);
+    ~face_coefficient_table() = default;
+
+    // flow_dir: unit air velocity relative to the spacecraft in body frame
+    [[nodiscard]] auto drag(const vec3& flow_dir) const -> face_drag_coefficients;
+
+    // sun_dir: unit direction to the Sun in body frame
+    [[nodiscard]] auto srp(const vec3& sun_dir) const -> face_srp_coefficients;
+
+    void debug_print() const;
+
+    static auto create(const spacecraft_face_list& faces, const face_table_properties& properties) -> std::shared_ptr<const face_coefficient_table>;
+
+protected:
+
+    using drag_node = Eigen::Matrix<real, 4, 1>;  // force, moment
+    using srp_node  = Eigen::Matrix<real, 6, 1>;  // force, torque
+
+    struct raster {
+        std::vector<real>        depth;    // closest face along each ray, front or back facing
+        std::vector<int>         stamp;    // last face counted at each pixel
+        std::vector<std::size_t> covered;  // rays per front face
+        std::vector<std::size_t> visible;  // rays per front face that reach it first
+    };
+
+    [[nodiscard]] auto node_direction(int it, int ip) const -> vec3;
+
+    template <typename node_type>
+    [[nodiscard]] auto interpolate(const std::vector<node_type>& nodes, const vec3& dir) const -> node_type;
+
+    // visible fraction of every face for light or flow arriving from toward_source
+    void compute_visibility(const vec3& toward_source, raster& buffer, std::vector<real>& visible) const;
+
+    [[nodiscard]] auto direct_drag(const vec3& flow_dir, const std::vector<real>& visible) const -> drag_node;
+    [[nodiscard]] auto direct_srp(const vec3& sun_dir, const std::vector<real>& visible) const -> srp_node;
+
+    void estimate_error(raster& buffer, std::vector<real>& visible);
+
+private:
+
+    spacecraft_face_list           _faces;
+    std::vector<std::vector<vec3>> _outlines;  // explicit or synthesized, counter-clockwise around the normal
+    face_table_properties          _properties;
+    real                           _radius;  // [m] bounding sphere around the body origin
+    real                           _d_theta;
+    real                           _d_phi;
+    std::vector<drag_node>         _drag;  // row-major [theta][phi]
+    std::vector<srp_node>          _srp;
+    real                           _error_drag{};
+    real                           _error_srp{};
+};
+
+}  // namespace aos
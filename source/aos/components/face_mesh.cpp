@@ -0,0 +1,205 @@
+#include "face_mesh.hpp"
+
+#include "aos/components/spacecraft_face.hpp"
+#include "aos/core/constants.hpp"
+#include "aos/core/types.hpp"
+
+#include <toml++/toml.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <istream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace aos {
+
+void face_mesh_properties::from_toml(const toml_table& table) {
+    path                            = table["path"].value_or<std::string>("");
+    scale                           = table["scale"].value_or(1.0);
+    drag_coefficient                = table["drag_coefficient"].value_or(default_drag_coefficient);
+    specular_reflection_coefficient = table["specular_reflection_coefficient"].value_or(0.0);
+    diffuse_reflection_coefficient  = table["diffuse_reflection_coefficient"].value_or(0.0);
+}
+
+void face_mesh_properties::debug_print() const {
+    std::cout << "--  spacecraft face mesh  --"                                              //
+              << "\n  path:                            " << path                             //
+              << "\n  scale:                           " << scale                            //
+              << "\n  drag coefficient:                " << drag_coefficient                 //
+              << "\n  specular reflection coefficient: " << specular_reflection_coefficient  //
+              << "\n  diffuse reflection coefficient:  " << diffuse_reflection_coefficient   //
+              << '\n';
+}
+
+auto face_mesh_properties::load() const -> spacecraft_face_list {
+    auto faces = face_mesh_parser::parse(path);
+    for (auto& face : faces) {
+        face.center_of_pressure_m *= scale;
+        face.surface_area_m2 *= scale * scale;
+        for (auto& vertex : face.outline) {
+            vertex *= scale;
+        }
+        face.drag_coefficient                = drag_coefficient;
+        face.specular_reflection_coefficient = specular_reflection_coefficient;
+        face.diffuse_reflection_coefficient  = diffuse_reflection_coefficient;
+    }
+    return faces;
+}
+
+auto face_mesh_parser::parse(const std::filesystem::path& filepath) -> spacecraft_face_list {
+    std::ifstream file(filepath, std::ios::binary);
+    if (not file.is_open()) {
+        throw std::runtime_error("could not open face mesh file: " + filepath.string());
+    }
+
+    spacecraft_face_list faces;
+    if (filepath.extension() == ".obj") {
+        faces = parse_obj(file);
+    } else if (filepath.extension() == ".stl") {
+        // binary STL: 80 byte header, uint32 count, 50 bytes per triangle; ascii files may also start with "solid"
+        constexpr std::size_t header_size   = 80;
+        constexpr std::size_t triangle_size = 50;
+
+        std::array<char, header_size> header{};
+        std::uint32_t                 count = 0;
+        file.read(header.data(), header.size());
+        file.read(reinterpret_cast<char*>(&count), sizeof(count));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+        const auto size = std::filesystem::file_size(filepath);
+        if (file && size == header_size + sizeof(count) + (triangle_size * count)) {
+            faces = parse_stl_binary(file, count);
+        } else {
+            file.clear();
+            file.seekg(0);
+            faces = parse_stl_ascii(file);
+        }
+    } else {
+        throw std::runtime_error("unsupported face mesh format (expected .obj or .stl): " + filepath.string());
+    }
+
+    if (faces.empty()) {
+        throw std::runtime_error("face mesh has no facets: " + filepath.string());
+    }
+    return faces;
+}
+
+auto face_mesh_parser::parse_obj(std::istream& stream) -> spacecraft_face_list {
+    spacecraft_face_list faces;
+    std::vector<vec3>    vertices;
+    std::vector<vec3>    polygon;
+
+    std::string line;
+    while (std::getline(stream, line)) {
+        std::istringstream tokens(line);
+        std::string        keyword;
+        tokens >> keyword;
+
+        if (keyword == "v") {
+            vec3 vertex;
+            if (not(tokens >> vertex.x() >> vertex.y() >> vertex.z())) {
+                throw std::runtime_error("face mesh OBJ has a malformed vertex: " + line);
+            }
+            vertices.push_back(vertex);
+        } else if (keyword == "f") {
+            polygon.clear();
+
+            // "i", "i/t", "i//n" or "i/t/n", negative indices count from the last vertex
+            std::string corner;
+            while (tokens >> corner) {
+                const long index    = std::stol(corner.substr(0, corner.find('/')));
+                const long resolved = index < 0 ? static_cast<long>(vertices.size()) + index : index - 1;
+                if (resolved < 0 || resolved >= static_cast<long>(vertices.size())) {
+                    throw std::runtime_error("face mesh OBJ references a missing vertex: " + line);
+                }
+                polygon.push_back(vertices[static_cast<std::size_t>(resolved)]);
+            }
+            add_polygon(faces, polygon);
+        }
+    }
+    return faces;
+}
+
+auto face_mesh_parser::parse_stl_ascii(std::istream& stream) -> spacecraft_face_list {
+    spacecraft_face_list faces;
+    std::vector<vec3>    polygon;
+
+    std::string keyword;
+    while (stream >> keyword) {
+        if (keyword == "vertex") {
+            vec3 vertex;
+            if (not(stream >> vertex.x() >> vertex.y() >> vertex.z())) {
+                throw std::runtime_error("face mesh STL has a malformed vertex");
+            }
+            polygon.push_back(vertex);
+        } else if (keyword == "endloop") {
+            add_polygon(faces, polygon);
+            polygon.clear();
+        }
+    }
+    return faces;
+}
+
+auto face_mesh_parser::parse_stl_binary(std::istream& stream, std::uint32_t count) -> spacecraft_face_list {
+    // normal (3 float), 3 vertices (3 float each), uint16 attribute
+    constexpr std::size_t floats_per_triangle = 12;
+    constexpr std::size_t attribute_size      = 2;
+
+    spacecraft_face_list faces;
+    faces.reserve(count);
+
+    std::vector<vec3> polygon(3);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        std::array<float, floats_per_triangle> values{};
+        std::array<char, attribute_size>       attribute{};
+        stream.read(reinterpret_cast<char*>(values.data()), sizeof(values));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        stream.read(attribute.data(), attribute.size());
+        if (not stream) {
+            throw std::runtime_error("face mesh STL is truncated");
+        }
+
+        for (std::size_t v = 0; v < 3; ++v) {
+            polygon[v] = vec3(values[3 + (3 * v)], values[4 + (3 * v)], values[5 + (3 * v)]);
+        }
+        add_polygon(faces, polygon);
+    }
+    return faces;
+}
+
+void face_mesh_parser::add_polygon(spacecraft_face_list& faces, const std::vector<vec3>& polygon) {
+    if (polygon.size() < 3) {
+        return;
+    }
+
+    // fan triangulation around the first vertex: sum of the doubled area vectors and area-weighted centroids
+    vec3 area_vector = vec3::Zero();
+    vec3 moment      = vec3::Zero();
+    real weight      = 0.0;
+    for (std::size_t i = 1; i + 1 < polygon.size(); ++i) {
+        const vec3 cross = (polygon[i] - polygon[0]).cross(polygon[i + 1] - polygon[0]);
+        area_vector += cross;
+        weight += cross.norm();
+        moment += cross.norm() * (polygon[0] + polygon[i] + polygon[i + 1]) / 3.0;
+    }
+
+    const real doubled_area = area_vector.norm();
+    if (doubled_area <= 0.0) {
+        return;
+    }
+
+    spacecraft_face face;
+    face.surface_normal       = area_vector / doubled_area;
+    face.surface_area_m2      = 0.5 * doubled_area;
+    face.center_of_pressure_m = moment / weight;
+    face.outline              = polygon;
+    faces.push_back(face);
+}
+
+}  // namespace aos
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "aos/components/spacecraft_face.hpp"
+#include "aos/core/constants.hpp"
+#include "aos/core/types.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace aos {
+
+struct face_mesh_properties {
+    std::string path;                                        //!< OBJ or STL (ascii / binary) file
+    real        scale{1.0};                                  //!< [-] Vertex scale, e.g. 0.001 for meshes in millimeters
+    real        drag_coefficient{default_drag_coefficient};  //!< [-] Drag coefficient of every facet
+    real        specular_reflection_coefficient{};           //!< [-] Specular reflection coefficient (0..1)
+    real        diffuse_reflection_coefficient{};            //!< [-] Diffuse reflection coefficient (0..1)
+
+    void from_toml(const toml_table& table);
+    void debug_print() const;
+
+    // load the facets with these surface properties
+    [[nodiscard]] auto load() const -> spacecraft_face_list;
+};
+
+/**
+ * @brief Reads facet geometry from a mesh file.
+ *
+ * Each OBJ polygon or STL triangle becomes one face: area and outward normal from the vertex winding (counter-clockwise
+ * seen from outside), center of pressure at the area centroid. Vertices are taken in the body frame. Degenerate facets
+ * are skipped.
+ */
+class face_mesh_parser {
+public:
+
+    static auto parse(const std::filesystem::path& filepath) -> spacecraft_face_list;
+
+protected:
+
+    static auto parse_obj(std::istream& stream) -> spacecraft_face_list;
+    static auto parse_stl_ascii(std::istream& stream) -> spacecraft_face_list;
+    static auto parse_stl_binary(std::istream& stream, std::uint32_t count) -> spacecraft_face_list;
+
+    // append the facet spanned by the polygon, if it is not degenerate
+    static void add_polygon(spacecraft_face_list& faces, const std::vector<vec3>& polygon);
+};
+
+}  // namespace aos
@@ -1,6 +1,8 @@
 #include "hysteresis_rod.hpp"
 
+#include "aos/components/hysteresis_table.hpp"
 #include "aos/core/constants.hpp"
+#include "aos/core/langevin.hpp"
 #include "aos/core/types.hpp"
 
 #include <toml++/toml.hpp>
@@ -9,28 +11,90 @@
 #include <cassert>
 #include <cmath>
 #include <iostream>
+#include <memory>
 #include <stdexcept>
+#include <string>
+#include <utility>
 
 namespace aos {
 
+void hysteresis_table_properties::from_toml(const toml_table& table) {
+    h_max_am = table["h_max"].value_or(default_h_max);
+    nodes    = table["nodes"].value_or(default_nodes);
+}
+
+void hysteresis_table_properties::debug_print() const {
+    std::cout << "-- hysteresis table properties --"  //
+              << "\n  H max: " << h_max_am           //
+              << "\n  nodes: " << nodes              //
+              << '\n';
+}
+
 void hysteresis_parameters::from_toml(const toml_table& table) {
     ms    = table["ms"].value_or(0.0);
     a     = table["a"].value_or(0.0);
     k     = table["k"].value_or(0.0);
     c     = table["c"].value_or(0.0);
     alpha = table["alpha"].value_or(0.0);
+
+    if (const auto name = table["langevin"].value<std::string>()) {
+        langevin = langevin_evaluator_from_string(*name);
+    }
+
+    if (const auto* tab = table["table"].as_table()) {
+        this->table.emplace().from_toml(*tab);
+    }
 }
 
 void hysteresis_parameters::debug_print() const {
-    std::cout << "-- hysteresis properties --"     //
-              << "\n  Ms (Saturation): " << ms     //
-              << "\n  a (Shape):       " << a      //
-              << "\n  k (Coercivity):  " << k      //
-              << "\n  c (Reversible):  " << c      //
-              << "\n  alpha (Coupling):" << alpha  //
+    std::cout << "-- hysteresis properties --"                                      //
+              << "\n  Ms (Saturation): " << ms                                      //
+              << "\n  a (Shape):       " << a                                       //
+              << "\n  k (Coercivity):  " << k                                       //
+              << "\n  c (Reversible):  " << c                                       //
+              << "\n  alpha (Coupling):" << alpha                                   //
+              << "\n  langevin:        " << langevin_evaluator_to_string(langevin)  //
+              << '\n';
+
+    if (table) {
+        table->debug_print();
+        hysteresis_table::create(*this)->debug_print();  // built table with its interpolation error
+    }
+}
+
+void preisach_parameters::from_toml(const toml_table& table) {
+    const auto defaults = hymu80();
+
+    ms       = table["ms"].value_or(defaults.ms);
+    hc       = table["hc"].value_or(defaults.hc);
+    sigma_c  = table["sigma_c"].value_or(defaults.sigma_c);
+    sigma_u  = table["sigma_u"].value_or(defaults.sigma_u);
+    h_max_am = table["h_max"].value_or(default_h_max);
+    nodes    = table["nodes"].value_or(default_nodes);
+}
+
+void preisach_parameters::debug_print() const {
+    std::cout << "-- preisach properties --"             //
+              << "\n  Ms (Saturation):    " << ms        //
+              << "\n  Hc (Coercivity):    " << hc        //
+              << "\n  sigma_c (Spread):   " << sigma_c   //
+              << "\n  sigma_u (Coupling): " << sigma_u   //
+              << "\n  H max:              " << h_max_am  //
+              << "\n  nodes:              " << nodes     //
               << '\n';
 }
 
+auto preisach_parameters::hymu80() -> preisach_parameters {
+    // NOLINTBEGIN(readability-magic-numbers)
+    return {
+        .ms      = 6.0e5,  // same saturation as the J-A HyMu-80 set
+        .hc      = 1.6,    // ~0.02 Oe
+        .sigma_c = 0.8,
+        .sigma_u = 2.0,
+    };
+    // NOLINTEND(readability-magic-numbers)
+}
+
 void hysteresis_rod_properties::from_toml(const toml_table& table) {
     volume_m3 = table["volume"].value_or(0.0);
 
@@ -44,6 +108,10 @@ void hysteresis_rod_properties::from_toml(const toml_table& table) {
     if (const auto* hyst = table["hysteresis"].as_table()) {
         hysteresis.emplace().from_toml(*hyst);
     }
+
+    if (const auto* model = table["preisach"].as_table()) {
+        preisach.emplace().from_toml(*model);
+    }
 }
 
 void hysteresis_rod_properties::debug_print() const {
@@ -55,6 +123,10 @@ void hysteresis_rod_properties::debug_print() const {
     if (hysteresis) {
         hysteresis->debug_print();
     }
+
+    if (preisach) {
+        preisach->debug_print();
+    }
 }
 
 auto hysteresis_parameters::hymu80() -> hysteresis_parameters {
@@ -96,24 +168,26 @@ auto hysteresis_rod::hysteresis() const noexcept -> const hysteresis_parameters&
     return _hysteresis;
 }
 
+void hysteresis_rod::attach_table(std::shared_ptr<const hysteresis_table> table) {
+    if (table && table->parameters() != _hysteresis) {
+        throw std::runtime_error("Hysteresis table was built for different parameters");
+    }
+    _table = std::move(table);
+}
+
 auto hysteresis_rod::calculate_h_eff(real h_along_rod, real m_val) const -> real {
     // H_eff = H + alpha * M
     return h_along_rod + (_hysteresis.alpha * m_val);
 }
 
 auto hysteresis_rod::calculate_anhysteretic(real h_eff_am) const -> real {
-    const real ratio = h_eff_am / _hysteresis.a;
-
-    // numerical stability for langevin function near zero
-    if (std::abs(ratio) < epsilon_langevin) {
-        // taylor expansion: L(x) approx x/3 - x^3/45
-        return _hysteresis.ms * (ratio / 3.0);  // NOLINT(readability-magic-numbers)
-        // - (ratio*ratio*ratio)/45.0;
+    if (_table && _table->contains(h_eff_am)) {
+        return _table->anhysteretic(h_eff_am);
     }
 
     // langevin: L(x) = coth(x) - 1/x
     // M_an = Ms * L(x)
-    return _hysteresis.ms * ((1.0 / std::tanh(ratio)) - (1.0 / ratio));
+    return _hysteresis.ms * langevin(h_eff_am / _hysteresis.a, _hysteresis.langevin);
 }
 
 auto hysteresis_rod::magnetic_moment(real m_irr_am, const vec3& b_body_t) const -> vec3 {
@@ -145,26 +219,50 @@ auto hysteresis_rod::magnetization_derivative(real m_irr_am, const vec3& b_body_
 
 // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
 auto hysteresis_rod::magnetization_derivative(real m_irr_am, real h_along_rod, real dh_dt) const -> real {
+    if (is_magnetization_locked(m_irr_am, dh_dt)) {
+        return 0.0;
+    }
+
+    const real m_irr_clamped = std::clamp(m_irr_am, -_hysteresis.ms, _hysteresis.ms);
+    const real h_eff         = calculate_h_eff(h_along_rod, m_irr_clamped);
+    const real m_an          = calculate_anhysteretic(h_eff);
+    return calculate_irreversible_derivative(m_irr_clamped, m_an, dh_dt);
+}
+
+auto hysteresis_rod::compute_effects(real m_irr_am, const vec3& b_body_t, const vec3& b_dot_body_t) const -> hysteresis_rod_effects {
+    // shared intermediates of magnetic_moment() and magnetization_derivative()
+    const real h_applied     = b_body_t.dot(_orientation_body) / vacuum_permeability;
+    const real dh_dt         = b_dot_body_t.dot(_orientation_body) / vacuum_permeability;
+    const real m_irr_clamped = std::clamp(m_irr_am, -_hysteresis.ms, _hysteresis.ms);
+    const real h_eff         = calculate_h_eff(h_applied, m_irr_clamped);
+    const real m_an          = calculate_anhysteretic(h_eff);
+    const real m_total       = ((1.0 - _hysteresis.c) * m_irr_clamped) + (_hysteresis.c * m_an);
+
+    return {
+        .magnetic_moment          = m_total * _volume * _orientation_body,
+        .magnetization_derivative = is_magnetization_locked(m_irr_am, dh_dt) ? 0.0 : calculate_irreversible_derivative(m_irr_clamped, m_an, dh_dt),
+    };
+}
+
+auto hysteresis_rod::is_magnetization_locked(real m_irr_am, real dh_dt) const -> bool {
     // If saturated and driving further into saturation, no change possible.
     if (m_irr_am >= _hysteresis.ms && dh_dt > 0.0) {
-        return 0.0;
+        return true;
     }
     if (m_irr_am <= -_hysteresis.ms && dh_dt < 0.0) {
-        return 0.0;
+        return true;
     }
 
     // Skip calculation if field change is negligible (Static field)
-    if (std::abs(dh_dt) < epsilon_dh_dt) {
-        return 0.0;
-    }
+    return std::abs(dh_dt) < epsilon_dh_dt;
+}
 
-    const real m_irr_clamped = std::clamp(m_irr_am, -_hysteresis.ms, _hysteresis.ms);
-    const real h_eff         = calculate_h_eff(h_along_rod, m_irr_clamped);
-    const real m_an          = calculate_anhysteretic(h_eff);
-    const real delta         = (dh_dt > 0.0) ? 1.0 : -1.0;
-    const real numerator     = m_an - m_irr_clamped;
-    const real denominator   = (_hysteresis.k * delta) - (_hysteresis.alpha * numerator);
-    const real max_chi       = _hysteresis.ms / std::max(_hysteresis.k, min_k_value);
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+auto hysteresis_rod::calculate_irreversible_derivative(real m_irr_clamped, real m_an, real dh_dt) const -> real {
+    const real delta       = (dh_dt > 0.0) ? 1.0 : -1.0;
+    const real numerator   = m_an - m_irr_clamped;
+    const real denominator = (_hysteresis.k * delta) - (_hysteresis.alpha * numerator);
+    const real max_chi     = _hysteresis.ms / std::max(_hysteresis.k, min_k_value);
 
     real dmirr_dh = 0.0;
     if (std::abs(denominator) < epsilon_denominator) {
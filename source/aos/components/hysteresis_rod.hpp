@@ -1,11 +1,28 @@
 #pragma once
 
+#include "aos/core/langevin.hpp"
 #include "aos/core/types.hpp"
 
+#include <memory>
 #include <optional>
 
 namespace aos {
 
+class hysteresis_table;
+
+struct hysteresis_table_properties {
+    static constexpr real default_h_max = 200.0;  // [A/m] ~4x the strongest geomagnetic field in LEO
+    static constexpr int  default_nodes = 4097;
+
+    real h_max_am{default_h_max};  // [A/m] Table covers |H_eff| <= h_max + alpha * Ms, outside falls back to direct evaluation
+    int  nodes{default_nodes};     // [-] Grid nodes along H_eff (non-uniform, dense around H_eff = 0)
+
+    void from_toml(const toml_table& table);
+    void debug_print() const;
+
+    auto operator==(const hysteresis_table_properties&) const -> bool = default;
+};
+
 struct hysteresis_parameters {
     real ms;     // [A/m] Saturation Magnetization
     real a;      // [A/m] Anhysteretic shape parameter
@@ -13,17 +30,50 @@ struct hysteresis_parameters {
     real c;      // [-] Reversibility coefficient (0..1)
     real alpha;  // [-] Inter-domain coupling coefficient
 
+    langevin_evaluator langevin{langevin_evaluator_exact};  // Langevin function implementation used for M_an ("fast" is opt-in)
+
+    // [optional] precomputed response table, shared by all rods of this material
+    std::optional<hysteresis_table_properties> table{};
+
     void from_toml(const toml_table& table);
     void debug_print() const;
 
+    auto operator==(const hysteresis_parameters&) const -> bool = default;
+
     static auto hymu80() -> hysteresis_parameters;
 };
 
+struct preisach_parameters {
+    static constexpr real default_h_max = 200.0;  // [A/m] ~4x the strongest geomagnetic field in LEO
+    static constexpr int  default_nodes = 513;
+
+    real ms;                       // [A/m] Saturation Magnetization
+    real hc;                       // [A/m] Peak of the hysteron coercivity distribution
+    real sigma_c;                  // [A/m] Half-width of the coercivity distribution
+    real sigma_u;                  // [A/m] Half-width of the interaction field distribution
+    real h_max_am{default_h_max};  // [A/m] Extent of the Preisach plane, fields beyond saturate the rod
+    int  nodes{default_nodes};     // [-] Everett table nodes per axis (non-uniform, dense around H = 0)
+
+    void from_toml(const toml_table& table);
+    void debug_print() const;
+
+    auto operator==(const preisach_parameters&) const -> bool = default;
+
+    static auto hymu80() -> preisach_parameters;
+};
+
+struct hysteresis_rod_effects {
+    vec3 magnetic_moment;           //!< [A*m^2] Total magnetic dipole moment
+    real magnetization_derivative;  //!< [A/m/s] Rate of change of irreversible magnetization
+};
+
 struct hysteresis_rod_properties {
     real volume_m3;
     vec3 orientation;
     // [optional] custom hysteresis for this rod
     std::optional<hysteresis_parameters> hysteresis;
+    // [optional] use the Preisach model instead of Jiles-Atherton for this rod
+    std::optional<preisach_parameters> preisach{};
 
     void from_toml(const toml_table& table);
     void debug_print() const;
@@ -33,8 +83,7 @@ class hysteresis_rod {
 public:
 
     // Stability thresholds
-    static constexpr real epsilon_langevin = 1e-6;
-    static constexpr real epsilon_vector   = 1e-12;
+    static constexpr real epsilon_vector = 1e-12;
     // Threshold below which dh/dt is treated as static
     static constexpr real epsilon_dh_dt = 1e-9;
     // Threshold for singularity (denominator -> 0)
@@ -49,6 +98,9 @@ public:
 
     [[nodiscard]] auto hysteresis() const noexcept -> const hysteresis_parameters&;
 
+    // use a precomputed response table (built for the same hysteresis parameters) for M_an where it covers H_eff
+    void attach_table(std::shared_ptr<const hysteresis_table> table);
+
     /**
      * @brief Calculates the TOTAL magnetic dipole moment (Irreversible + Reversible).
      *
@@ -83,11 +135,23 @@ public:
      */
     [[nodiscard]] auto magnetization_derivative(real m_irr_am, real h_along_rod, real dh_dt) const -> real;
 
+    /**
+     * @brief Calculates the magnetic moment and dM_irr/dt in a single pass.
+     *
+     * Equivalent to calling magnetic_moment() and magnetization_derivative(), but H, H_eff and M_an are evaluated only once.
+     *
+     * @param m_irr_am Current scalar irreversible magnetization [A/m].
+     * @param b_body_t Current magnetic field in the body frame [T].
+     * @param b_dot_body_t Rate of change of the magnetic field in the body frame [T/s].
+     */
+    [[nodiscard]] auto compute_effects(real m_irr_am, const vec3& b_body_t, const vec3& b_dot_body_t) const -> hysteresis_rod_effects;
+
 protected:
 
     /**
      * @brief Computes the Anhysteretic Magnetization M_an(H_eff).
-     * Uses the Langevin function: M_an = Ms * (coth(Heff/a) - a/Heff)
+     * Uses the Langevin function: M_an = Ms * (coth(Heff/a) - a/Heff), evaluated by the configured langevin_evaluator,
+     * or interpolated from the attached hysteresis_table.
      */
     [[nodiscard]] auto calculate_anhysteretic(real h_eff_am) const -> real;
 
@@ -96,11 +160,26 @@ protected:
      */
     [[nodiscard]] auto calculate_h_eff(real h_along_rod, real m_val) const -> real;
 
+    /**
+     * @brief Checks whether M_irr cannot change (saturated in the driving direction, or static field).
+     */
+    [[nodiscard]] auto is_magnetization_locked(real m_irr_am, real dh_dt) const -> bool;
+
+    /**
+     * @brief Solves the Jiles-Atherton equation for an already evaluated M_an.
+     *
+     * @param m_irr_clamped Irreversible magnetization clamped to [-Ms, Ms] [A/m].
+     * @param m_an Anhysteretic magnetization at H_eff [A/m].
+     * @param dh_dt Rate of change of H-field [A/m/s].
+     */
+    [[nodiscard]] auto calculate_irreversible_derivative(real m_irr_clamped, real m_an, real dh_dt) const -> real;
+
 private:
 
-    real                  _volume;
-    vec3                  _orientation_body;
-    hysteresis_parameters _hysteresis;
+    real                                    _volume;
+    vec3                                    _orientation_body;
+    hysteresis_parameters                   _hysteresis;
+    std::shared_ptr<const hysteresis_table> _table;
 };
 
 }  // namespace aos
@@ -1,45 +1,132 @@
 #include "hysteresis_rods.hpp"
 
+#include "aos/components/everett_table.hpp"
 #include "aos/components/hysteresis_rod.hpp"
+#include "aos/components/hysteresis_table.hpp"
+#include "aos/components/preisach_rod.hpp"
+#include "aos/components/table_cache.hpp"
 #include "aos/core/types.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <memory>
 #include <span>
 #include <vector>
 
 namespace aos {
 
-hysteresis_rods::hysteresis_rods(const hysteresis_rods_properties& properties, const hysteresis_parameters& params) {
-    _rods.reserve(properties.size());
+hysteresis_rods::hysteresis_rods(const hysteresis_rods_properties& properties, const hysteresis_parameters& params, table_cache& tables) {
+    // Everett and response tables are shared by all rods of a material, and by every spacecraft built with the cache
+    _slots.reserve(properties.size());
     for (const auto& rod : properties) {
-        _rods.emplace_back(rod, params);
+        if (rod.preisach) {
+            _slots.push_back({.model = hysteresis_model_preisach, .index = _preisach_rods.size()});
+            _preisach_rods.emplace_back(rod, tables.everett(*rod.preisach));
+        } else {
+            _slots.push_back({.model = hysteresis_model_jiles_atherton, .index = _rods.size()});
+            _rods.emplace_back(rod, params);
+        }
     }
+
+    for (auto& rod : _rods) {
+        if (rod.hysteresis().table) {
+            rod.attach_table(tables.hysteresis(rod.hysteresis()));
+        }
+    }
+}
+
+auto hysteresis_rods::size() const -> std::size_t {
+    return _slots.size();
 }
 
 auto hysteresis_rods::rods() const -> std::span<const hysteresis_rod> {
     return _rods;
 }
 
+auto hysteresis_rods::preisach_rods() const -> std::span<const preisach_rod> {
+    return _preisach_rods;
+}
+
+auto hysteresis_rods::has_history() const -> bool {
+    return not _preisach_rods.empty();
+}
+
+void hysteresis_rods::accept_field(const vec3& b_body, vecX& rod_magnetizations) {
+    assert(rod_magnetizations.size() == static_cast<std::ptrdiff_t>(_slots.size()));
+
+    for (std::size_t i = 0; i < _slots.size(); ++i) {
+        if (_slots[i].model == hysteresis_model_preisach) {
+            rod_magnetizations(static_cast<std::ptrdiff_t>(i)) = _preisach_rods[_slots[i].index].accept_field(b_body);
+        }
+    }
+}
+
+void hysteresis_rods::clamp_magnetizations(vecX& rod_magnetizations) const {
+    assert(rod_magnetizations.size() == static_cast<std::ptrdiff_t>(_slots.size()));
+
+    for (std::size_t i = 0; i < _slots.size(); ++i) {
+        const real ms = _slots[i].model == hysteresis_model_preisach  //
+                            ? _preisach_rods[_slots[i].index].parameters().ms
+                            : _rods[_slots[i].index].hysteresis().ms;
+
+        auto& m = rod_magnetizations(static_cast<std::ptrdiff_t>(i));
+        m       = std::clamp(m, -ms, ms);
+    }
+}
+
 auto hysteresis_rods::compute_rod_torques(const vecX& rod_magnetizations, const vec3& b_body) const -> vec3 {
-    const auto num_rods = static_cast<std::ptrdiff_t>(_rods.size());
+    const auto num_rods = static_cast<std::ptrdiff_t>(_slots.size());
     assert(rod_magnetizations.size() == num_rods);
 
     vec3 torque_sum = vec3::Zero();
     for (std::ptrdiff_t i = 0; i < num_rods; ++i) {
-        torque_sum += _rods[i].magnetic_moment(rod_magnetizations(i), b_body).cross(b_body);
+        const auto& slot = _slots[i];
+        if (slot.model == hysteresis_model_preisach) {
+            torque_sum += _preisach_rods[slot.index].magnetic_moment(b_body).cross(b_body);
+        } else {
+            torque_sum += _rods[slot.index].magnetic_moment(rod_magnetizations(i), b_body).cross(b_body);
+        }
     }
     return torque_sum;
 }
 
 void hysteresis_rods::compute_rod_derivatives(const vecX& rod_magnetizations, const vec3& b_body, const vec3& b_dot_body, vecX& dm_dt_out) const {
-    const auto num_rods = static_cast<std::ptrdiff_t>(_rods.size());
+    const auto num_rods = static_cast<std::ptrdiff_t>(_slots.size());
     assert(rod_magnetizations.size() == num_rods);
     assert(dm_dt_out.size() == num_rods);
 
     for (std::ptrdiff_t i = 0; i < num_rods; ++i) {
-        dm_dt_out(i) = _rods[i].magnetization_derivative(rod_magnetizations(i), b_body, b_dot_body);
+        const auto& slot = _slots[i];
+        if (slot.model == hysteresis_model_preisach) {
+            dm_dt_out(i) = 0.0;
+        } else {
+            dm_dt_out(i) = _rods[slot.index].magnetization_derivative(rod_magnetizations(i), b_body, b_dot_body);
+        }
     }
 }
 
+auto hysteresis_rods::compute_rod_effects(const vecX& rod_magnetizations, const vec3& b_body, const vec3& b_dot_body, vecX& dm_dt_out) const -> vec3 {
+    const auto num_rods = static_cast<std::ptrdiff_t>(_slots.size());
+    assert(rod_magnetizations.size() == num_rods);
+    assert(dm_dt_out.size() == num_rods);
+
+    vec3 moment_sum = vec3::Zero();
+    for (std::ptrdiff_t i = 0; i < num_rods; ++i) {
+        const auto& slot = _slots[i];
+        if (slot.model == hysteresis_model_preisach) {
+            moment_sum += _preisach_rods[slot.index].magnetic_moment(b_body);
+            dm_dt_out(i) = 0.0;
+            continue;
+        }
+
+        const auto effects = _rods[slot.index].compute_effects(rod_magnetizations(i), b_body, b_dot_body);
+        moment_sum += effects.magnetic_moment;
+        dm_dt_out(i) = effects.magnetization_derivative;
+    }
+
+    // sum(m_i x B) = (sum m_i) x B
+    return moment_sum.cross(b_body);
+}
+
 }  // namespace aos
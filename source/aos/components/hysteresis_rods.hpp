@@ -1,15 +1,25 @@
 #pragma once
 
 #include "aos/components/hysteresis_rod.hpp"
+#include "aos/components/preisach_rod.hpp"
 #include "aos/core/types.hpp"
 
+#include <cstddef>
+#include <cstdint>
 #include <span>
 #include <vector>
 
 namespace aos {
 
+class table_cache;
+
 using hysteresis_rods_properties = std::vector<hysteresis_rod_properties>;
 
+enum hysteresis_model : uint8_t {
+    hysteresis_model_jiles_atherton,  // M_irr is integrated as part of the ODE state
+    hysteresis_model_preisach,        // M follows from the field history, its state slot only mirrors the last accepted value
+};
+
 class hysteresis_rods {
 public:
 
@@ -18,10 +28,21 @@ public:
     auto operator=(const hysteresis_rods&) -> hysteresis_rods& = delete;
     auto operator=(hysteresis_rods&&) -> hysteresis_rods&      = delete;
 
-    hysteresis_rods(const hysteresis_rods_properties& properties, const hysteresis_parameters& params);
+    hysteresis_rods(const hysteresis_rods_properties& properties, const hysteresis_parameters& params, table_cache& tables);
     ~hysteresis_rods() = default;
 
+    [[nodiscard]] auto size() const -> std::size_t;
     [[nodiscard]] auto rods() const -> std::span<const hysteresis_rod>;
+    [[nodiscard]] auto preisach_rods() const -> std::span<const preisach_rod>;
+
+    // check if any rod keeps a field history that has to be advanced at accepted steps
+    [[nodiscard]] auto has_history() const -> bool;
+
+    // advance the Preisach histories to the accepted B-field, write their magnetization into the state slots
+    void accept_field(const vec3& b_body, vecX& rod_magnetizations);
+
+    // clamp integrated magnetizations to [-Ms, Ms] in case of integrator overshot
+    void clamp_magnetizations(vecX& rod_magnetizations) const;
 
     // compute total rod torque exerted by all rods
     [[nodiscard]] auto compute_rod_torques(const vecX& rod_magnetizations, const vec3& b_body) const -> vec3;
@@ -29,9 +50,19 @@ public:
     // compute dM/dt for each rod, write dM/dt values into the dm_dt_out
     void compute_rod_derivatives(const vecX& rod_magnetizations, const vec3& b_body, const vec3& b_dot_body, vecX& dm_dt_out) const;
 
+    // compute total rod torque and dM/dt for each rod in a single pass, write dM/dt values into the dm_dt_out
+    [[nodiscard]] auto compute_rod_effects(const vecX& rod_magnetizations, const vec3& b_body, const vec3& b_dot_body, vecX& dm_dt_out) const -> vec3;
+
 private:
 
+    struct rod_slot {
+        hysteresis_model model;
+        std::size_t      index;  // into the rod list of the model
+    };
+
+    std::vector<rod_slot>       _slots;  // one per state slot
     std::vector<hysteresis_rod> _rods;
+    std::vector<preisach_rod>   _preisach_rods;
 };
 
 }  // namespace aos
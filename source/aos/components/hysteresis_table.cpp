@@ -0,0 +1,83 @@
+#include "hysteresis_table.hpp"
+
+#include "aos/components/hysteresis_rod.hpp"
+#include "aos/core/langevin.hpp"
+#include "aos/core/types.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+
+namespace aos {
+
+hysteresis_table::hysteresis_table(const hysteresis_parameters& params, const hysteresis_table_properties& properties)
+    : _hysteresis(params),
+      _h_max(properties.h_max_am + (params.alpha * params.ms)),
+      _u_max(map_h(_h_max)),
+      _inv_du(static_cast<real>(properties.nodes - 1) / (2.0 * _u_max)),
+      _nodes(properties.nodes) {
+    if (properties.h_max_am <= 0.0) {
+        throw std::runtime_error("Hysteresis table 'h_max' must be positive");
+    }
+    if (_nodes < 2) {
+        throw std::runtime_error("Hysteresis table needs at least 2 nodes");
+    }
+
+    _m_an.resize(static_cast<std::size_t>(_nodes));
+    for (int i = 0; i < _nodes; ++i) {
+        _m_an[static_cast<std::size_t>(i)] = direct(unmap_h((i / _inv_du) - _u_max));
+    }
+
+    // worst case sits between nodes
+    for (int i = 0; i + 1 < _nodes; ++i) {
+        const real h = unmap_h(((i + 0.5) / _inv_du) - _u_max);
+        _error       = std::max(_error, std::abs(anhysteretic(h) - direct(h)) / _hysteresis.ms);
+    }
+}
+
+void hysteresis_table::debug_print() const {
+    std::cout << "-- hysteresis table --"                   //
+              << "\n  nodes:          " << _nodes           //
+              << "\n  |H_eff| max:    " << _h_max           //
+              << "\n  max M_an error: " << _error << " Ms"  //
+              << '\n';
+}
+
+auto hysteresis_table::parameters() const -> const hysteresis_parameters& {
+    return _hysteresis;
+}
+
+auto hysteresis_table::contains(real h_eff_am) const -> bool {
+    return std::abs(h_eff_am) <= _h_max;
+}
+
+auto hysteresis_table::anhysteretic(real h_eff_am) const -> real {
+    const real f = (map_h(h_eff_am) + _u_max) * _inv_du;
+    const int  i = std::clamp(static_cast<int>(f), 0, _nodes - 2);
+    const real w = f - i;
+
+    const auto idx = static_cast<std::size_t>(i);
+    return _m_an[idx] + (w * (_m_an[idx + 1] - _m_an[idx]));
+}
+
+auto hysteresis_table::create(const hysteresis_parameters& params) -> std::shared_ptr<const hysteresis_table> {
+    return std::make_shared<const hysteresis_table>(params, params.table.value_or(hysteresis_table_properties{}));
+}
+
+auto hysteresis_table::map_h(real h_eff_am) const -> real {
+    // (-inf, inf) -> (-1, 1), linear with slope 1/a around zero
+    return h_eff_am / (std::abs(h_eff_am) + _hysteresis.a);
+}
+
+auto hysteresis_table::unmap_h(real u) const -> real {
+    return _hysteresis.a * u / (1.0 - std::abs(u));
+}
+
+auto hysteresis_table::direct(real h_eff_am) const -> real {
+    return _hysteresis.ms * langevin(h_eff_am / _hysteresis.a, _hysteresis.langevin);
+}
+
+}  // namespace aos
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "aos/components/hysteresis_rod.hpp"
+#include "aos/core/types.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace aos {
+
+/**
+ * @brief Precomputed anhysteretic curve M_an(H_eff) of one material.
+ *
+ * For fixed hysteresis parameters M_an is the only transcendental term of the Jiles-Atherton right-hand side. The
+ * table stores it at grid nodes and interpolates linearly; dM_irr/dH of both branches is then formed from the
+ * interpolated M_an by the exact J-A algebra, so the saturation clamp, the pole and the causality cut stay sharp.
+ *
+ * The H_eff axis is uniform in u = H_eff / (|H_eff| + a), which places most nodes where M_an bends (|H_eff| of a few
+ * a) and fewer in the nearly saturated tails.
+ *
+ * The interpolation error is estimated at build time against direct evaluation at every cell center and reported by
+ * debug_print().
+ */
+class hysteresis_table {
+public:
+
+    hysteresis_table(const hysteresis_table&)                    = delete;
+    hysteresis_table(hysteresis_table&&)                         = delete;
+    auto operator=(const hysteresis_table&) -> hysteresis_table& = delete;
+    auto operator=(hysteresis_table&&) -> hysteresis_table&      = delete;
+
+    hysteresis_table(const hysteresis_parameters& params, const hysteresis_table_properties& properties);
+    ~hysteresis_table() = default;
+
+    [[nodiscard]] auto parameters() const -> const hysteresis_parameters&;
+
+    // check if the effective field lies inside the table
+    [[nodiscard]] auto contains(real h_eff_am) const -> bool;
+
+    // interpolate M_an, h_eff_am must lie inside the table
+    [[nodiscard]] auto anhysteretic(real h_eff_am) const -> real;
+
+    void debug_print() const;
+
+    static auto create(const hysteresis_parameters& params) -> std::shared_ptr<const hysteresis_table>;
+
+protected:
+
+    [[nodiscard]] auto map_h(real h_eff_am) const -> real;
+    [[nodiscard]] auto unmap_h(real u) const -> real;
+
+    // evaluate the Langevin function directly
+    [[nodiscard]] auto direct(real h_eff_am) const -> real;
+
+private:
+
+    hysteresis_parameters _hysteresis;
+    real                  _h_max;
+    real                  _u_max;
+    real                  _inv_du;
+    int                   _nodes;
+    std::vector<real>     _m_an;
+    real                  _error{0.0};  // max |M_an error| relative to Ms
+};
+
+}  // namespace aos
@@ -0,0 +1,117 @@
+#include "preisach_rod.hpp"
+
+#include "aos/components/everett_table.hpp"
+#include "aos/components/hysteresis_rod.hpp"
+#include "aos/core/constants.hpp"
+#include "aos/core/types.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace aos {
+
+preisach_rod::preisach_rod(const hysteresis_rod_properties& properties, std::shared_ptr<const everett_table> everett)
+    : _volume(properties.volume_m3),
+      _orientation_body(properties.orientation.normalized()),
+      _everett(std::move(everett)),
+      _sums{0.0},
+      _input(-_everett->h_max()) {
+    if (_volume <= 0.0) {
+        throw std::runtime_error("Volume must be positive");
+    }
+
+    // start from negative saturation and wind down to the demagnetized state
+    for (real amplitude = _everett->h_max(); amplitude > demagnetization_floor * _everett->h_max(); amplitude *= demagnetization_decay) {
+        accept(amplitude);
+        accept(-amplitude);
+    }
+    accept(0.0);
+}
+
+auto preisach_rod::parameters() const -> const preisach_parameters& {
+    return _everett->parameters();
+}
+
+auto preisach_rod::reversal_points() const -> std::size_t {
+    return _points.size();
+}
+
+auto preisach_rod::magnetization(const vec3& b_body_t) const -> real {
+    const real h = field_along_rod(b_body_t);
+    return magnetization_after(cut_history(h), h);
+}
+
+auto preisach_rod::magnetic_moment(const vec3& b_body_t) const -> vec3 {
+    return magnetization(b_body_t) * _volume * _orientation_body;
+}
+
+auto preisach_rod::accept_field(const vec3& b_body_t) -> real {
+    return accept(field_along_rod(b_body_t));
+}
+
+auto preisach_rod::field_along_rod(const vec3& b_body_t) const -> real {
+    const real h_max = _everett->h_max();
+    return std::clamp(b_body_t.dot(_orientation_body) / vacuum_permeability, -h_max, h_max);
+}
+
+auto preisach_rod::cut_history(real h_am) const -> history_cut {
+    const std::size_t count = _points.size();
+
+    // an even number of reversal points means the field was rising
+    bool rising = count % 2 == 0;
+
+    // the last accepted field turns into a reversal point
+    const bool  flip   = rising ? h_am < _input : h_am > _input;
+    std::size_t length = count;
+    if (flip) {
+        rising = not rising;
+        ++length;
+    }
+
+    // wiping-out: passing the previous extremum of the same kind erases it together with the one that followed it
+    while (length >= 2 && (rising ? h_am >= reversal_point(length - 2) : h_am <= reversal_point(length - 2))) {
+        length -= 2;
+    }
+
+    if (length <= count) {
+        return {.length = length, .sum = _sums[length]};
+    }
+
+    const real previous = count > 0 ? _points.back() : -_everett->h_max();
+    return {.length = length, .sum = _sums[count] + segment(previous, _input)};
+}
+
+auto preisach_rod::reversal_point(std::size_t i) const -> real {
+    // past the stored points only the last accepted field can follow
+    return i < _points.size() ? _points[i] : _input;
+}
+
+auto preisach_rod::magnetization_after(const history_cut& cut, real h_am) const -> real {
+    const real last = cut.length > 0 ? reversal_point(cut.length - 1) : -_everett->h_max();
+    return _everett->parameters().ms * (-1.0 + (2.0 * (cut.sum + segment(last, h_am))));
+}
+
+auto preisach_rod::segment(real from_am, real to_am) const -> real {
+    // rising segments switch hysterons up, falling segments switch them down
+    return to_am >= from_am ? _everett->evaluate(to_am, from_am) : -_everett->evaluate(from_am, to_am);
+}
+
+auto preisach_rod::accept(real h_am) -> real {
+    const auto cut = cut_history(h_am);
+
+    if (cut.length > _points.size()) {
+        _points.push_back(_input);
+        _sums.push_back(cut.sum);
+    } else {
+        _points.resize(cut.length);
+        _sums.resize(cut.length + 1);
+    }
+    _input = h_am;
+
+    return magnetization_after(cut, h_am);
+}
+
+}  // namespace aos
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "aos/components/everett_table.hpp"
+#include "aos/components/hysteresis_rod.hpp"
+#include "aos/core/types.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace aos {
+
+/**
+ * @brief Hysteresis rod described by the classical Preisach model.
+ *
+ * The magnetization is an algebraic function of the field history: M = Ms * (-1 + 2 * sum of signed Everett terms
+ * over the reversal points and the current field). The history is kept as a wiping-out stack of alternating maxima and
+ * minima, a new extremum erases all smaller ones, so the stack stays short.
+ *
+ * Evaluation is const and does not touch the stack: during a step the field is treated as a monotone continuation of
+ * the last accepted field. The stack only advances in accept_field(), which the simulation calls once per accepted step.
+ */
+class preisach_rod {
+public:
+
+    // decaying alternating field applied at construction, leaves the rod close to M = 0 at H = 0
+    static constexpr real demagnetization_decay = 0.95;  // [-] amplitude ratio of consecutive cycles
+    static constexpr real demagnetization_floor = 1e-4;  // [-] final amplitude relative to h_max
+
+    preisach_rod(const hysteresis_rod_properties& properties, std::shared_ptr<const everett_table> everett);
+
+    [[nodiscard]] auto parameters() const -> const preisach_parameters&;
+    [[nodiscard]] auto reversal_points() const -> std::size_t;
+
+    // magnetization for the given B-field, continuing the accepted history
+    [[nodiscard]] auto magnetization(const vec3& b_body_t) const -> real;
+    [[nodiscard]] auto magnetic_moment(const vec3& b_body_t) const -> vec3;
+
+    // advance the history to the given B-field and return the new magnetization
+    auto accept_field(const vec3& b_body_t) -> real;
+
+protected:
+
+    struct history_cut {
+        std::size_t length;  // reversal points left after wiping out
+        real        sum;     // signed Everett terms of those points
+    };
+
+    [[nodiscard]] auto field_along_rod(const vec3& b_body_t) const -> real;
+
+    // wipe out the reversal points the field passes, the last accepted field becomes a reversal point if the direction flips
+    [[nodiscard]] auto cut_history(real h_am) const -> history_cut;
+    [[nodiscard]] auto reversal_point(std::size_t i) const -> real;
+    [[nodiscard]] auto magnetization_after(const history_cut& cut, real h_am) const -> real;
+
+    // signed Everett term of a monotone segment
+    [[nodiscard]] auto segment(real from_am, real to_am) const -> real;
+
+    auto accept(real h_am) -> real;
+
+private:
+
+    real                                 _volume;
+    vec3                                 _orientation_body;
+    std::shared_ptr<const everett_table> _everett;
+    std::vector<real>                    _points;  // reversal points, alternating max / min, starting from negative saturation
+    std::vector<real>                    _sums;    // _sums[i] = signed Everett terms of the first i reversal points
+    real                                 _input;   // last accepted field along the rod
+};
+
+}  // namespace aos
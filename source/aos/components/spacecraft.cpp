@@ -6,6 +6,7 @@
 #include "aos/components/permanent_magnet.hpp"
 #include "aos/components/spacecraft_faces.hpp"
 #include "aos/components/spacecraft_shape.hpp"
+#include "aos/components/table_cache.hpp"
 #include "aos/core/constants.hpp"
 #include "aos/core/state.hpp"
 #include "aos/core/types.hpp"
@@ -64,12 +65,12 @@ void spacecraft_properties::debug_print() const {
     }
 }
 
-spacecraft::spacecraft(const spacecraft_properties& properties)
+spacecraft::spacecraft(const spacecraft_properties& properties, table_cache& tables)
     : _mass_kg(properties.mass_kg),
       _inertia(properties.mass_kg, properties.shape),
-      _faces(properties.shape),
+      _faces(properties.shape, tables),
       _magnet(properties.magnet),
-      _hystresis(properties.rods, properties.hysteresis) {}
+      _hystresis(properties.rods, properties.hysteresis, tables) {}
 
 spacecraft::~spacecraft() = default;
 
@@ -93,40 +94,18 @@ auto spacecraft::hystresis() const -> const hysteresis_rods& {
     return _hystresis;
 }
 
-void spacecraft::derivative(const environment_effects& env, const system_state& current_state, system_state& state_derivative) const {
-    const vec3& r_eci            = current_state.position_m;
-    const vec3& v_eci            = current_state.velocity_m_s;
-    const quat  q_att            = current_state.attitude.normalized();  // normalize to prevent drift
-    const vec3& omega_body       = current_state.angular_velocity_m_s;
-    const quat  q_inv            = q_att.conjugate();
-    const vec3  r_body           = q_inv * r_eci;
-    const vec3  b_body           = q_inv * env.magnetic_field_eci_T;
-    const vec3  b_dot_orbital    = q_inv * env.magnetic_field_dot_eci_T_s;
-    const vec3  b_dot_rotational = -omega_body.cross(b_body);
-    const vec3  b_dot_body       = b_dot_orbital + b_dot_rotational;
-    const vec3  rods_torque      = _hystresis.compute_rod_torques(current_state.rod_magnetizations, b_body);
-    const auto  face_effects     = _faces.compute_face_effects(env, q_att, q_inv, omega_body);
-    const vec3  net_torque       = compute_torques(omega_body, b_body, r_body, env.earth_mu) + rods_torque + face_effects.torque_body;
-
-    state_derivative.position_m   = v_eci;
-    state_derivative.velocity_m_s = env.gravity_eci_m_s2;
-    state_derivative.velocity_m_s += face_effects.force_eci / _mass_kg;
-    state_derivative.angular_velocity_m_s = _inertia.inverse() * net_torque;
-    state_derivative.attitude.coeffs()    = system_state::compute_attitude_derivative(q_att, omega_body);
-    _hystresis.compute_rod_derivatives(current_state.rod_magnetizations, b_body, b_dot_body, state_derivative.rod_magnetizations);
+void spacecraft::accept_step(const environment_effects& env, system_state& state) {
+    const vec3 b_body = state.attitude.normalized().conjugate() * env.magnetic_field_eci_T;
+    _hystresis.accept_field(b_body, state.rod_magnetizations);
 }
 
-// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-auto spacecraft::compute_torques(const vec3& omega, const vec3& b_body, const vec3& r_body, real earth_mu) const -> vec3 {
-    vec3 torque = vec3::Zero();
-    torque += _magnet.compute_torque(b_body);
-    torque += _inertia.compute_gyroscopic_torque(omega);
-    torque += _inertia.compute_gravity_gradient_torque(r_body, earth_mu);
-    return torque;
+auto spacecraft::create(const spacecraft_properties& properties) -> std::shared_ptr<spacecraft> {
+    table_cache tables;  // nothing to share with
+    return create(properties, tables);
 }
 
-auto spacecraft::create(const spacecraft_properties& properties) -> std::shared_ptr<spacecraft> {
-    return std::make_shared<spacecraft>(properties);
+auto spacecraft::create(const spacecraft_properties& properties, table_cache& tables) -> std::shared_ptr<spacecraft> {
+    return std::make_shared<spacecraft>(properties, tables);
 }
 
 }  // namespace aos
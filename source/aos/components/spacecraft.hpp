@@ -6,6 +6,7 @@
 #include "aos/components/permanent_magnet.hpp"
 #include "aos/components/spacecraft_faces.hpp"
 #include "aos/components/spacecraft_shape.hpp"
+#include "aos/core/force_models.hpp"
 #include "aos/core/state.hpp"
 #include "aos/core/types.hpp"
 #include "aos/environment/environment.hpp"
@@ -14,6 +15,8 @@
 
 namespace aos {
 
+class table_cache;
+
 struct spacecraft_properties {
     real                        mass_kg;
     spacecraft_shape            shape;
@@ -33,7 +36,8 @@ public:
     auto operator=(const spacecraft&) -> spacecraft& = delete;
     auto operator=(spacecraft&&) -> spacecraft&      = delete;
 
-    explicit spacecraft(const spacecraft_properties& properties);
+    // hysteresis, Everett and face tables come from tables, see table_cache
+    spacecraft(const spacecraft_properties& properties, table_cache& tables);
     ~spacecraft();
 
     [[nodiscard]] auto mass_kg() const -> double;
@@ -42,13 +46,20 @@ public:
     [[nodiscard]] auto magnet() const -> const permanent_magnet&;
     [[nodiscard]] auto hystresis() const -> const hysteresis_rods&;
 
+    // right-hand side restricted to the given force models, disabled models are compiled out
+    template <force_model_set models = force_model_set{}>
     void derivative(const environment_effects& env, const system_state& current_state, system_state& state_derivative) const;
 
+    // advance history-dependent components (Preisach rods) after an accepted integration step
+    void accept_step(const environment_effects& env, system_state& state);
+
     static auto create(const spacecraft_properties& properties) -> std::shared_ptr<spacecraft>;
+    static auto create(const spacecraft_properties& properties, table_cache& tables) -> std::shared_ptr<spacecraft>;
 
 protected:
 
     // sums permanent magnet, gyroscopic, and gravity gradient torques
+    template <force_model_set models>
     [[nodiscard]] auto compute_torques(const vec3& omega, const vec3& b_body, const vec3& r_body, real earth_mu) const -> vec3;
 
 private:
@@ -60,4 +71,56 @@ private:
     hysteresis_rods  _hystresis;
 };
 
+template <force_model_set models>
+void spacecraft::derivative(const environment_effects& env, const system_state& current_state, system_state& state_derivative) const {
+    const vec3& r_eci      = current_state.position_m;
+    const vec3& v_eci      = current_state.velocity_m_s;
+    const quat  q_att      = current_state.attitude.normalized();  // normalize to prevent drift
+    const vec3& omega_body = current_state.angular_velocity_m_s;
+    const quat  q_inv      = q_att.conjugate();
+    const vec3  r_body     = q_inv * r_eci;
+
+    vec3 b_body = vec3::Zero();
+    if constexpr (models.needs_magnetic_field()) {
+        b_body = q_inv * env.magnetic_field_eci_T;
+    }
+
+    vec3 net_torque = compute_torques<models>(omega_body, b_body, r_body, env.earth_mu);
+
+    if constexpr (models.rods) {
+        const vec3 b_dot_orbital    = q_inv * env.magnetic_field_dot_eci_T_s;
+        const vec3 b_dot_rotational = -omega_body.cross(b_body);
+        const vec3 b_dot_body       = b_dot_orbital + b_dot_rotational;
+        net_torque += _hystresis.compute_rod_effects(current_state.rod_magnetizations, b_body, b_dot_body, state_derivative.rod_magnetizations);
+    } else {
+        state_derivative.rod_magnetizations.setZero();
+    }
+
+    state_derivative.position_m   = v_eci;
+    state_derivative.velocity_m_s = env.gravity_eci_m_s2;
+
+    if constexpr (models.needs_faces()) {
+        const auto face_effects = _faces.compute_face_effects<models.drag, models.srp>(env, q_att, q_inv, omega_body);
+        net_torque += face_effects.torque_body;
+        state_derivative.velocity_m_s += face_effects.force_eci / _mass_kg;
+    }
+
+    state_derivative.angular_velocity_m_s = _inertia.inverse() * net_torque;
+    state_derivative.attitude.coeffs()    = system_state::compute_attitude_derivative(q_att, omega_body);
+}
+
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+template <force_model_set models>
+auto spacecraft::compute_torques(const vec3& omega, const vec3& b_body, const vec3& r_body, real earth_mu) const -> vec3 {
+    vec3 torque = vec3::Zero();
+    if constexpr (models.magnet) {
+        torque += _magnet.compute_torque(b_body);
+    }
+    torque += _inertia.compute_gyroscopic_torque(omega);
+    if constexpr (models.gravity_gradient) {
+        torque += _inertia.compute_gravity_gradient_torque(r_body, earth_mu);
+    }
+    return torque;
+}
+
 }  // namespace aos
@@ -7,6 +7,7 @@
 #include <toml++/toml.hpp>
 
 #include <cmath>
+#include <cstddef>
 #include <iostream>
 #include <limits>
 
@@ -31,6 +32,16 @@ void spacecraft_face::from_toml(const toml_table& table) {
     drag_coefficient                = table["drag_coefficient"].value_or(default_drag_coefficient);
     specular_reflection_coefficient = table["specular_reflection_coefficient"].value_or(0.0);
     diffuse_reflection_coefficient  = table["diffuse_reflection_coefficient"].value_or(0.0);
+
+    outline.clear();
+    if (const auto* arr = table["outline"].as_array()) {
+        outline.reserve(arr->size());
+        for (std::size_t i = 0; i < arr->size(); ++i) {
+            if (const auto* vec = arr->get(i)->as_array()) {
+                outline.emplace_back(vec->get(0)->value_or(0.0), vec->get(1)->value_or(0.0), vec->get(2)->value_or(0.0));
+            }
+        }
+    }
 }
 
 void spacecraft_face::debug_print() const {
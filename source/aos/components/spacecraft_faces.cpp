@@ -1,17 +1,23 @@
 #include "spacecraft_faces.hpp"
 
+#include "aos/components/face_coefficient_table.hpp"
 #include "aos/components/spacecraft_face.hpp"
 #include "aos/components/spacecraft_shape.hpp"
+#include "aos/components/table_cache.hpp"
 #include "aos/core/types.hpp"
 #include "aos/environment/environment.hpp"
 
+#include <Eigen/Core>
+
+#include <cmath>
 #include <cstddef>
 #include <type_traits>
 #include <variant>
+#include <vector>
 
 namespace aos {
 
-spacecraft_faces::spacecraft_faces(const spacecraft_shape& shape) {
+spacecraft_faces::spacecraft_faces(const spacecraft_shape& shape, table_cache& tables) {
     std::visit(
         [&](auto&& shape) {
             using shape_type = std::decay_t<decltype(shape)>;
@@ -19,41 +25,141 @@ spacecraft_faces::spacecraft_faces(const spacecraft_shape& shape) {
             if constexpr (std::is_same_v<shape_type, spacecraft_uniform>) {
                 uniform(shape);
             } else if constexpr (std::is_same_v<shape_type, spacecraft_custom>) {
-                _faces = shape.faces;
+                custom(shape, tables);
             }
         },
         shape);
+    pack();
 }
 
-spacecraft_faces::spacecraft_faces(const spacecraft_custom& shape) : _faces(shape.faces) {}
+spacecraft_faces::spacecraft_faces(const spacecraft_custom& shape, table_cache& tables) {
+    custom(shape, tables);
+    pack();
+}
 
 spacecraft_faces::spacecraft_faces(const spacecraft_uniform& shape) {
     uniform(shape);
+    pack();
+}
+
+auto spacecraft_faces::size() const -> std::size_t {
+    return _faces.size();
+}
+
+auto spacecraft_faces::faces() const -> const spacecraft_face_list& {
+    return _faces;
 }
 
 // NOLINTBEGIN(bugprone-easily-swappable-parameters)
+template <bool with_drag, bool with_srp>
 auto spacecraft_faces::compute_face_effects(const environment_effects& env, const quat& q_att, const quat& q_inv, const vec3& omega_body) const
     -> face_effects {
-    vec3 torque_body_sum = vec3::Zero();
-    vec3 force_body_sum  = vec3::Zero();
+    using batch = Eigen::Array<real, batch_size, 1>;
 
     const vec3 s_body = (q_inv * env.r_sun_eci).normalized();
     const vec3 v_body = q_inv * env.v_earth_rel;
-    for (const auto& face : _faces) {
-        const vec3 f_body = face.compute_force(env, v_body, s_body, omega_body);  // drag + srp
-        force_body_sum += f_body;
-        torque_body_sum += face.center_of_pressure_m.cross(f_body);
+    const real rho    = env.atmospheric_density_kg_m3;
+    const real p_srp  = env.shadow_factor > 0.0 ? env.solar_pressure_Pa * env.shadow_factor : 0.0;
+
+    if (_table) {
+        vec3 force_body  = vec3::Zero();
+        vec3 torque_body = vec3::Zero();
+
+        if constexpr (with_drag) {
+            const real v_sq = v_body.squaredNorm();
+            if (v_sq > 0.0) {
+                const vec3 v_dir = v_body / std::sqrt(v_sq);
+                const auto drag  = _table->drag(v_dir);
+                force_body += rho * v_sq * drag.force * v_dir;
+                torque_body += rho * v_sq * drag.moment.cross(v_dir);
+            }
+        }
+        if constexpr (with_srp) {
+            if (p_srp > 0.0) {
+                const auto srp = _table->srp(s_body);
+                force_body += p_srp * srp.force;
+                torque_body += p_srp * srp.torque;
+            }
+        }
+
+        return {
+            .torque_body = torque_body,
+            .force_eci   = q_att * force_body,
+        };
+    }
+
+    batch fx_sum = batch::Zero();
+    batch fy_sum = batch::Zero();
+    batch fz_sum = batch::Zero();
+    batch tx_sum = batch::Zero();
+    batch ty_sum = batch::Zero();
+    batch tz_sum = batch::Zero();
+
+    for (Eigen::Index i = 0; i < _center_x.size(); i += batch_size) {
+        const auto cx = _center_x.segment<batch_size>(i);
+        const auto cy = _center_y.segment<batch_size>(i);
+        const auto cz = _center_z.segment<batch_size>(i);
+        const auto nx = _normal_x.segment<batch_size>(i);
+        const auto ny = _normal_y.segment<batch_size>(i);
+        const auto nz = _normal_z.segment<batch_size>(i);
+
+        batch fx = batch::Zero();
+        batch fy = batch::Zero();
+        batch fz = batch::Zero();
+
+        if constexpr (with_drag) {
+            // v_rel = v + omega x r_cp
+            const batch vx = v_body.x() + ((omega_body.y() * cz) - (omega_body.z() * cy));
+            const batch vy = v_body.y() + ((omega_body.z() * cx) - (omega_body.x() * cz));
+            const batch vz = v_body.z() + ((omega_body.x() * cy) - (omega_body.y() * cx));
+
+            // drag: 0.5 * rho * Cd * A * cos(theta) * |v| * v, with cos(theta) * |v| = -n . v
+            const batch v_in = -((nx * vx) + (ny * vy) + (nz * vz));
+            const batch drag = (v_in > 0.0).select(rho * _drag_area.segment<batch_size>(i) * v_in, 0.0);
+
+            fx = drag * vx;
+            fy = drag * vy;
+            fz = drag * vz;
+        }
+
+        if constexpr (with_srp) {
+            // srp: sun-ward and normal components on lit faces
+            const batch cos_a = (nx * s_body.x()) + (ny * s_body.y()) + (nz * s_body.z());
+            const batch lit   = (cos_a > 0.0).select(p_srp * cos_a, 0.0);
+            const batch srp_s = lit * _srp_sun_area.segment<batch_size>(i);
+            const batch srp_n = lit * ((cos_a * _srp_spec_area.segment<batch_size>(i)) + _srp_diff_area.segment<batch_size>(i));
+
+            fx = fx - (srp_s * s_body.x()) - (srp_n * nx);
+            fy = fy - (srp_s * s_body.y()) - (srp_n * ny);
+            fz = fz - (srp_s * s_body.z()) - (srp_n * nz);
+        }
+
+        fx_sum += fx;
+        fy_sum += fy;
+        fz_sum += fz;
+        tx_sum += (cy * fz) - (cz * fy);
+        ty_sum += (cz * fx) - (cx * fz);
+        tz_sum += (cx * fy) - (cy * fx);
     }
 
+    const vec3 force_body_sum(fx_sum.sum(), fy_sum.sum(), fz_sum.sum());
     return {
-        .torque_body = torque_body_sum,
+        .torque_body = vec3(tx_sum.sum(), ty_sum.sum(), tz_sum.sum()),
         .force_eci   = q_att * force_body_sum,
     };
 }
 
+template auto spacecraft_faces::compute_face_effects<true, true>(const environment_effects&, const quat&, const quat&, const vec3&) const -> face_effects;
+template auto spacecraft_faces::compute_face_effects<true, false>(const environment_effects&, const quat&, const quat&, const vec3&) const -> face_effects;
+template auto spacecraft_faces::compute_face_effects<false, true>(const environment_effects&, const quat&, const quat&, const vec3&) const -> face_effects;
+
 auto spacecraft_faces::compute_faces_effects_with_forces(const environment_effects& env, const quat& q_inv, const vec3& omega_body) const
     -> face_effects_with_forces {
-    face_effects_with_forces result;
+    face_effects_with_forces result{
+        .torque_body = vec3::Zero(),
+        .force_body  = vec3::Zero(),
+        .forces_body = std::vector<face_forces>(_faces.size()),
+    };
 
     const vec3 s_body = (q_inv * env.r_sun_eci).normalized();
     const vec3 v_body = q_inv * env.v_earth_rel;
@@ -72,6 +178,42 @@ auto spacecraft_faces::compute_faces_effects_with_forces(const environment_effec
 }
 // NOLINTEND(bugprone-easily-swappable-parameters)
 
+void spacecraft_faces::pack() {
+    const auto num_faces  = static_cast<Eigen::Index>(_faces.size());
+    const auto num_padded = ((num_faces + batch_size - 1) / batch_size) * batch_size;
+
+    for (auto* column : {&_center_x, &_center_y, &_center_z, &_normal_x, &_normal_y, &_normal_z}) {
+        column->setZero(num_padded);
+    }
+    for (auto* column : {&_drag_area, &_srp_sun_area, &_srp_spec_area, &_srp_diff_area}) {
+        column->setZero(num_padded);
+    }
+
+    // NOLINTBEGIN(readability-magic-numbers)
+    for (Eigen::Index i = 0; i < num_faces; ++i) {
+        const auto& face  = _faces[static_cast<std::size_t>(i)];
+        const real  area  = face.surface_area_m2;
+        _center_x(i)      = face.center_of_pressure_m.x();
+        _center_y(i)      = face.center_of_pressure_m.y();
+        _center_z(i)      = face.center_of_pressure_m.z();
+        _normal_x(i)      = face.surface_normal.x();
+        _normal_y(i)      = face.surface_normal.y();
+        _normal_z(i)      = face.surface_normal.z();
+        _drag_area(i)     = 0.5 * face.drag_coefficient * area;
+        _srp_sun_area(i)  = area * (1.0 - face.specular_reflection_coefficient);
+        _srp_spec_area(i) = area * 2.0 * face.specular_reflection_coefficient;
+        _srp_diff_area(i) = area * (2.0 / 3.0) * face.diffuse_reflection_coefficient;
+    }
+    // NOLINTEND(readability-magic-numbers)
+}
+
+void spacecraft_faces::custom(const spacecraft_custom& shape, table_cache& tables) {
+    _faces = shape.faces;
+    if (shape.face_table) {
+        _table = tables.face_coefficients(_faces, *shape.face_table);
+    }
+}
+
 void spacecraft_faces::uniform(const spacecraft_uniform& shape) {
     const auto& dim_m                           = shape.dimensions_m;
     const auto& drag_coefficient                = shape.drag_coefficient;
@@ -81,6 +223,8 @@ void spacecraft_faces::uniform(const spacecraft_uniform& shape) {
     const auto  face_surface_area_y             = dim_m.x() * dim_m.z();
     const auto  face_surface_area_z             = dim_m.x() * dim_m.y();
 
+    _faces.resize(spacecraft_num_faces);
+
     // NOLINTBEGIN(readability-magic-numbers)
     _faces[0].surface_area_m2                 = face_surface_area_x;
     _faces[0].surface_normal                  = vec3(1, 0, 0);
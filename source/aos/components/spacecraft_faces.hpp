@@ -1,26 +1,51 @@
 #pragma once
 
+#include "aos/components/face_coefficient_table.hpp"
 #include "aos/components/spacecraft_face.hpp"
 #include "aos/components/spacecraft_shape.hpp"
 #include "aos/core/types.hpp"
 #include "aos/environment/environment.hpp"
 
+#include <Eigen/Core>
+
+#include <cstddef>
+#include <memory>
+
 namespace aos {
 
+class table_cache;
+
+/**
+ * @brief Face set of the spacecraft surface, any number of faces.
+ *
+ * The faces are kept twice: as spacecraft_face records for per-face queries (verification output) and as a
+ * structure-of-arrays copy padded to whole batches, which compute_face_effects evaluates batch_size faces at a time
+ * with fixed-size Eigen arrays (vectorized, no allocation). Padding faces have zero area and contribute nothing.
+ *
+ * With a face table configured (custom shapes), compute_face_effects interpolates precomputed coefficients instead,
+ * which includes self-shadowing and costs the same for any number of faces. The per-face path stays exact.
+ */
 class spacecraft_faces {
 public:
 
+    static constexpr Eigen::Index batch_size = 8;
+
     spacecraft_faces(const spacecraft_faces&)                    = delete;
     spacecraft_faces(spacecraft_faces&&)                         = delete;
     auto operator=(const spacecraft_faces&) -> spacecraft_faces& = delete;
     auto operator=(spacecraft_faces&&) -> spacecraft_faces&      = delete;
 
-    explicit spacecraft_faces(const spacecraft_shape& shape);
-    explicit spacecraft_faces(const spacecraft_custom& shape);
+    // the face table of a custom shape comes from tables
+    spacecraft_faces(const spacecraft_shape& shape, table_cache& tables);
+    spacecraft_faces(const spacecraft_custom& shape, table_cache& tables);
     explicit spacecraft_faces(const spacecraft_uniform& shape);
     ~spacecraft_faces() = default;
 
-    // compute drag and srp torque+force
+    [[nodiscard]] auto size() const -> std::size_t;
+    [[nodiscard]] auto faces() const -> const spacecraft_face_list&;
+
+    // compute drag and/or srp torque+force (instantiated for drag+srp, drag only and srp only)
+    template <bool with_drag = true, bool with_srp = true>
     [[nodiscard]] auto compute_face_effects(const environment_effects& env, const quat& q_att, const quat& q_inv, const vec3& omega_body) const -> face_effects;
 
     // compute drag and srp torque+force
@@ -30,10 +55,27 @@ public:
 protected:
 
     void uniform(const spacecraft_uniform& shape);
+    void custom(const spacecraft_custom& shape, table_cache& tables);
+
+    // fill the structure-of-arrays copy from _faces
+    void pack();
 
 private:
 
-    spacecraft_face_array _faces;
+    spacecraft_face_list                          _faces;
+    std::shared_ptr<const face_coefficient_table> _table;  // optional, replaces the batched sums
+
+    // structure of arrays, padded to a multiple of batch_size
+    arrX _center_x;
+    arrX _center_y;
+    arrX _center_z;
+    arrX _normal_x;
+    arrX _normal_y;
+    arrX _normal_z;
+    arrX _drag_area;      // 0.5 * Cd * A
+    arrX _srp_sun_area;   // A * (1 - specular)
+    arrX _srp_spec_area;  // A * 2 * specular
+    arrX _srp_diff_area;  // A * 2/3 * diffuse
 };
 
 }  // namespace aos
@@ -1,5 +1,6 @@
 #include "spacecraft_shape.hpp"
 
+#include "aos/components/face_coefficient_table.hpp"
 #include "aos/core/constants.hpp"
 #include "aos/core/types.hpp"
 
@@ -48,13 +49,33 @@ void spacecraft_custom::from_toml(const toml_table& table) {
             vec->get(8)->value_or(default_spacecraft_size);
     }
 
+    faces.clear();
     if (const auto* arr = table["faces"].as_array()) {
-        for (size_t i = 0; i < faces.size(); ++i) {
+        faces.reserve(arr->size());
+        for (size_t i = 0; i < arr->size(); ++i) {
             if (const auto* face = arr->get(i)->as_table()) {
-                faces.at(i).from_toml(*face);
+                faces.emplace_back().from_toml(*face);
             }
         }
     }
+
+    meshes.clear();
+    if (const auto* arr = table["meshes"].as_array()) {
+        for (size_t i = 0; i < arr->size(); ++i) {
+            if (const auto* mesh = arr->get(i)->as_table()) {
+                auto& properties = meshes.emplace_back();
+                properties.from_toml(*mesh);
+
+                const auto facets = properties.load();
+                faces.insert(faces.end(), facets.begin(), facets.end());
+            }
+        }
+    }
+
+    face_table.reset();
+    if (const auto* face_table_table = table["face_table"].as_table()) {
+        face_table.emplace().from_toml(*face_table_table);
+    }
 }
 
 void spacecraft_custom::debug_print() const {
@@ -63,10 +84,23 @@ void spacecraft_custom::debug_print() const {
               << inertia(0) << ' ' << inertia(1) << ' ' << inertia(2) << "; "  //
               << inertia(3) << ' ' << inertia(4) << ' ' << inertia(5) << "; "  //
               << inertia(6) << ' ' << inertia(7) << ' ' << inertia(8)          //
+              << "\n  faces: " << faces.size()                                 //
               << '\n';
 
-    for (const auto& face : faces) {
-        face.debug_print();
+    for (const auto& mesh : meshes) {
+        mesh.debug_print();
+    }
+
+    if (face_table) {
+        face_table->debug_print();
+        face_coefficient_table::create(faces, *face_table)->debug_print();  // built table with its interpolation error
+    }
+
+    // mesh facets can number in the hundreds, only list hand-written face sets
+    if (meshes.empty()) {
+        for (const auto& face : faces) {
+            face.debug_print();
+        }
     }
 }
 
@@ -1,9 +1,13 @@
 #pragma once
 
+#include "aos/components/face_coefficient_table.hpp"
+#include "aos/components/face_mesh.hpp"
 #include "aos/components/spacecraft_face.hpp"
 #include "aos/core/types.hpp"
 
+#include <optional>
 #include <variant>
+#include <vector>
 
 namespace aos {
 
@@ -18,8 +22,10 @@ struct spacecraft_uniform {
 };
 
 struct spacecraft_custom {
-    mat3x3                inertia;
-    spacecraft_face_array faces;
+    mat3x3                               inertia;
+    spacecraft_face_list                 faces;         // explicit faces followed by the facets of all meshes
+    std::vector<face_mesh_properties>    meshes;        // meshes the facets were loaded from
+    std::optional<face_table_properties> face_table{};  // tabulate drag/srp over directions instead of per-face sums
 
     void from_toml(const toml_table& table);
     void debug_print() const;
@@ -0,0 +1,55 @@
+#include "table_cache.hpp"
+
+#include "aos/components/everett_table.hpp"
+#include "aos/components/face_coefficient_table.hpp"
+#include "aos/components/hysteresis_rod.hpp"
+#include "aos/components/hysteresis_table.hpp"
+#include "aos/components/spacecraft_face.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace aos {
+
+auto table_cache::hysteresis(const hysteresis_parameters& params) -> std::shared_ptr<const hysteresis_table> {
+    return find_or_build(_hysteresis, params, [&] { return hysteresis_table::create(params); });
+}
+
+auto table_cache::everett(const preisach_parameters& params) -> std::shared_ptr<const everett_table> {
+    return find_or_build(_everett, params, [&] { return everett_table::create(params); });
+}
+
+auto table_cache::face_coefficients(const spacecraft_face_list& faces, const face_table_properties& properties)
+    -> std::shared_ptr<const face_coefficient_table> {
+    const face_key key{.faces = faces, .properties = properties};
+    return find_or_build(_face_coefficients, key, [&] { return face_coefficient_table::create(faces, properties); });
+}
+
+template <typename key_type, typename table_type, typename build_type>
+auto table_cache::find_or_build(entry_list<key_type, table_type>& entries, const key_type& key, build_type&& build) -> std::shared_ptr<const table_type> {
+    std::promise<std::shared_ptr<const table_type>> promise;
+    {
+        std::unique_lock lock(_mutex);
+        if (const auto it = std::ranges::find(entries, key, &entry_list<key_type, table_type>::value_type::first); it != entries.end()) {
+            auto pending = it->second;
+            lock.unlock();
+            return pending.get();
+        }
+        entries.emplace_back(key, promise.get_future().share());
+    }
+
+    try {
+        auto table = std::forward<build_type>(build)();
+        promise.set_value(table);
+        return table;
+    } catch (...) {
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+}
+
+}  // namespace aos
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "aos/components/everett_table.hpp"
+#include "aos/components/face_coefficient_table.hpp"
+#include "aos/components/hysteresis_rod.hpp"
+#include "aos/components/hysteresis_table.hpp"
+#include "aos/components/spacecraft_face.hpp"
+
+#include <future>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace aos {
+
+/**
+ * @brief Immutable lookup tables shared by every spacecraft created with the same cache.
+ *
+ * Hysteresis, Everett and face coefficient tables depend only on a material or a face geometry. A batch creates many
+ * spacecraft from few distinct materials and shapes, so it passes one cache to all of them: each distinct table is built
+ * once by the first caller that needs it, concurrent callers asking for the same table wait for that build instead of
+ * repeating it. Tables stay cached for the lifetime of the cache, a failed build rethrows for every caller. Thread-safe.
+ */
+class table_cache {
+public:
+
+    table_cache(const table_cache&)                    = delete;
+    table_cache(table_cache&&)                         = delete;
+    auto operator=(const table_cache&) -> table_cache& = delete;
+    auto operator=(table_cache&&) -> table_cache&      = delete;
+
+    table_cache()  = default;
+    ~table_cache() = default;
+
+    // params.table must be set
+    [[nodiscard]] auto hysteresis(const hysteresis_parameters& params) -> std::shared_ptr<const hysteresis_table>;
+
+    [[nodiscard]] auto everett(const preisach_parameters& params) -> std::shared_ptr<const everett_table>;
+
+    [[nodiscard]] auto face_coefficients(const spacecraft_face_list& faces, const face_table_properties& properties)
+        -> std::shared_ptr<const face_coefficient_table>;
+
+protected:
+
+    template <typename table_type>
+    using pending_table = std::shared_future<std::shared_ptr<const table_type>>;
+
+    template <typename key_type, typename table_type>
+    using entry_list = std::vector<std::pair<key_type, pending_table<table_type>>>;
+
+    // returns the cached table for key, or builds it outside the lock while other callers for the same key wait
+    template <typename key_type, typename table_type, typename build_type>
+    [[nodiscard]] auto find_or_build(entry_list<key_type, table_type>& entries, const key_type& key, build_type&& build) -> std::shared_ptr<const table_type>;
+
+private:
+
+    struct face_key {
+        spacecraft_face_list  faces;
+        face_table_properties properties;
+
+        auto operator==(const face_key&) const -> bool = default;
+    };
+
+    std::mutex                                          _mutex;
+    entry_list<hysteresis_parameters, hysteresis_table> _hysteresis;
+    entry_list<preisach_parameters, everett_table>      _everett;
+    entry_list<face_key, face_coefficient_table>        _face_coefficients;
+};
+
+}  // namespace aos
@@ -0,0 +1,118 @@
+#include "ensemble_state.hpp"
+
+#include "aos/core/constants.hpp"
+#include "aos/core/state.hpp"
+#include "aos/core/types.hpp"
+
+#include <Eigen/Core>
+
+#include <cstddef>
+
+namespace aos {
+
+namespace {
+
+constexpr Eigen::Index attitude_rows         = 4;
+constexpr Eigen::Index angular_velocity_rows = 3;
+
+}  // namespace
+
+ensemble_state::ensemble_state(Eigen::Index num_lanes, Eigen::Index num_rods) {
+    resize(num_lanes, num_rods);
+}
+
+void ensemble_state::resize(Eigen::Index num_lanes, Eigen::Index num_rods) {
+    _num_lanes = num_lanes;
+    _num_rods  = num_rods;
+    _values.assign(static_cast<std::size_t>(orbit_size + ((attitude_rows + angular_velocity_rows + num_rods) * num_lanes)), 0.0);
+}
+
+auto ensemble_state::num_lanes() const -> Eigen::Index {
+    return _num_lanes;
+}
+
+auto ensemble_state::num_rods() const -> Eigen::Index {
+    return _num_rods;
+}
+
+auto ensemble_state::position_m() -> Eigen::Map<vec3> {
+    return Eigen::Map<vec3>(_values.data());
+}
+
+auto ensemble_state::position_m() const -> Eigen::Map<const vec3> {
+    return Eigen::Map<const vec3>(_values.data());
+}
+
+auto ensemble_state::velocity_m_s() -> Eigen::Map<vec3> {
+    return Eigen::Map<vec3>(_values.data() + 3);
+}
+
+auto ensemble_state::velocity_m_s() const -> Eigen::Map<const vec3> {
+    return Eigen::Map<const vec3>(_values.data() + 3);
+}
+
+auto ensemble_state::attitude() -> Eigen::Map<lane_array> {
+    return {_values.data() + orbit_size, attitude_rows, _num_lanes};
+}
+
+auto ensemble_state::attitude() const -> Eigen::Map<const lane_array> {
+    return {_values.data() + orbit_size, attitude_rows, _num_lanes};
+}
+
+auto ensemble_state::angular_velocity_m_s() -> Eigen::Map<lane_array> {
+    return {_values.data() + orbit_size + (attitude_rows * _num_lanes), angular_velocity_rows, _num_lanes};
+}
+
+auto ensemble_state::angular_velocity_m_s() const -> Eigen::Map<const lane_array> {
+    return {_values.data() + orbit_size + (attitude_rows * _num_lanes), angular_velocity_rows, _num_lanes};
+}
+
+auto ensemble_state::rod_magnetizations() -> Eigen::Map<lane_array> {
+    return {_values.data() + orbit_size + ((attitude_rows + angular_velocity_rows) * _num_lanes), _num_rods, _num_lanes};
+}
+
+auto ensemble_state::rod_magnetizations() const -> Eigen::Map<const lane_array> {
+    return {_values.data() + orbit_size + ((attitude_rows + angular_velocity_rows) * _num_lanes), _num_rods, _num_lanes};
+}
+
+auto ensemble_state::lane(Eigen::Index index) const -> system_state {
+    system_state state;
+    state.position_m           = position_m();
+    state.velocity_m_s         = velocity_m_s();
+    state.attitude.coeffs()    = attitude().col(index);
+    state.angular_velocity_m_s = angular_velocity_m_s().col(index);
+    state.rod_magnetizations   = rod_magnetizations().col(index);
+    return state;
+}
+
+void ensemble_state::set_lane(Eigen::Index index, const system_state& state) {
+    attitude().col(index)             = state.attitude.coeffs().array();
+    angular_velocity_m_s().col(index) = state.angular_velocity_m_s.array();
+    rod_magnetizations().col(index)   = state.rod_magnetizations.array();
+}
+
+auto ensemble_state::altitude_m() const -> real {
+    return position_m().norm() - earth_radius_m;
+}
+
+auto ensemble_state::lane_has_nan(Eigen::Index index) const -> bool {
+    return attitude().col(index).hasNaN() || angular_velocity_m_s().col(index).hasNaN() || rod_magnetizations().col(index).hasNaN();
+}
+
+auto ensemble_state::begin() -> iterator {
+    return _values.data();
+}
+
+auto ensemble_state::end() -> iterator {
+    return _values.data() + _values.size();
+}
+
+auto ensemble_state::begin() const -> const_iterator {
+    return _values.data();
+}
+
+auto ensemble_state::end() const -> const_iterator {
+    return _values.data() + _values.size();
+}
+
+}  // namespace aos
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "aos/core/state.hpp"
+#include "aos/core/types.hpp"
+
+#include <boost/numeric/odeint.hpp>
+#include <boost/numeric/odeint/util/is_resizeable.hpp>
+#include <boost/numeric/odeint/util/resize.hpp>
+#include <boost/numeric/odeint/util/same_size.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+
+#include <Eigen/Core>
+
+#include <vector>
+
+namespace aos {
+
+using lane_array = Eigen::Array<real, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;  // [component][lane]
+
+/**
+ * @brief Integrated state of an ensemble of spacecraft variants flying the same orbit.
+ *
+ * The orbit is stored once; attitude, angular velocity and rod magnetizations are structure-of-arrays with one row per
+ * component and one column per member (lane), so every row is contiguous across lanes and the right-hand side
+ * vectorizes over the members. Attitude rows follow Eigen's quaternion coefficient order (x, y, z, w).
+ *
+ * Everything lives in one buffer exposed as a range of scalars, integrated with odeint's range_algebra: the stepper
+ * updates it in place, element by element, without the temporaries of the vector-space operations. The accessors
+ * return maps into the buffer. The error norm of the range algebra is the maximum over all lanes (worst-lane error
+ * control) and skips NaN entries, so a lane that diverged does not stall the step size of the others.
+ */
+class ensemble_state {
+public:
+
+    static constexpr Eigen::Index orbit_size = 6;   // position and velocity
+    static constexpr Eigen::Index max_lanes  = 64;  // bound for the fixed-capacity lane rows of the right-hand side
+
+    using value_type     = real;
+    using iterator       = real*;
+    using const_iterator = const real*;
+
+    ensemble_state() = default;
+    ensemble_state(Eigen::Index num_lanes, Eigen::Index num_rods);
+
+    void resize(Eigen::Index num_lanes, Eigen::Index num_rods);
+
+    [[nodiscard]] auto num_lanes() const -> Eigen::Index;
+    [[nodiscard]] auto num_rods() const -> Eigen::Index;
+
+    // [m] shared position in ECI
+    [[nodiscard]] auto position_m() -> Eigen::Map<vec3>;
+    [[nodiscard]] auto position_m() const -> Eigen::Map<const vec3>;
+
+    // [m/s] shared velocity in ECI
+    [[nodiscard]] auto velocity_m_s() -> Eigen::Map<vec3>;
+    [[nodiscard]] auto velocity_m_s() const -> Eigen::Map<const vec3>;
+
+    // [-] 4 x lanes, body-to-ECI
+    [[nodiscard]] auto attitude() -> Eigen::Map<lane_array>;
+    [[nodiscard]] auto attitude() const -> Eigen::Map<const lane_array>;
+
+    // [rad/s] 3 x lanes, body frame
+    [[nodiscard]] auto angular_velocity_m_s() -> Eigen::Map<lane_array>;
+    [[nodiscard]] auto angular_velocity_m_s() const -> Eigen::Map<const lane_array>;
+
+    // [A/m] rods x lanes
+    [[nodiscard]] auto rod_magnetizations() -> Eigen::Map<lane_array>;
+    [[nodiscard]] auto rod_magnetizations() const -> Eigen::Map<const lane_array>;
+
+    // single-member view of a lane and its inverse (the orbit is left unchanged)
+    [[nodiscard]] auto lane(Eigen::Index index) const -> system_state;
+    void set_lane(Eigen::Index index, const system_state& state);
+
+    [[nodiscard]] auto altitude_m() const -> real;
+    [[nodiscard]] auto lane_has_nan(Eigen::Index index) const -> bool;
+
+    [[nodiscard]] auto begin() -> iterator;
+    [[nodiscard]] auto end() -> iterator;
+    [[nodiscard]] auto begin() const -> const_iterator;
+    [[nodiscard]] auto end() const -> const_iterator;
+
+private:
+
+    std::vector<real> _values;  // orbit, then attitude, angular velocity and rod rows
+    Eigen::Index      _num_lanes{};
+    Eigen::Index      _num_rods{};
+};
+
+}  // namespace aos
+
+namespace boost::numeric::odeint {
+
+template <>
+struct is_resizeable<aos::ensemble_state> : boost::true_type {};
+
+template <>
+struct same_size_impl<aos::ensemble_state, aos::ensemble_state> {
+    static auto same_size(const aos::ensemble_state& s1, const aos::ensemble_state& s2) -> bool {
+        return s1.num_lanes() == s2.num_lanes() && s1.num_rods() == s2.num_rods();
+    }
+};
+
+template <>
+struct resize_impl<aos::ensemble_state, aos::ensemble_state> {
+    static void resize(aos::ensemble_state& s1, const aos::ensemble_state& s2) {
+        s1.resize(s2.num_lanes(), s2.num_rods());
+    }
+};
+
+}  // namespace boost::numeric::odeint
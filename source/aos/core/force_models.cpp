@@ -0,0 +1,31 @@
+#include "force_models.hpp"
+
+#include "aos/core/types.hpp"
+
+#include <toml++/toml.hpp>
+
+#include <iostream>
+
+namespace aos {
+
+void force_model_set::from_toml(const toml_table& table) {
+    magnet           = table["magnet"].value_or(true);
+    rods             = table["rods"].value_or(true);
+    gravity_gradient = table["gravity_gradient"].value_or(true);
+    drag             = table["drag"].value_or(true);
+    srp              = table["srp"].value_or(true);
+    third_body       = table["third_body"].value_or(true);
+}
+
+void force_model_set::debug_print() const {
+    std::cout << "--  force models  --"                        //
+              << "\n  magnet:           " << magnet            //
+              << "\n  rods:             " << rods              //
+              << "\n  gravity gradient: " << gravity_gradient  //
+              << "\n  drag:             " << drag              //
+              << "\n  srp:              " << srp               //
+              << "\n  third body:       " << third_body        //
+              << '\n';
+}
+
+}  // namespace aos
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "aos/core/types.hpp"
+
+#include <cstddef>
+
+namespace aos {
+
+/**
+ * @brief Force and torque models included in the equations of motion (`[models]` table).
+ *
+ * The set is a template argument of the dynamics: every combination is its own specialization, so a disabled model is
+ * compiled out of the right-hand side (no branch) and the environment skips the inputs only that model needs. Earth
+ * gravity and the gyroscopic torque are part of the rigid-body equations and always included.
+ */
+struct force_model_set {
+    static constexpr std::size_t num_models = 6;
+    static constexpr std::size_t num_sets   = std::size_t{1} << num_models;
+
+    bool magnet{true};            // [-] Permanent magnet torque
+    bool rods{true};              // [-] Hysteresis rod torque and magnetization dynamics
+    bool gravity_gradient{true};  // [-] Gravity gradient torque
+    bool drag{true};              // [-] Aerodynamic force and torque
+    bool srp{true};               // [-] Solar radiation pressure force and torque
+    bool third_body{true};        // [-] Solar third-body acceleration
+
+    [[nodiscard]] constexpr auto needs_magnetic_field() const -> bool {
+        return magnet || rods;
+    }
+
+    [[nodiscard]] constexpr auto needs_faces() const -> bool {
+        return drag || srp;
+    }
+
+    // bit i of the index is the i-th model in declaration order
+    [[nodiscard]] constexpr auto index() const -> std::size_t {
+        // NOLINTBEGIN(readability-magic-numbers)
+        return (magnet ? 1U : 0U) | (rods ? 2U : 0U) | (gravity_gradient ? 4U : 0U)  //
+               | (drag ? 8U : 0U) | (srp ? 16U : 0U) | (third_body ? 32U : 0U);
+        // NOLINTEND(readability-magic-numbers)
+    }
+
+    [[nodiscard]] static constexpr auto from_index(std::size_t index) -> force_model_set {
+        // NOLINTBEGIN(readability-magic-numbers)
+        return {
+            .magnet           = (index & 1U) != 0,
+            .rods             = (index & 2U) != 0,
+            .gravity_gradient = (index & 4U) != 0,
+            .drag             = (index & 8U) != 0,
+            .srp              = (index & 16U) != 0,
+            .third_body       = (index & 32U) != 0,
+        };
+        // NOLINTEND(readability-magic-numbers)
+    }
+
+    void from_toml(const toml_table& table);
+    void debug_print() const;
+};
+
+}  // namespace aos
@@ -0,0 +1,138 @@
+#include "langevin.hpp"
+
+#include "aos/core/types.hpp"
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace aos {
+
+namespace {
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+// Pade approximant of L(x)/x in t = x^2, from x / (3 + t / (5 + t / (7 + ... + t / 15)))
+constexpr real pade_p0 = 1.0 / 3.0;
+constexpr real pade_p1 = 1.0 / 45.0;
+constexpr real pade_p2 = 2.0 / 6825.0;
+constexpr real pade_p3 = 1.0 / 2027025.0;
+constexpr real pade_q1 = 2.0 / 15.0;
+constexpr real pade_q2 = 2.0 / 585.0;
+constexpr real pade_q3 = 4.0 / 225225.0;
+
+constexpr real pade_limit      = 1.0;
+constexpr real asymptote_limit = 16.0;
+
+struct langevin_segment {
+    real                center;          // segment midpoint
+    real                inv_half_width;  // maps the segment onto s in [-1, 1]
+    std::array<real, 9> coefficients;    // x*L(x) = sum(c_i * s^i)
+};
+
+// Segment (4 * octave + quarter) covers 2^octave * [1 + quarter/4, 1 + (quarter + 1)/4), together [1, 16)
+// clang-format off
+constexpr std::array<langevin_segment, 16> langevin_segments{{
+    {1.125, 8, {0.39008836318418133, 0.0803741895249033, 0.0032108638267864895, -0.0001100978908271722, 2.8183943151653619e-07, 1.2798522644360192e-07, -3.8156920266177145e-09, -7.6652905184480966e-11, 7.2733836700391817e-12}},
+    {1.375, 8, {0.56280776719310854, 0.0919149681812787, 0.00256632489136365, -0.00010336458231870501, 1.3190856121040302e-06, 7.8823377798329898e-08, -4.1456983530884725e-09, 2.223178200175566e-11, 4.8130350014139213e-12}},
+    {1.625, 8, {0.75609945288592029, 0.10098762803536625, 0.0019831293583734287, -9.0301926662594262e-05, 1.8695984814442569e-06, 3.2781110386270585e-08, -3.4065190647084327e-09, 7.4452252619212123e-11, 1.7774826749361594e-12}},
+    {1.875, 8, {0.96531556547573427, 0.10789835290497161, 0.0014880458364446255, -7.4534659708067337e-05, 2.0153697243561491e-06, -1.3029296369631818e-09, -2.2528277422563372e-09, 8.4064890465418429e-11, -3.777553115992384e-13}},
+    {2.25, 4, {1.300552067161185, 0.23005691704915435, 0.0036935648797203988, -0.00041163802343568263, 2.8272366169043003e-05, -8.69846115107458e-07, -4.6040203102880472e-08, 7.3586193469662069e-09, -3.7356957419440761e-10}},
+    {2.75, 4, {1.7725694792145876, 0.2407207238307183, 0.0018259152810368425, -0.00022416169530146688, 1.8460451901832164e-05, -9.665713766069149e-07, 1.7528059692341797e-08, 2.1406882871271509e-09, -2.3929142849309237e-10}},
+    {3.25, 4, {2.2597870690174995, 0.24585194874467947, 0.00085192281451811948, -0.00011151993196390413, 1.0215549586588962e-05, -6.636827783838839e-07, 2.7545796185690641e-08, -2.1422023568609363e-10, -7.0589393898047428e-11}},
+    {3.75, 4, {2.7541504283131384, 0.24820033266056218, 0.00038124098898128427, -5.2158180588567508e-05, 5.1114566117333437e-06, -3.7289266455495547e-07, 1.9930963133765435e-08, -6.7022749695845441e-10, -5.2684708447732951e-14}},
+    {4.5, 2, {3.5011108253235155, 0.49901246261192372, 0.00043217806509202847, -0.00012356221367155798, 2.5781489560728175e-05, -4.1399339353498067e-06, 5.223728317497548e-07, -5.1312297115006324e-08, 3.5074830015721954e-09}},
+    {5.5, 2, {4.5001837217771588, 0.49983297713739744, 7.5163232532336172e-05, -2.2272512346611774e-05, 4.8730055852870087e-06, -8.3555750584083129e-07, 1.1617395101316665e-07, -1.3521593496114271e-08, 1.2664308552463095e-09}},
+    {6.5, 2, {5.5000293843487089, 0.49997287592027578, 1.2431934290651265e-05, -3.7673058436384232e-06, 8.4766188123558406e-07, -1.5066040101018494e-07, 2.1976776818119802e-08, -2.7486877141664263e-09, 2.8483806517135929e-10}},
+    {7.5, 2, {6.5000045885362114, 0.49999571736497955, 1.988367688387385e-06, -6.1180872832533288e-07, 1.4020624097755347e-07, -2.5483531853393643e-08, 3.8231606322127991e-09, -4.9707397148996479e-10, 5.4070032402048836e-11}},
+    {9, 1, {8.000000274139639, 0.99999948218791634, 4.8735811138547132e-07, -3.0469602108487089e-07, 1.4216344831665303e-07, -5.2452253054064488e-08, 1.6184655850083452e-08, -4.7087774821294755e-09, 1.0470356711274793e-09}},
+    {11, 1, {10.00000000613683, 0.99999998828442671, 1.1157837188527672e-08, -7.0692163889638256e-09, 3.3478296261756233e-09, -1.2553852255576321e-09, 3.9504884548809588e-10, -1.1832316299593199e-10, 2.7002936923518444e-11}},
+    {13, 1, {12.000000000132836, 0.99999999974455012, 2.4523534302804223e-10, -1.5674026081676415e-10, 7.4944989257740166e-11, -2.8390684864771427e-11, 9.0415853816318125e-12, -2.7546792007942461e-12, 6.3796807343092295e-13}},
+    {15, 1, {14.000000000002807, 0.99999999999457267, 5.2401649763216757e-12, -3.3701089758370667e-12, 1.6225416072441273e-12, -6.1890153495940895e-13, 1.9837526683059222e-13, -6.1191792373923207e-14, 1.4408227697357586e-14}},
+}};
+// clang-format on
+
+// NOLINTEND(readability-magic-numbers)
+
+auto segment_index(real abs_x) -> std::size_t {
+    // biased exponent and two leading mantissa bits: (1023 << 2) for x = 1.0
+    static constexpr uint64_t mantissa_shift = 50;
+    static constexpr uint64_t index_bias     = 1023U << 2U;
+    return static_cast<std::size_t>((std::bit_cast<uint64_t>(abs_x) >> mantissa_shift) - index_bias);
+}
+
+}  // namespace
+
+auto langevin_exact(real x) -> real {
+    // numerical stability for langevin function near zero
+    if (std::abs(x) < langevin_exact_cutoff) {
+        // taylor expansion: L(x) approx x/3 - x^3/45
+        return x / 3.0;  // NOLINT(readability-magic-numbers)
+    }
+
+    // langevin: L(x) = coth(x) - 1/x
+    return (1.0 / std::tanh(x)) - (1.0 / x);
+}
+
+auto langevin_fast(real x) -> real {
+    const real abs_x = std::abs(x);
+
+    if (abs_x < pade_limit) {
+        const real t = x * x;
+        const real p = pade_p0 + (t * (pade_p1 + (t * (pade_p2 + (t * pade_p3)))));
+        const real q = 1.0 + (t * (pade_q1 + (t * (pade_q2 + (t * pade_q3)))));
+        return x * p / q;
+    }
+
+    // NaN fails every comparison and must not reach the segment lookup, it propagates through sign(x) - 1/x
+    if (not(abs_x < asymptote_limit)) {
+        return std::copysign(1.0, x) - (1.0 / x);
+    }
+
+    // x*L(x) is even, dividing by signed x restores odd symmetry
+    const auto& segment = langevin_segments[segment_index(abs_x)];
+    const real  s       = (abs_x - segment.center) * segment.inv_half_width;
+    const auto& c       = segment.coefficients;
+
+    real poly = c.back();
+    for (auto i = c.size() - 1; i-- > 0;) {
+        poly = (poly * s) + c[i];
+    }
+    return poly / x;
+}
+
+auto langevin(real x, langevin_evaluator evaluator) -> real {
+    switch (evaluator) {
+        case langevin_evaluator_exact:
+            return langevin_exact(x);
+        case langevin_evaluator_fast:
+            return langevin_fast(x);
+    }
+    return langevin_fast(x);
+}
+
+auto langevin_evaluator_from_string(std::string_view name) -> langevin_evaluator {
+    if (name == "exact") {
+        return langevin_evaluator_exact;
+    }
+    if (name == "fast") {
+        return langevin_evaluator_fast;
+    }
+    throw std::invalid_argument("unknown langevin evaluator: " + std::string(name));
+}
+
+auto langevin_evaluator_to_string(langevin_evaluator evaluator) -> std::string_view {
+    switch (evaluator) {
+        case langevin_evaluator_exact:
+            return "exact";
+        case langevin_evaluator_fast:
+            return "fast";
+    }
+    return "unknown";
+}
+
+}  // namespace aos
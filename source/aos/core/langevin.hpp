@@ -0,0 +1,47 @@
+#pragma once
+
+#include "aos/core/types.hpp"
+
+#include <cstdint>
+#include <string_view>
+
+namespace aos {
+
+enum langevin_evaluator : uint8_t {
+    langevin_evaluator_exact,  //!< coth(x) - 1/x via std::tanh (reference implementation)
+    langevin_evaluator_fast,   //!< piecewise rational/polynomial approximation
+};
+
+/**
+ * @brief Langevin function L(x) = coth(x) - 1/x using std::tanh.
+ *
+ * Below langevin_exact_cutoff the first Taylor term x/3 is used. Loses precision for small |x| due to cancellation.
+ */
+[[nodiscard]] auto langevin_exact(real x) -> real;
+
+/**
+ * @brief Fast Langevin function L(x) = coth(x) - 1/x with bounded error.
+ *
+ * - |x| < 1:       Pade approximant [3/3] in x^2 (Lambert continued fraction truncated at depth 7)
+ * - 1 <= |x| < 16: x*L(x) from degree-8 Chebyshev (near-minimax) polynomials on 16 quarter-octave segments
+ * - |x| >= 16:     asymptotic form sign(x) - 1/x (neglected term 2*exp(-2|x|))
+ *
+ * Max relative error over the whole real line is below langevin_fast_max_relative_error.
+ */
+[[nodiscard]] auto langevin_fast(real x) -> real;
+
+/**
+ * @brief Langevin function using the selected evaluator.
+ */
+[[nodiscard]] auto langevin(real x, langevin_evaluator evaluator) -> real;
+
+// Bound on |L_fast(x) - L(x)| / |L(x)| (measured maximum: 1.39e-13 at |x| = 8)
+inline constexpr real langevin_fast_max_relative_error = 2e-13;
+
+// Below this |x| the exact evaluator switches to the linear Taylor term
+inline constexpr real langevin_exact_cutoff = 1e-6;
+
+[[nodiscard]] auto langevin_evaluator_from_string(std::string_view name) -> langevin_evaluator;
+[[nodiscard]] auto langevin_evaluator_to_string(langevin_evaluator evaluator) -> std::string_view;
+
+}  // namespace aos
@@ -17,6 +17,7 @@ using quat   = Eigen::Quaternion<real>;
 using vec3   = Eigen::Matrix<real, 3, 1>;
 using vec4   = Eigen::Matrix<real, 4, 1>;
 using vecX   = Eigen::VectorX<real>;
+using arrX   = Eigen::ArrayX<real>;
 using aaxis  = Eigen::AngleAxis<real>;
 // NOLINTEND
 
@@ -1,9 +1,11 @@
 #include "environment_impl.hpp"
 
 #include "aos/core/constants.hpp"
+#include "aos/core/force_models.hpp"
 #include "aos/core/types.hpp"
 #include "aos/environment/environment.hpp"
 #include "aos/environment/nrlmsise.hpp"
+#include "aos/environment/space_weather.hpp"
 
 #include <GeographicLib/Constants.hpp>
 #include <GeographicLib/Geocentric.hpp>
@@ -11,82 +13,82 @@
 #include <GeographicLib/MagneticModel.hpp>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
+#include <memory>
 #include <print>
+#include <utility>
 #include <vector>
 
 namespace aos {
 
-// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-environment_impl::environment_impl(const environment_properties& properties)
-    : _start_year_decimal(properties.start_year_decimal),
-      _earth(GeographicLib::Constants::WGS84_a(), GeographicLib::Constants::WGS84_f()),
-      _gravity_model(properties.gravity_model_name, properties.gravity_model_path, properties.gravity_model_degree, properties.gravity_model_order),
-      _magnetic_model(properties.magnetic_model_name,
-                      properties.magnetic_model_path,
-                      GeographicLib::Geocentric::WGS84(),
-                      properties.magnetic_model_degree,
-                      properties.magnetic_model_order),
-      _atmospheric_model(properties.weather_data_path) {
-    if (_start_year_decimal < 1900.0 || _start_year_decimal > 2100.0) {  // NOLINT(readability-magic-numbers)
-        std::println(stderr, "Warning: Magnetic model year {} may be outside valid range", _start_year_decimal);
-    }
+environment_impl::environment_impl(const environment_properties& properties) : environment_impl(load_models(properties)) {}
 
+environment_impl::environment_impl(loaded_models models)
+    : _models(std::move(models)),
+      _start_year_decimal(_models.start_year_decimal),
+      _earth(GeographicLib::Constants::WGS84_a(), GeographicLib::Constants::WGS84_f()),
+      _gravity_model(*_models.gravity),
+      _magnetic_model(*_models.magnetic),
+      _atmospheric_model(_models.weather) {
     const auto rotation_matrix_size = 3 * 3;
     _cache.rotation_matrix_buffer.resize(rotation_matrix_size, 0.0);
-
-    std::println("Magnetic model: {} (from {}, degree {}, order {})",  //
-                 _magnetic_model.MagneticModelName(),                  //
-                 _magnetic_model.MagneticModelDirectory(),             //
-                 _magnetic_model.Degree(),                             //
-                 _magnetic_model.Order());
-    std::println("Gravity model: {} (from {}, degree {}, order {})",  //
-                 _gravity_model.GravityModelName(),                   //
-                 _gravity_model.GravityModelDirectory(),              //
-                 _gravity_model.Degree(),                             //
-                 _gravity_model.Order());
 }
 
 environment_impl::~environment_impl() = default;
 
 auto environment_impl::compute_effects(real t_sec, const vec3& r_eci_m, const vec3& v_eci_m_s) const -> environment_effects {
-    // compute fields at current position
-    cache_transform(t_sec, r_eci_m);
+    return compute_effects_for<force_model_set{}>(t_sec, r_eci_m, v_eci_m_s);
+}
 
-    const auto b       = magnetic_field();
-    const auto d       = atmospheric_density();
-    const auto g_earth = gravitational_field();
-    const auto g_sun   = solar_perturbation(r_eci_m, _cache.r_sun_eci);
-    const auto v_rel   = earth_relative_v(v_eci_m_s, r_eci_m);
-    const auto g_total = g_earth + g_sun;
+auto environment_impl::compute_effects_for(const force_model_set& models, real t_sec, const vec3& r_eci_m, const vec3& v_eci_m_s) const
+    -> environment_effects {
+    using effects_function = auto (environment_impl::*)(real, const vec3&, const vec3&) const -> environment_effects;
 
-    const vec3& r_sun    = _cache.r_sun_eci;
-    const real  d_sun_sq = r_sun.squaredNorm();
-    const real  pressure = solar_pressure_1au * (au_to_m_2 / d_sun_sq);
-    const real  shadow   = earth_shadow_factor(r_eci_m, r_sun);
-    const real  earth_mu = _gravity_model.MassConstant();
+    // one specialization per model set, indexed by force_model_set::index()
+    static constexpr auto functions = []<std::size_t... indices>(std::index_sequence<indices...> /*sets*/) {
+        return std::array<effects_function, sizeof...(indices)>{&environment_impl::compute_effects_for<force_model_set::from_index(indices)>...};
+    }(std::make_index_sequence<force_model_set::num_sets>{});
 
-    // compute fields at future position for gradient calculation
-    const real t_next = t_sec + dt_gradient;
-    const vec3 r_next = r_eci_m + (v_eci_m_s * dt_gradient);
-    cache_transform(t_next, r_next);
+    return (this->*functions.at(models.index()))(t_sec, r_eci_m, v_eci_m_s);
+}
 
-    const auto b_next = magnetic_field();
+auto environment_impl::clone() const -> std::shared_ptr<environment> {
+    return std::make_shared<environment_impl>(_models);
+}
 
-    // compute derivative
-    const vec3 db_dt = (b_next - b) / dt_gradient;
+auto environment_impl::load_models(const environment_properties& properties) -> loaded_models {
+    if (properties.start_year_decimal < 1900.0 || properties.start_year_decimal > 2100.0) {  // NOLINT(readability-magic-numbers)
+        std::println(stderr, "Warning: Magnetic model year {} may be outside valid range", properties.start_year_decimal);
+    }
 
-    return {
-        .magnetic_field_eci_T       = b,
-        .magnetic_field_dot_eci_T_s = db_dt,
-        .gravity_eci_m_s2           = g_total,
-        .atmospheric_density_kg_m3  = d,
-        .r_sun_eci                  = r_sun,
-        .v_earth_rel                = v_rel,
-        .shadow_factor              = shadow,
-        .solar_pressure_Pa          = pressure,
-        .earth_mu                   = earth_mu,
+    loaded_models models{
+        .start_year_decimal = properties.start_year_decimal,
+        .gravity            = std::make_shared<const GeographicLib::GravityModel>(properties.gravity_model_name,
+                                                                       properties.gravity_model_path,
+                                                                       properties.gravity_model_degree,
+                                                                       properties.gravity_model_order),
+        .magnetic           = std::make_shared<const GeographicLib::MagneticModel>(properties.magnetic_model_name,
+                                                                         properties.magnetic_model_path,
+                                                                         GeographicLib::Geocentric::WGS84(),
+                                                                         properties.magnetic_model_degree,
+                                                                         properties.magnetic_model_order),
+        .weather            = std::make_shared<const space_weather>(space_weather_parser{}.parse(properties.weather_data_path)),
     };
+
+    std::println("Magnetic model: {} (from {}, degree {}, order {})",  //
+                 models.magnetic->MagneticModelName(),                 //
+                 models.magnetic->MagneticModelDirectory(),            //
+                 models.magnetic->Degree(),                            //
+                 models.magnetic->Order());
+    std::println("Gravity model: {} (from {}, degree {}, order {})",  //
+                 models.gravity->GravityModelName(),                  //
+                 models.gravity->GravityModelDirectory(),             //
+                 models.gravity->Degree(),                            //
+                 models.gravity->Order());
+
+    return models;
 }
 
 void environment_impl::cache_transform(real t_sec, const vec3& r_eci_m) const {
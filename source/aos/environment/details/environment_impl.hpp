@@ -1,18 +1,22 @@
 #pragma once
 
+#include "aos/core/constants.hpp"
+#include "aos/core/force_models.hpp"
 #include "aos/core/types.hpp"
 #include "aos/environment/environment.hpp"
 #include "aos/environment/nrlmsise.hpp"
+#include "aos/environment/space_weather.hpp"
 
 #include <GeographicLib/Geocentric.hpp>
 #include <GeographicLib/GravityModel.hpp>
 #include <GeographicLib/MagneticModel.hpp>
 
+#include <memory>
 #include <vector>
 
 namespace aos {
 
-class environment_impl : public environment {
+class environment_impl final : public environment {
 public:
 
     environment_impl(const environment_impl&)                    = delete;
@@ -20,10 +24,27 @@ public:
     auto operator=(const environment_impl&) -> environment_impl& = delete;
     auto operator=(environment_impl&&) -> environment_impl&      = delete;
 
+    // loaded once and only read afterwards, safe to evaluate from several threads
+    struct loaded_models {
+        real                                                start_year_decimal;
+        std::shared_ptr<const GeographicLib::GravityModel>  gravity;
+        std::shared_ptr<const GeographicLib::MagneticModel> magnetic;
+        std::shared_ptr<const space_weather>                weather;
+    };
+
     explicit environment_impl(const environment_properties& properties);
+    explicit environment_impl(loaded_models models);
     ~environment_impl() override;
 
     [[nodiscard]] auto compute_effects(real t_sec, const vec3& r_eci_m, const vec3& v_eci_m_s) const -> environment_effects override;
+    [[nodiscard]] auto clone() const -> std::shared_ptr<environment> override;
+
+    // effects needed by the given force models only, the inputs of disabled models are left zero
+    template <force_model_set models>
+    [[nodiscard]] auto compute_effects_for(real t_sec, const vec3& r_eci_m, const vec3& v_eci_m_s) const -> environment_effects;
+
+    // same, with the model set chosen at run time
+    [[nodiscard]] auto compute_effects_for(const force_model_set& models, real t_sec, const vec3& r_eci_m, const vec3& v_eci_m_s) const -> environment_effects;
 
 protected:
 
@@ -59,6 +80,8 @@ protected:
     /** Cache coordinate transformation results and matrices */
     void cache_transform(real t_sec, const vec3& r_eci_m) const;
 
+    [[nodiscard]] static auto load_models(const environment_properties& properties) -> loaded_models;
+
     [[nodiscard]] static auto earth_relative_v(const vec3& v_eci_m_s, const vec3& r_eci_m) -> vec3;
 
     [[nodiscard]] static auto sun_position_eci(real days_since_j2000) -> vec3;
@@ -69,12 +92,69 @@ protected:
 
 private:
 
-    real                         _start_year_decimal;
-    mutable computation_cache    _cache;
-    GeographicLib::Geocentric    _earth;
-    GeographicLib::GravityModel  _gravity_model;
-    GeographicLib::MagneticModel _magnetic_model;
-    nrlmsise                     _atmospheric_model;
+    loaded_models                       _models;
+    real                                _start_year_decimal;
+    mutable computation_cache           _cache;
+    GeographicLib::Geocentric           _earth;
+    const GeographicLib::GravityModel&  _gravity_model;
+    const GeographicLib::MagneticModel& _magnetic_model;
+    nrlmsise                            _atmospheric_model;  // own input/output buffers around the shared weather data
 };
 
+template <force_model_set models>
+auto environment_impl::compute_effects_for(real t_sec, const vec3& r_eci_m, const vec3& v_eci_m_s) const -> environment_effects {
+    environment_effects effects{
+        .magnetic_field_eci_T       = vec3::Zero(),
+        .magnetic_field_dot_eci_T_s = vec3::Zero(),
+        .gravity_eci_m_s2           = vec3::Zero(),
+        .atmospheric_density_kg_m3  = 0.0,
+        .r_sun_eci                  = vec3::Zero(),
+        .v_earth_rel                = vec3::Zero(),
+        .shadow_factor              = 0.0,
+        .solar_pressure_Pa          = 0.0,
+        .earth_mu                   = _gravity_model.MassConstant(),
+    };
+
+    // compute fields at current position
+    cache_transform(t_sec, r_eci_m);
+
+    const vec3& r_sun = _cache.r_sun_eci;
+    effects.r_sun_eci = r_sun;
+
+    if constexpr (models.drag) {
+        effects.atmospheric_density_kg_m3 = atmospheric_density();
+        effects.v_earth_rel               = earth_relative_v(v_eci_m_s, r_eci_m);
+    }
+
+    const auto g_earth = gravitational_field();
+    if constexpr (models.third_body) {
+        effects.gravity_eci_m_s2 = g_earth + solar_perturbation(r_eci_m, r_sun);
+    } else {
+        effects.gravity_eci_m_s2 = g_earth;
+    }
+
+    if constexpr (models.srp) {
+        const real d_sun_sq       = r_sun.squaredNorm();
+        effects.solar_pressure_Pa = solar_pressure_1au * (au_to_m_2 / d_sun_sq);
+        effects.shadow_factor     = earth_shadow_factor(r_eci_m, r_sun);
+    }
+
+    if constexpr (models.needs_magnetic_field()) {
+        const auto b = magnetic_field();
+
+        // compute fields at future position for gradient calculation
+        const real t_next = t_sec + dt_gradient;
+        const vec3 r_next = r_eci_m + (v_eci_m_s * dt_gradient);
+        cache_transform(t_next, r_next);
+
+        const auto b_next = magnetic_field();
+
+        // compute derivative
+        effects.magnetic_field_eci_T       = b;
+        effects.magnetic_field_dot_eci_T_s = (b_next - b) / dt_gradient;
+    }
+
+    return effects;
+}
+
 }  // namespace aos
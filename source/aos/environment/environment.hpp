@@ -51,6 +51,9 @@ public:
     // compute environmental effects
     [[nodiscard]] virtual auto compute_effects(real t_sec, const vec3& r_eci_m, const vec3& v_eci_m_s) const -> environment_effects = 0;
 
+    // instance for another thread, loaded models are shared and only the evaluation scratch state is duplicated
+    [[nodiscard]] virtual auto clone() const -> std::shared_ptr<environment> = 0;
+
     static auto create(const environment_properties& properties) -> std::shared_ptr<environment>;
 };
 
@@ -7,10 +7,14 @@
 #include <cmath>
 #include <cstddef>
 #include <filesystem>
+#include <memory>
+#include <utility>
 
 namespace aos {
 
-nrlmsise::nrlmsise(const std::filesystem::path& filepath) : weather(space_weather_parser{}.parse(filepath)) {
+nrlmsise::nrlmsise(const std::filesystem::path& filepath) : nrlmsise(std::make_shared<const space_weather>(space_weather_parser{}.parse(filepath))) {}
+
+nrlmsise::nrlmsise(std::shared_ptr<const space_weather> weather_data) : weather(std::move(weather_data)) {
     // NOLINTBEGIN
     for (size_t i = 0; i < 24; ++i) {
         flags.switches[i] = 1;
@@ -34,7 +38,7 @@ auto nrlmsise::density_at(real year_decimal, real lat_deg, real lon_deg, real al
     const bool  is_leap               = (year % 4 == 0 && (year % 100 != 0 || year % 400 == 0));
     const real  days_in_year          = is_leap ? 366.0 : 365.0;
     const real  total_seconds_in_year = (year_decimal - year) * days_in_year * 86400.0;
-    const auto& data                  = weather.get_linear_month_at(year_decimal);
+    const auto& data                  = weather->get_linear_month_at(year_decimal);
 
     // NOLINTBEGIN(readability-magic-numbers)
     input.doy    = static_cast<int>(std::floor(total_seconds_in_year / 86400.0)) + 1;
@@ -5,6 +5,7 @@
 
 #include <cstddef>
 #include <filesystem>
+#include <memory>
 
 extern "C" {
 #include <nrlmsise-00.h>
@@ -13,13 +14,14 @@ extern "C" {
 namespace aos {
 
 struct nrlmsise {
-    mutable nrlmsise_input  input{};
-    mutable nrlmsise_flags  flags{};
-    mutable nrlmsise_output output{};
-    space_weather           weather{};
-    mutable size_t          hint{};
+    mutable nrlmsise_input               input{};
+    mutable nrlmsise_flags               flags{};
+    mutable nrlmsise_output              output{};
+    std::shared_ptr<const space_weather> weather;  // read-only, shared between instances
+    mutable size_t                       hint{};
 
     explicit nrlmsise(const std::filesystem::path& filepath);
+    explicit nrlmsise(std::shared_ptr<const space_weather> weather_data);
 
     // compute atmospheric density at a specific spacetime point
     [[nodiscard]] auto density_at(real year_decimal, real lat_deg, real lon_deg, real alt_m) const -> real;
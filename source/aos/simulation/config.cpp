@@ -33,6 +33,14 @@ void simulation_properties::from_toml(const toml_table& table) {
         environment.from_toml(*env);
     }
 
+    if (const auto* mod = table["models"].as_table()) {
+        models.from_toml(*mod);
+    }
+
+    if (const auto* stp = table["stop"].as_table()) {
+        stop.from_toml(*stp);
+    }
+
     if (const auto* vec = table["angular_velocity"].as_array()) {
         angular_velocity <<              //
             vec->get(0)->value_or(0.0),  //
@@ -57,6 +65,8 @@ void simulation_properties::debug_print() const {
     satellite.debug_print();
     orbit.debug_print();
     environment.debug_print();
+    models.debug_print();
+    stop.debug_print();
 
     std::cout << "-- simulation properties --";
     std::cout << "\n  angular velocity:    " << angular_velocity.x() << ' ' << angular_velocity.y() << ' ' << angular_velocity.z()  //
@@ -1,18 +1,22 @@
 #pragma once
 
 #include "aos/components/spacecraft.hpp"
+#include "aos/core/force_models.hpp"
 #include "aos/core/types.hpp"
 #include "aos/environment/environment.hpp"
 #include "aos/environment/orbital_mechanics.hpp"
 #include "aos/simulation/observer.hpp"
+#include "aos/simulation/stop_criteria.hpp"
 
 namespace aos {
 
 struct simulation_properties {
-    spacecraft_properties  satellite;
-    keplerian_elements     orbit;
-    observer_properties    observer;
-    environment_properties environment;
+    spacecraft_properties    satellite;
+    keplerian_elements       orbit;
+    observer_properties      observer;
+    environment_properties   environment;
+    force_model_set          models;
+    stop_criteria_properties stop;
 
     vec3 angular_velocity;
     real t_start{};
@@ -0,0 +1,55 @@
+#include "csv_index.hpp"
+
+#include "aos/core/types.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace aos {
+
+auto csv_index_filename(const std::string& csv_filename) -> std::string {
+    return csv_filename + ".idx";
+}
+
+auto read_csv_index(const std::string& csv_filename) -> std::vector<csv_index_entry> {
+    std::ifstream file(csv_index_filename(csv_filename));
+    if (not file.is_open()) {
+        return {};
+    }
+
+    std::vector<csv_index_entry> entries;
+    std::string                  line;
+    std::getline(file, line);  // header
+
+    while (std::getline(file, line)) {
+        if (line.empty()) {
+            continue;
+        }
+
+        csv_index_entry entry{};
+        const char*     end   = line.data() + line.size();
+        const auto      time  = std::from_chars(line.data(), end, entry.time);
+        const bool      comma = time.ec == std::errc{} && time.ptr != end && *time.ptr == ',';
+        if (not comma || std::from_chars(time.ptr + 1, end, entry.offset).ec != std::errc{}) {
+            throw std::runtime_error("Malformed CSV index line: " + line);
+        }
+        entries.push_back(entry);
+    }
+    return entries;
+}
+
+auto csv_index_seek(std::span<const csv_index_entry> entries, real t_sec) -> std::uint64_t {
+    // rows of equal time may span two entries, so the entry must lie strictly before t_sec
+    const auto after = std::ranges::lower_bound(entries, t_sec, {}, &csv_index_entry::time);
+    return after == entries.begin() ? 0 : std::prev(after)->offset;
+}
+
+}  // namespace aos
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "aos/core/types.hpp"
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace aos {
+
+/*
+ * Sidecar time index of a CSV trajectory ([observer] index_rows = K), written next to it as <file>.idx:
+ *
+ *   time,offset
+ *   one line per K rows: the time of a row (shortest round-trip text) and the byte offset of its line in the CSV
+ *
+ * An entry is written only after the rows it points to reached the CSV, so the index of a file that is still being
+ * written (or whose writer was killed) never points past its end. A reader seeks to the last entry before the start of
+ * the wanted range and scans from there instead of from the first row.
+ */
+
+struct csv_index_entry {
+    real          time;    // [s]
+    std::uint64_t offset;  // [bytes] start of the row's line
+};
+
+[[nodiscard]] auto csv_index_filename(const std::string& csv_filename) -> std::string;
+
+// the entries of the sidecar index, empty if there is none; throws std::runtime_error for a malformed index
+[[nodiscard]] auto read_csv_index(const std::string& csv_filename) -> std::vector<csv_index_entry>;
+
+// [bytes] where a scan for rows at or after t_sec starts: the last entry strictly before t_sec, 0 (beginning) if none
+[[nodiscard]] auto csv_index_seek(std::span<const csv_index_entry> entries, real t_sec) -> std::uint64_t;
+
+}  // namespace aos
@@ -0,0 +1,185 @@
+#include "async_writer.hpp"
+
+#include "aos/core/types.hpp"
+#include "aos/simulation/row_sink.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <memory>
+#include <print>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace aos {
+
+async_writer::async_writer(std::unique_ptr<row_sink> sink, std::size_t capacity_rows)
+    : _sink(std::move(sink)), _capacity(std::max<std::size_t>(capacity_rows, 1)), _batch_rows(std::max<std::size_t>(_capacity / 4, 1)) {}
+
+async_writer::~async_writer() {
+    if (_writer.joinable()) {
+        _closing.store(true, std::memory_order_release);
+        wake_writer();
+        _writer.join();
+    }
+
+    if (_failed.load(std::memory_order_acquire) && not _error_reported) {
+        try {
+            std::rethrow_exception(_error);
+        } catch (const std::exception& ex) {
+            std::println(stderr, "Error: observer output lost: {}", ex.what());
+        } catch (...) {
+            std::println(stderr, "Error: observer output lost");
+        }
+    }
+}
+
+void async_writer::write_header(std::span<const observer_column> columns) {
+    // a second header (a second run on the same observer) follows the rows of the first, wait until the writer is done
+    // with them and with the previous header before the ring and the columns change
+    if (_writer.joinable()) {
+        wait_for_writer([this] {
+            return _tail.load(std::memory_order_acquire) == _head.load(std::memory_order_relaxed) &&
+                   _headers_done.load(std::memory_order_acquire) == _header_requests.load(std::memory_order_relaxed);
+        });
+    }
+
+    _columns.assign(columns.begin(), columns.end());
+    _width = columns.size();
+    _ring.assign(_capacity * _width, 0.0);
+    _header_requests.fetch_add(1, std::memory_order_release);
+
+    if (_writer.joinable()) {
+        wake_writer();
+    } else {
+        _writer = std::thread([this] { run_writer(); });
+    }
+}
+
+void async_writer::write(std::span<const real> row) {
+    rethrow_error();
+    if (row.size() != _width) {
+        throw std::runtime_error("Observer row has " + std::to_string(row.size()) + " values, header has " + std::to_string(_width));
+    }
+
+    const std::size_t head = _head.load(std::memory_order_relaxed);
+    if (head - _tail.load(std::memory_order_acquire) == _capacity) {
+        wake_writer();
+        wait_for_writer([&] { return head - _tail.load(std::memory_order_acquire) < _capacity; });
+    }
+
+    std::ranges::copy(row, _ring.begin() + static_cast<std::ptrdiff_t>((head % _capacity) * _width));
+    _head.store(head + 1, std::memory_order_release);
+
+    if (head + 1 - _woken_at_head >= _batch_rows) {
+        wake_writer();
+    }
+}
+
+void async_writer::flush() {
+    if (not _writer.joinable()) {
+        return;
+    }
+
+    // the writer completes requests in order, so reaching this request's number means its sink flush has returned
+    const std::uint64_t request = _flush_requests.fetch_add(1, std::memory_order_release) + 1;
+    wake_writer();
+    wait_for_writer([&] { return _flushes_done.load(std::memory_order_acquire) >= request; });
+}
+
+void async_writer::run_writer() {
+    std::size_t tail = _tail.load(std::memory_order_relaxed);
+
+    const auto signal_progress = [this] {
+        _progress.fetch_add(1, std::memory_order_release);
+        _progress.notify_one();
+    };
+
+    try {
+        while (true) {
+            // read the wake counter before the head, a wake-up in between makes the wait below return at once
+            const auto        wake = _wake.load(std::memory_order_acquire);
+            const std::size_t head = _head.load(std::memory_order_acquire);
+
+            // a header is requested on a drained ring and published before the rows after it, so a head read first
+            // shows the request of any row it includes
+            if (const auto requested = _header_requests.load(std::memory_order_acquire); requested != _headers_done.load(std::memory_order_relaxed)) {
+                _sink->write_header(_columns);
+                _headers_done.store(requested, std::memory_order_release);
+                signal_progress();
+                continue;
+            }
+
+            if (head != tail) {
+                // up to two contiguous chunks when the rows wrap around the end of the ring
+                while (tail != head) {
+                    const std::size_t first = tail % _capacity;
+                    const std::size_t count = std::min(head - tail, _capacity - first);
+                    _sink->write_rows(std::span<const real>(_ring).subspan(first * _width, count * _width), count);
+
+                    tail += count;
+                    _tail.store(tail, std::memory_order_release);
+                    signal_progress();
+                }
+                continue;
+            }
+
+            // the request is published after the rows it covers, so a head read after it includes them
+            if (const auto requested = _flush_requests.load(std::memory_order_acquire); requested != _flushes_done.load(std::memory_order_relaxed)) {
+                if (_head.load(std::memory_order_acquire) != tail) {
+                    continue;
+                }
+
+                _sink->flush();
+                _flushes_done.store(requested, std::memory_order_release);
+                signal_progress();
+                continue;
+            }
+
+            if (_closing.load(std::memory_order_acquire) && _head.load(std::memory_order_acquire) == tail) {
+                return;
+            }
+
+            _wake.wait(wake, std::memory_order_acquire);
+        }
+    } catch (...) {
+        // stop draining; the producer rethrows on its next call instead of waiting for rows that never leave the ring
+        _error = std::current_exception();
+        _failed.store(true, std::memory_order_release);
+        signal_progress();
+    }
+}
+
+void async_writer::wake_writer() {
+    _woken_at_head = _head.load(std::memory_order_relaxed);
+    _wake.fetch_add(1, std::memory_order_release);
+    _wake.notify_one();
+}
+
+template <typename condition_type>
+void async_writer::wait_for_writer(condition_type&& done) {
+    while (true) {
+        // read the progress counter before the condition, progress in between makes the wait return at once
+        const auto progress = _progress.load(std::memory_order_acquire);
+        rethrow_error();
+        if (done()) {
+            return;
+        }
+        _progress.wait(progress, std::memory_order_acquire);
+    }
+}
+
+void async_writer::rethrow_error() {
+    if (_failed.load(std::memory_order_acquire)) {
+        _error_reported = true;
+        std::rethrow_exception(_error);
+    }
+}
+
+}  // namespace aos
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "aos/core/types.hpp"
+#include "aos/simulation/row_sink.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace aos {
+
+/**
+ * @brief Moves formatting and file I/O of observer rows off the integration thread.
+ *
+ * write() copies the raw row into a single-producer single-consumer ring of fixed-width slots and returns; a writer
+ * thread hands the rows to the sink in contiguous chunks. Head and tail are atomics, so neither side takes a lock. The
+ * producer wakes the writer once a quarter of the ring has filled up (or on flush), which keeps the writer asleep
+ * between batches instead of waking it per row; the sink itself is flushed only when flush() asks for it. When the
+ * ring is full, write() waits for the writer to free a slot (backpressure), so memory stays bounded whatever the file
+ * system does. Headers pass through the writer thread as well, so only that thread ever touches the sink.
+ *
+ * If the sink throws, the writer thread stops draining and keeps the exception; the next write_header(), write() or
+ * flush() rethrows it. An error nothing rethrew is reported on stderr by the destructor, which must not throw.
+ *
+ * write_header(), write() and flush() must be called from one thread.
+ */
+class async_writer {
+public:
+
+    static constexpr std::size_t default_capacity_rows = 4096;
+
+    async_writer(const async_writer&)                    = delete;
+    async_writer(async_writer&&)                         = delete;
+    auto operator=(const async_writer&) -> async_writer& = delete;
+    auto operator=(async_writer&&) -> async_writer&      = delete;
+
+    async_writer(std::unique_ptr<row_sink> sink, std::size_t capacity_rows);
+    ~async_writer();  // writes the remaining rows
+
+    // fixes the row width and starts the writer thread, a later header follows the rows written before it
+    void write_header(std::span<const observer_column> columns);
+
+    // row.size() must match the header
+    void write(std::span<const real> row);
+
+    // returns once the sink has flushed every row passed to write()
+    void flush();
+
+protected:
+
+    void run_writer();
+    void wake_writer();
+
+    // producer side: blocks until done() holds, rethrows a sink exception caught by the writer thread
+    template <typename condition_type>
+    void wait_for_writer(condition_type&& done);
+
+    void rethrow_error();
+
+private:
+
+    std::unique_ptr<row_sink> _sink;
+    std::vector<real>         _ring;  // capacity x width
+    std::size_t               _capacity;
+    std::size_t               _width{};
+    std::size_t               _batch_rows;       // rows the producer collects before waking the writer
+    std::size_t               _woken_at_head{};  // producer only: head at the last wake-up
+
+    std::vector<observer_column> _columns;           // header handed to the writer thread
+    std::exception_ptr           _error;             // set by the writer thread before _failed
+    bool                         _error_reported{};  // producer only: _error was rethrown
+
+    std::atomic<std::size_t>   _head{};             // rows written by the producer
+    std::atomic<std::size_t>   _tail{};             // rows handed to the sink
+    std::atomic<std::uint64_t> _header_requests{};  // bumped by write_header()
+    std::atomic<std::uint64_t> _headers_done{};     // header requests the sink has written
+    std::atomic<std::uint64_t> _flush_requests{};   // bumped by flush()
+    std::atomic<std::uint64_t> _flushes_done{};     // flush requests the sink has completed
+    std::atomic<std::uint32_t> _wake{};             // bumped to wake the writer
+    std::atomic<std::uint32_t> _progress{};         // bumped by the writer after every chunk, header, flush or failure
+    std::atomic<bool>          _failed{};           // the sink threw, _error holds the exception
+    std::atomic<bool>          _closing{};
+    std::thread                _writer;
+};
+
+}  // namespace aos
@@ -0,0 +1,141 @@
+#include "binary_sink_impl.hpp"
+
+#include "aos/core/types.hpp"
+#include "aos/simulation/row_sink.hpp"
+#include "aos/simulation/trajectory_format.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <ios>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+namespace aos {
+
+binary_sink_impl::binary_sink_impl(const std::string& filename, bool single_precision, std::size_t chunk_rows)
+    : _chunk_rows(chunk_rows), _single_precision(single_precision) {
+    std::filesystem::path file_path(filename);
+    if (file_path.has_parent_path()) {
+        std::filesystem::create_directories(file_path.parent_path());
+    }
+
+    _file.open(filename, std::ios::binary);
+    if (not _file.is_open()) {
+        throw std::runtime_error("Observer could not open output file: " + filename);
+    }
+}
+
+binary_sink_impl::~binary_sink_impl() {
+    if (_value_sizes.empty()) {
+        return;
+    }
+
+    write_chunk();
+
+    const trajectory_trailer trailer{.index_offset = _position, .num_chunks = _chunks.size(), .magic = trajectory_index_magic};
+    write_bytes(_chunks.data(), _chunks.size() * sizeof(trajectory_chunk));
+    write_bytes(&trailer, sizeof(trailer));
+}
+
+void binary_sink_impl::write_header(std::span<const observer_column> columns) {
+    if (not _value_sizes.empty()) {
+        throw std::runtime_error("Binary observer output holds a single run");
+    }
+
+    trajectory_file_header header{
+        .magic       = trajectory_magic,
+        .version     = trajectory_version,
+        .num_columns = static_cast<std::uint32_t>(columns.size()),
+        .data_offset = 0,
+    };
+
+    std::uint64_t records_size = 0;
+    for (const auto& column : columns) {
+        records_size += 4 + column.name.size();
+    }
+    header.data_offset = (sizeof(header) + records_size + trajectory_alignment - 1) / trajectory_alignment * trajectory_alignment;
+    write_bytes(&header, sizeof(header));
+
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+        // time keeps full precision, float32 would resolve only ~0.1 s after two years
+        const std::uint8_t                value_size = _single_precision && i > 0 ? sizeof(float) : sizeof(double);
+        const auto                        length     = static_cast<std::uint16_t>(columns[i].name.size());
+        const std::array<std::uint8_t, 4> record     = {value_size, 0, static_cast<std::uint8_t>(length & 0xFFU), static_cast<std::uint8_t>(length >> 8U)};
+        write_bytes(record.data(), record.size());
+        write_bytes(columns[i].name.data(), length);
+        _value_sizes.push_back(value_size);
+    }
+    pad_to(trajectory_alignment);
+
+    _columns.assign(columns.size(), {});
+    for (auto& column : _columns) {
+        column.reserve(_chunk_rows);
+    }
+}
+
+void binary_sink_impl::write_rows(std::span<const real> values, std::size_t num_rows) {
+    const std::size_t width = _columns.size();
+
+    for (std::size_t row = 0; row < num_rows; ++row) {
+        for (std::size_t i = 0; i < width; ++i) {
+            _columns[i].push_back(values[(row * width) + i]);
+        }
+
+        if (_columns.front().size() == _chunk_rows) {
+            write_chunk();
+        }
+    }
+}
+
+void binary_sink_impl::flush() {
+    write_chunk();
+    _file.flush();
+}
+
+auto binary_sink_impl::size() const -> std::uint64_t {
+    const std::uint64_t pending_rows = _columns.empty() ? 0 : _columns.front().size();
+
+    std::uint64_t size = _position;
+    for (const auto value_size : _value_sizes) {
+        size += pending_rows * value_size;
+    }
+    return size;
+}
+
+void binary_sink_impl::write_chunk() {
+    const std::uint64_t num_rows = _columns.empty() ? 0 : _columns.front().size();
+    if (num_rows == 0) {
+        return;
+    }
+
+    _chunks.push_back({.t_first = _columns.front().front(), .t_last = _columns.front().back(), .offset = _position, .num_rows = num_rows});
+    write_bytes(&num_rows, sizeof(num_rows));
+
+    for (std::size_t i = 0; i < _columns.size(); ++i) {
+        auto& column = _columns[i];
+        if (_value_sizes[i] == sizeof(float)) {
+            _narrow.assign(column.begin(), column.end());
+            write_bytes(_narrow.data(), _narrow.size() * sizeof(float));
+        } else {
+            write_bytes(column.data(), column.size() * sizeof(double));
+        }
+        pad_to(8);  // NOLINT(readability-magic-numbers)
+        column.clear();
+    }
+    pad_to(trajectory_alignment);
+}
+
+void binary_sink_impl::write_bytes(const void* data, std::uint64_t size) {
+    _file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    _position += size;
+}
+
+void binary_sink_impl::pad_to(std::uint64_t alignment) {
+    static constexpr std::array<char, trajectory_alignment> zeros{};
+    write_bytes(zeros.data(), (alignment - (_position % alignment)) % alignment);
+}
+
+}  // namespace aos
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "aos/core/types.hpp"
+#include "aos/simulation/row_sink.hpp"
+#include "aos/simulation/trajectory_format.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace aos {
+
+// see trajectory_format.hpp, rows are collected column-wise and written as one chunk per chunk_rows rows or flush()
+class binary_sink_impl : public row_sink {
+public:
+
+    static constexpr std::size_t default_chunk_rows = 65536;
+
+    binary_sink_impl(const binary_sink_impl&)                    = delete;
+    binary_sink_impl(binary_sink_impl&&)                         = delete;
+    auto operator=(const binary_sink_impl&) -> binary_sink_impl& = delete;
+    auto operator=(binary_sink_impl&&) -> binary_sink_impl&      = delete;
+
+    binary_sink_impl(const std::string& filename, bool single_precision, std::size_t chunk_rows = default_chunk_rows);
+    ~binary_sink_impl() override;  // writes the pending chunk and the index
+
+    void write_header(std::span<const observer_column> columns) override;
+    void write_rows(std::span<const real> values, std::size_t num_rows) override;
+    void flush() override;
+
+    [[nodiscard]] auto size() const -> std::uint64_t override;
+
+protected:
+
+    void write_chunk();
+    void write_bytes(const void* data, std::uint64_t size);
+    void pad_to(std::uint64_t alignment);
+
+private:
+
+    std::ofstream                    _file;
+    std::uint64_t                    _position{};  // [bytes] written so far
+    std::vector<std::uint8_t>        _value_sizes;
+    std::vector<std::vector<double>> _columns;     // rows of the pending chunk
+    std::vector<float>               _narrow;      // float32 copy of one column while it is written
+    std::vector<trajectory_chunk>    _chunks;
+    std::size_t                      _chunk_rows;
+    bool                             _single_precision;
+};
+
+}  // namespace aos
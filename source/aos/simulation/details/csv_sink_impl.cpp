@@ -0,0 +1,155 @@
+#include "csv_sink_impl.hpp"
+
+#include "aos/core/types.hpp"
+#include "aos/simulation/csv_index.hpp"
+#include "aos/simulation/row_sink.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <ios>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+namespace aos {
+
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+csv_sink_impl::csv_sink_impl(const std::string& filename, int precision, bool shortest, std::size_t index_rows, std::size_t buffer_bytes)
+    : _buffer(buffer_bytes), _index_rows(index_rows), _precision(std::max(precision, 0)), _shortest(shortest) {
+    std::filesystem::path file_path(filename);
+    if (file_path.has_parent_path()) {
+        std::filesystem::create_directories(file_path.parent_path());
+    }
+
+    _file.open(filename, std::ios::binary);
+    if (not _file.is_open()) {
+        throw std::runtime_error("Observer could not open output file: " + filename);
+    }
+
+    if (_index_rows > 0) {
+        _index.open(csv_index_filename(filename), std::ios::binary);
+        if (not _index.is_open()) {
+            throw std::runtime_error("Observer could not open index file: " + csv_index_filename(filename));
+        }
+        _index << "time,offset\n";
+    }
+}
+
+csv_sink_impl::~csv_sink_impl() {
+    write_buffer();
+}
+
+void csv_sink_impl::write_header(std::span<const observer_column> columns) {
+    _formats.clear();
+    _max_row_chars = 1;  // newline
+
+    std::string header;
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+        header += (i == 0 ? "" : ",") + columns[i].name;
+        _formats.push_back(_shortest ? column_format_shortest : columns[i].format);
+        _max_row_chars += max_value_chars(_formats.back()) + 1;
+    }
+    header += '\n';
+
+    // a row always fits behind whatever is buffered once the buffer has been written out
+    if (_buffer.size() < std::max(header.size(), _max_row_chars)) {
+        _buffer.resize(std::max(header.size(), _max_row_chars));
+    }
+
+    if (_buffer.size() - _used < header.size()) {
+        write_buffer();
+    }
+    std::ranges::copy(header, _buffer.begin() + static_cast<std::ptrdiff_t>(_used));
+    _used += header.size();
+}
+
+void csv_sink_impl::write_rows(std::span<const real> values, std::size_t num_rows) {
+    const std::size_t width = _formats.size();
+
+    for (std::size_t row = 0; row < num_rows; ++row) {
+        if (_buffer.size() - _used < _max_row_chars) {
+            write_buffer();
+        }
+
+        const auto row_values = values.subspan(row * width, width);
+        if (_index_rows > 0 && _rows++ % _index_rows == 0) {
+            _index_pending.push_back({.time = row_values[0], .offset = _written + _used});
+        }
+
+        char* out  = _buffer.data() + _used;
+        char* last = _buffer.data() + _buffer.size();
+        for (std::size_t i = 0; i < width; ++i) {
+            if (i > 0) {
+                *out++ = ',';
+            }
+
+            const auto result = _formats[i] == column_format_fixed ? std::to_chars(out, last, row_values[i], std::chars_format::fixed, _precision)
+                                                                   : std::to_chars(out, last, row_values[i]);
+            if (result.ec != std::errc{}) {
+                throw std::runtime_error("Observer could not format a value");
+            }
+            out = result.ptr;
+        }
+        *out++ = '\n';
+
+        _used = static_cast<std::size_t>(out - _buffer.data());
+    }
+}
+
+void csv_sink_impl::flush() {
+    write_buffer();
+    _file.flush();
+    _index.flush();
+}
+
+auto csv_sink_impl::size() const -> std::uint64_t {
+    return _written + _used;
+}
+
+auto csv_sink_impl::max_value_chars(column_format format) const -> std::size_t {
+    // sign, digits before the point (max_exponent10 + 1), point and decimals
+    constexpr auto integer_digits = static_cast<std::size_t>(std::numeric_limits<real>::max_exponent10) + 1;
+    if (format == column_format_fixed) {
+        return 1 + integer_digits + 1 + static_cast<std::size_t>(_precision);
+    }
+
+    // sign, max_digits10 digits, point and the longest exponent ("e-308")
+    constexpr std::size_t exponent_chars = 5;
+    return 1 + static_cast<std::size_t>(std::numeric_limits<real>::max_digits10) + 1 + exponent_chars;
+}
+
+void csv_sink_impl::write_buffer() {
+    if (_used == 0) {
+        return;
+    }
+
+    _file.write(_buffer.data(), static_cast<std::streamsize>(_used));
+    _written += _used;
+    _used = 0;
+
+    if (_index_pending.empty()) {
+        return;
+    }
+
+    // time (shortest round-trip), comma, offset, newline
+    constexpr std::size_t max_entry_chars = std::numeric_limits<real>::max_digits10 + 8 + std::numeric_limits<std::uint64_t>::digits10 + 3;
+
+    std::string text(_index_pending.size() * max_entry_chars, '\0');
+    char*       out  = text.data();
+    char*       last = text.data() + text.size();
+    for (const auto& entry : _index_pending) {
+        out    = std::to_chars(out, last, entry.time).ptr;
+        *out++ = ',';
+        out    = std::to_chars(out, last, entry.offset).ptr;
+        *out++ = '\n';
+    }
+    _index.write(text.data(), out - text.data());
+    _index_pending.clear();
+}
+
+}  // namespace aos
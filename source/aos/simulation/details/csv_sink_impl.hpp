@@ -0,0 +1,66 @@
+#pragma once
+
+#include "aos/core/types.hpp"
+#include "aos/simulation/csv_index.hpp"
+#include "aos/simulation/row_sink.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace aos {
+
+// values are formatted with std::to_chars straight into a large buffer that reaches the file in few big writes
+class csv_sink_impl : public row_sink {
+public:
+
+    static constexpr std::size_t default_buffer_bytes = std::size_t{1} << 20U;
+
+    csv_sink_impl(const csv_sink_impl&)                    = delete;
+    csv_sink_impl(csv_sink_impl&&)                         = delete;
+    auto operator=(const csv_sink_impl&) -> csv_sink_impl& = delete;
+    auto operator=(csv_sink_impl&&) -> csv_sink_impl&      = delete;
+
+    // shortest: every column as the shortest text that round-trips instead of fixed precision
+    // index_rows: sidecar time index entry every index_rows rows (see csv_index.hpp), 0 writes no index
+    csv_sink_impl(const std::string& filename,
+                  int                precision,
+                  bool               shortest     = false,
+                  std::size_t        index_rows   = 0,
+                  std::size_t        buffer_bytes = default_buffer_bytes);
+    ~csv_sink_impl() override;  // writes what is still buffered
+
+    void write_header(std::span<const observer_column> columns) override;
+    void write_rows(std::span<const real> values, std::size_t num_rows) override;
+    void flush() override;
+
+    [[nodiscard]] auto size() const -> std::uint64_t override;
+
+protected:
+
+    // [chars] longest text of a single value in the given format
+    [[nodiscard]] auto max_value_chars(column_format format) const -> std::size_t;
+
+    // hand the buffered text to the file, then the index entries of its rows to the index
+    void write_buffer();
+
+private:
+
+    std::ofstream                _file;
+    std::vector<char>            _buffer;
+    std::size_t                  _used{};           // [chars] of _buffer holding text
+    std::uint64_t                _written{};        // [bytes] in the file before _buffer
+    std::ofstream                _index;
+    std::size_t                  _index_rows;
+    std::size_t                  _rows{};
+    std::vector<csv_index_entry> _index_pending;    // rows still in _buffer
+    std::vector<column_format>   _formats;
+    std::size_t                  _max_row_chars{};  // room a row needs in _buffer before it is formatted
+    int                          _precision;
+    bool                         _shortest;
+};
+
+}  // namespace aos
@@ -1,31 +1,104 @@
 #include "dynamics_impl.hpp"
 
 #include "aos/components/spacecraft.hpp"
+#include "aos/core/force_models.hpp"
 #include "aos/core/state.hpp"
 #include "aos/core/types.hpp"
+#include "aos/environment/details/environment_impl.hpp"
 #include "aos/environment/environment.hpp"
 
+#include <array>
+#include <cstddef>
 #include <memory>
+#include <type_traits>
 #include <utility>
 
 namespace aos {
 
-dynamics_impl::dynamics_impl(std::shared_ptr<const spacecraft> spacecraft_model, std::shared_ptr<const environment> environment_model)
+template <typename environment_type, force_model_set models>
+dynamics_impl<environment_type, models>::dynamics_impl(std::shared_ptr<spacecraft> spacecraft_model, std::shared_ptr<const environment_type> environment_model)
     : _spacecraft(std::move(spacecraft_model)), _environment(std::move(environment_model)) {}
 
-dynamics_impl::~dynamics_impl() = default;
+template <typename environment_type, force_model_set models>
+dynamics_impl<environment_type, models>::~dynamics_impl() = default;
 
-void dynamics_impl::step(const system_state& current_state, system_state& state_derivative, real t_sec) const {
-    const auto env = _environment->compute_effects(_time_offset + t_sec, current_state.position_m, current_state.velocity_m_s);
-    _spacecraft->derivative(env, current_state, state_derivative);
+template <typename environment_type, force_model_set models>
+void dynamics_impl<environment_type, models>::step(const system_state& current_state, system_state& state_derivative, real t_sec) const {
+    const real t   = get_time_offset() + t_sec;
+    const auto env = compute_environment(t, current_state);
+    if (diagnostics_enabled()) {
+        record_diagnostics(t, current_state, env, complete_environment);
+    }
+    _spacecraft->template derivative<models>(env, current_state, state_derivative);
 }
 
-auto dynamics_impl::get_spacecraft() const -> const spacecraft& {
+template <typename environment_type, force_model_set models>
+void dynamics_impl<environment_type, models>::accept_step(system_state& state, real t_sec) {
+    if constexpr (models.rods) {
+        if (not _spacecraft->hystresis().has_history()) {
+            return;
+        }
+
+        const real t   = get_time_offset() + t_sec;
+        const auto env = compute_environment(t, state);
+        if (diagnostics_enabled()) {
+            record_diagnostics(t, state, env, complete_environment);
+        }
+        _spacecraft->accept_step(env, state);
+    }
+}
+
+template <typename environment_type, force_model_set models>
+auto dynamics_impl<environment_type, models>::get_spacecraft() const -> const spacecraft& {
     return *_spacecraft;
 }
 
-auto dynamics_impl::get_environment() const -> const environment& {
+template <typename environment_type, force_model_set models>
+auto dynamics_impl<environment_type, models>::get_environment() const -> const environment_type& {
     return *_environment;
 }
 
+template <typename environment_type, force_model_set models>
+auto dynamics_impl<environment_type, models>::compute_environment(real t_sec, const system_state& state) const -> environment_effects {
+    if constexpr (std::is_same_v<environment_type, environment_impl>) {
+        return _environment->template compute_effects_for<models>(t_sec, state.position_m, state.velocity_m_s);
+    } else {
+        return _environment->compute_effects(t_sec, state.position_m, state.velocity_m_s);
+    }
+}
+
+template class dynamics_impl<environment>;
+template class dynamics_impl<environment_impl>;
+
+namespace {
+
+template <typename environment_type, force_model_set models>
+auto make_dynamics(std::shared_ptr<spacecraft> spacecraft_model, std::shared_ptr<const environment_type> environment_model) -> std::shared_ptr<dynamics> {
+    return std::make_shared<dynamics_impl<environment_type, models>>(std::move(spacecraft_model), std::move(environment_model));
+}
+
+// one factory per model set, indexed by force_model_set::index()
+template <typename environment_type, std::size_t... indices>
+auto make_dynamics(std::size_t                             index,
+                   std::shared_ptr<spacecraft>             spacecraft_model,
+                   std::shared_ptr<const environment_type> environment_model,
+                   std::index_sequence<indices...> /*sets*/) -> std::shared_ptr<dynamics> {
+    static constexpr std::array factories{&make_dynamics<environment_type, force_model_set::from_index(indices)>...};
+    return factories.at(index)(std::move(spacecraft_model), std::move(environment_model));
+}
+
+}  // namespace
+
+auto create_dynamics_impl(std::shared_ptr<spacecraft>        spacecraft_model,
+                          std::shared_ptr<const environment> environment_model,
+                          const force_model_set&             models) -> std::shared_ptr<dynamics> {
+    constexpr auto sets = std::make_index_sequence<force_model_set::num_sets>{};
+
+    // statically bound configuration for the built-in environment, virtual calls for anything else
+    if (auto concrete = std::dynamic_pointer_cast<const environment_impl>(environment_model)) {
+        return make_dynamics<environment_impl>(models.index(), std::move(spacecraft_model), std::move(concrete), sets);
+    }
+    return make_dynamics<environment>(models.index(), std::move(spacecraft_model), std::move(environment_model), sets);
+}
+
 }  // namespace aos
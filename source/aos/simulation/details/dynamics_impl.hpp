@@ -1,16 +1,28 @@
 #pragma once
 
 #include "aos/components/spacecraft.hpp"
+#include "aos/core/force_models.hpp"
 #include "aos/core/state.hpp"
 #include "aos/core/types.hpp"
+#include "aos/environment/details/environment_impl.hpp"
 #include "aos/environment/environment.hpp"
 #include "aos/simulation/dynamics.hpp"
 
 #include <memory>
+#include <type_traits>
 
 namespace aos {
 
-class dynamics_impl : public dynamics {
+/**
+ * @brief Spacecraft dynamics over an environment of static type environment_type, restricted to a force model set.
+ *
+ * With environment_type = environment the environment is called through its virtual interface, so any implementation
+ * works. With a final implementation (environment_impl) every call below step is direct, and a caller holding the
+ * concrete dynamics_impl (simulation::run) lets the compiler inline the whole right-hand side. The full model set of
+ * both configurations is instantiated explicitly, create_dynamics_impl instantiates every other set.
+ */
+template <typename environment_type, force_model_set models = force_model_set{}>
+class dynamics_impl final : public dynamics {
 public:
 
     dynamics_impl(const dynamics_impl&)                    = delete;
@@ -18,19 +30,34 @@ public:
     auto operator=(const dynamics_impl&) -> dynamics_impl& = delete;
     auto operator=(dynamics_impl&&) -> dynamics_impl&      = delete;
 
-    dynamics_impl(std::shared_ptr<const spacecraft> spacecraft_model, std::shared_ptr<const environment> environment_model);
+    dynamics_impl(std::shared_ptr<spacecraft> spacecraft_model, std::shared_ptr<const environment_type> environment_model);
     ~dynamics_impl() override;
 
     void step(const system_state& current_state, system_state& state_derivative, real t_sec) const override;
+    void accept_step(system_state& state, real t_sec) override;
 
     [[nodiscard]] auto get_spacecraft() const -> const spacecraft&;
-    [[nodiscard]] auto get_environment() const -> const environment&;
+    [[nodiscard]] auto get_environment() const -> const environment_type&;
+
+protected:
+
+    // the virtual environment always computes every input, environment_impl only those of the enabled models
+    static constexpr bool complete_environment = not std::is_same_v<environment_type, environment_impl> || models.index() == force_model_set{}.index();
+
+    [[nodiscard]] auto compute_environment(real t_sec, const system_state& state) const -> environment_effects;
 
 private:
 
-    std::shared_ptr<const spacecraft>  _spacecraft;
-    std::shared_ptr<const environment> _environment;
-    real                               _time_offset{};
+    std::shared_ptr<spacecraft>             _spacecraft;
+    std::shared_ptr<const environment_type> _environment;
 };
 
+extern template class dynamics_impl<environment>;
+extern template class dynamics_impl<environment_impl>;
+
+// dynamics_impl specialized for the environment type and the model set
+auto create_dynamics_impl(std::shared_ptr<spacecraft>        spacecraft_model,
+                          std::shared_ptr<const environment> environment_model,
+                          const force_model_set&             models) -> std::shared_ptr<dynamics>;
+
 }  // namespace aos
@@ -0,0 +1,16 @@
+#include "null_observer_impl.hpp"
+
+#include "aos/core/state.hpp"
+#include "aos/core/types.hpp"
+
+namespace aos {
+
+null_observer_impl::null_observer_impl() = default;
+
+null_observer_impl::~null_observer_impl() = default;
+
+void null_observer_impl::write_header() {}
+
+void null_observer_impl::write(const system_state& /*state*/, real /*time*/) {}
+
+}  // namespace aos
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "aos/core/state.hpp"
+#include "aos/core/types.hpp"
+#include "aos/simulation/observer.hpp"
+
+namespace aos {
+
+// drops every row, for runs where only the final state is of interest
+class null_observer_impl : public observer {
+public:
+
+    null_observer_impl(const null_observer_impl&)                    = delete;
+    null_observer_impl(null_observer_impl&&)                         = delete;
+    auto operator=(const null_observer_impl&) -> null_observer_impl& = delete;
+    auto operator=(null_observer_impl&&) -> null_observer_impl&      = delete;
+
+    null_observer_impl();
+    ~null_observer_impl() override;
+
+    void write_header() override;
+    void write(const system_state& state, real time) override;
+};
+
+}  // namespace aos
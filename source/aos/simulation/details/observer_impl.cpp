@@ -3,87 +3,100 @@
 #include "aos/core/state.hpp"
 #include "aos/core/types.hpp"
 #include "aos/simulation/observer.hpp"
+#include "aos/simulation/row_sink.hpp"
+#include "aos/simulation/sampler.hpp"
 
 #include <cstddef>
-#include <filesystem>
-#include <iomanip>
-#include <ios>
-#include <ostream>
-#include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace aos {
 
 observer_impl::observer_impl(const std::string& filename, std::size_t num_rods, const observer_properties& properties)
-    : _num_rods(num_rods), _include_elements(not properties.exclude_elements), _include_magnitudes(not properties.exclude_magnitudes) {
-    std::filesystem::path file_path(filename);
-    if (file_path.has_parent_path()) {
-        std::filesystem::create_directories(file_path.parent_path());
+    : _writer(row_sink::create(filename, properties), static_cast<std::size_t>(properties.buffer_rows)),
+      _num_rods(num_rods),
+      _include_elements(not properties.exclude_elements),
+      _include_magnitudes(not properties.exclude_magnitudes) {
+    if (properties.sampling.policy != sampling_policy_all) {
+        _sampler = sampler::create(properties.sampling, [this](const system_state& state, real time) { write_row(state, time); });
     }
+}
+
+observer_impl::~observer_impl() = default;
 
-    _file.open(filename);
-    if (not _file.is_open()) {
-        throw std::runtime_error("Observer could not open output file: " + filename);
+void observer_impl::write_header() {
+    std::vector<observer_column> columns;
+    append_columns(columns);
+    _row.reserve(columns.size());
+    _writer.write_header(columns);
+}
+
+void observer_impl::write(const system_state& state, real time) {
+    if (_sampler) {
+        _sampler->sample(state, time);
+    } else {
+        write_row(state, time);
     }
+}
 
-    _file << std::fixed << std::setprecision(properties.precission);
+void observer_impl::flush() {
+    if (_sampler) {
+        _sampler->flush();
+    }
+    _writer.flush();
 }
 
-observer_impl::~observer_impl() = default;
+void observer_impl::write_row(const system_state& state, real time) {
+    _row.clear();
+    append_values(state, time, _row);
+    _writer.write(_row);
+}
 
-auto observer_impl::write_header() -> std::ostream& {
-    _file << "time";
+void observer_impl::append_columns(std::vector<observer_column>& columns) const {
+    columns.push_back({"time"});
 
     if (_include_magnitudes) {
-        _file << ",r"
-              << ",v"
-              << ",w";
+        columns.insert(columns.end(), {{"r"}, {"v"}, {"w"}});
     }
 
     if (_include_elements) {
-        _file << ",r_x,r_y,r_z"
-              << ",v_x,v_y,v_z"
-              << ",q_w,q_x,q_y,q_z"
-              << ",w_x,w_y,w_z";
+        columns.insert(columns.end(), {{"r_x"}, {"r_y"}, {"r_z"}, {"v_x"}, {"v_y"}, {"v_z"}});
+        columns.insert(columns.end(), {{"q_w"}, {"q_x"}, {"q_y"}, {"q_z"}, {"w_x"}, {"w_y"}, {"w_z"}});
     }
 
     for (std::size_t i = 0; i < _num_rods; ++i) {
-        _file << ",M_" << (i + 1);
+        columns.push_back({"M_" + std::to_string(i + 1)});
     }
-
-    return _file;
 }
 
-auto observer_impl::write(const system_state& state, real time) -> std::ostream& {
-    _file << time;
+void observer_impl::append_values(const system_state& state, real time, std::vector<real>& row) const {
+    row.push_back(time);
 
     if (_include_magnitudes) {
-        _file << ',' << state.position_m.norm()             // r
-              << ',' << state.velocity_m_s.norm()           // v
-              << ',' << state.angular_velocity_m_s.norm();  // w
+        row.push_back(state.position_m.norm());            // r
+        row.push_back(state.velocity_m_s.norm());          // v
+        row.push_back(state.angular_velocity_m_s.norm());  // w
     }
 
     if (_include_elements) {
-        _file << ',' << state.position_m.x()             // r_x
-              << ',' << state.position_m.y()             // r_y
-              << ',' << state.position_m.z()             // r_z
-              << ',' << state.velocity_m_s.x()           // v_x
-              << ',' << state.velocity_m_s.y()           // v_y
-              << ',' << state.velocity_m_s.z()           // v_z
-              << ',' << state.attitude.coeffs().w()      // q_w
-              << ',' << state.attitude.coeffs().x()      // q_x
-              << ',' << state.attitude.coeffs().y()      // q_y
-              << ',' << state.attitude.coeffs().z()      // q_z
-              << ',' << state.angular_velocity_m_s.x()   // w_x
-              << ',' << state.angular_velocity_m_s.y()   // w_y
-              << ',' << state.angular_velocity_m_s.z();  // w_z
+        row.push_back(state.position_m.x());            // r_x
+        row.push_back(state.position_m.y());            // r_y
+        row.push_back(state.position_m.z());            // r_z
+        row.push_back(state.velocity_m_s.x());          // v_x
+        row.push_back(state.velocity_m_s.y());          // v_y
+        row.push_back(state.velocity_m_s.z());          // v_z
+        row.push_back(state.attitude.coeffs().w());     // q_w
+        row.push_back(state.attitude.coeffs().x());     // q_x
+        row.push_back(state.attitude.coeffs().y());     // q_y
+        row.push_back(state.attitude.coeffs().z());     // q_z
+        row.push_back(state.angular_velocity_m_s.x());  // w_x
+        row.push_back(state.angular_velocity_m_s.y());  // w_y
+        row.push_back(state.angular_velocity_m_s.z());  // w_z
     }
 
     for (std::size_t i = 0; i < _num_rods; ++i) {
-        _file << ',' << state.rod_magnetizations(static_cast<int>(i));
+        row.push_back(state.rod_magnetizations(static_cast<int>(i)));
     }
-
-    return _file;
 }
 
 }  // namespace aos
@@ -2,15 +2,19 @@
 
 #include "aos/core/state.hpp"
 #include "aos/core/types.hpp"
+#include "aos/simulation/details/async_writer.hpp"
 #include "aos/simulation/observer.hpp"
+#include "aos/simulation/row_sink.hpp"
+#include "aos/simulation/sampler.hpp"
 
 #include <cstddef>
-#include <fstream>
-#include <ostream>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace aos {
 
+// observed states pass the sampler (if one is configured), rows go to an async_writer whose thread formats and writes them
 class observer_impl : public observer {
 public:
 
@@ -22,15 +26,26 @@ public:
     explicit observer_impl(const std::string& filename, std::size_t num_rods, const observer_properties& properties);
     ~observer_impl() override;
 
-    auto write_header() -> std::ostream& override;
-    auto write(const system_state& state, real time) -> std::ostream& override;
+    void write_header() final;
+    void write(const system_state& state, real time) final;
+    void flush() final;
+
+protected:
+
+    // derived observers add their columns after these, in the same order in both functions
+    virtual void append_columns(std::vector<observer_column>& columns) const;
+    virtual void append_values(const system_state& state, real time, std::vector<real>& row) const;
+
+    void write_row(const system_state& state, real time);
 
 private:
 
-    std::ofstream _file;
-    std::size_t   _num_rods;
-    bool          _include_elements;
-    bool          _include_magnitudes;
+    async_writer             _writer;
+    std::unique_ptr<sampler> _sampler;  // null: every observed state is a row
+    std::vector<real>        _row;      // reused for every write
+    std::size_t              _num_rods;
+    bool                     _include_elements;
+    bool                     _include_magnitudes;
 };
 
 }  // namespace aos
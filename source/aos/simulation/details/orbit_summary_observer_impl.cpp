@@ -0,0 +1,128 @@
+#include "orbit_summary_observer_impl.hpp"
+
+#include "aos/components/spacecraft.hpp"
+#include "aos/core/constants.hpp"
+#include "aos/core/state.hpp"
+#include "aos/core/types.hpp"
+#include "aos/environment/environment.hpp"
+#include "aos/simulation/dynamics.hpp"
+#include "aos/simulation/observer.hpp"
+#include "aos/simulation/row_sink.hpp"
+#include "aos/simulation/statistics_observer.hpp"
+#include "aos/simulation/stop_criteria.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace aos {
+
+orbit_summary_observer_impl::orbit_summary_observer_impl(std::shared_ptr<observer>          inner,
+                                                         const std::string&                 filename,
+                                                         std::shared_ptr<const spacecraft>  sat,
+                                                         std::shared_ptr<const environment> env,
+                                                         std::size_t                        num_rods,
+                                                         const observer_properties&         props,
+                                                         std::shared_ptr<dynamics>          dyn)
+    : _inner(std::move(inner)), _sink(row_sink::create(filename, props)), _sat(std::move(sat)), _env(std::move(env)), _num_rods(num_rods), _rods(num_rods) {
+    if (dyn) {
+        dyn->enable_diagnostics();
+        _dynamics = std::move(dyn);
+    }
+}
+
+void orbit_summary_observer_impl::write_header() {
+    _inner->write_header();
+
+    std::vector<observer_column> columns = {{"time"}, {"duration"}};
+    for (const char* name : {"orbit", "w_mean", "w_min", "w_max", "pointing_mean", "pointing_min", "pointing_max"}) {
+        columns.push_back({name, column_format_shortest});
+    }
+    for (std::size_t i = 0; i < _num_rods; ++i) {
+        columns.push_back({"M_" + std::to_string(i + 1) + "_amp", column_format_shortest});
+    }
+    for (const char* name : {"eclipse", "drag_mean", "drag_max"}) {
+        columns.push_back({name, column_format_shortest});
+    }
+
+    _row.reserve(columns.size());
+    _sink->write_header(columns);
+}
+
+void orbit_summary_observer_impl::write(const system_state& state, real time) {
+    const real u       = argument_of_latitude(state);
+    const bool crossed = _started && u < _u_previous - pi;  // wrapped from near 2 pi to near 0
+
+    if (_in_orbit) {
+        accumulate(state, time, time - _t_previous);
+    }
+    if (crossed) {
+        if (_in_orbit) {
+            close_orbit(time);
+        }
+        _in_orbit    = true;
+        _orbit_start = time;
+        accumulate(state, time, 0.0);
+    }
+
+    _started    = true;
+    _t_previous = time;
+    _u_previous = u;
+
+    _inner->write(state, time);
+}
+
+void orbit_summary_observer_impl::flush() {
+    _inner->flush();
+    _sink->flush();
+}
+
+auto orbit_summary_observer_impl::argument_of_latitude(const system_state& state) -> real {
+    constexpr real equatorial = 1e-12;  // relative node vector length below which the node is undefined
+
+    const vec3& r    = state.position_m;
+    const vec3  h    = r.cross(state.velocity_m_s);
+    const vec3  node = vec3::UnitZ().cross(h);
+
+    // equatorial orbit: true longitude instead
+    const real u = node.norm() < equatorial * h.norm() ? std::atan2(r.y(), r.x())
+                                                        : std::atan2(h.normalized().cross(node.normalized()).dot(r), node.normalized().dot(r));
+    return u < 0.0 ? u + two_pi : u;
+}
+
+void orbit_summary_observer_impl::accumulate(const system_state& state, real time, real weight_s) {
+    const auto effects = observed_environment(*_env, _dynamics.get(), state, time);
+    const quat q_inv   = state.attitude.conjugate();
+    const auto drag    = _sat->faces().compute_face_effects<true, false>(effects, state.attitude, q_inv, state.angular_velocity_m_s);
+
+    _angular_velocity.add(state.angular_velocity_m_s.norm(), weight_s);
+    _pointing.add(stop_criteria::pointing_error_deg(state.attitude, _sat->magnet().magnetic_moment(), effects.magnetic_field_eci_T), weight_s);
+    _eclipse.add(1.0 - effects.shadow_factor, weight_s);
+    _drag_torque.add(drag.torque_body.norm(), weight_s);
+    for (std::size_t i = 0; i < _num_rods; ++i) {
+        _rods[i].add(state.rod_magnetizations(static_cast<Eigen::Index>(i)), weight_s);
+    }
+}
+
+void orbit_summary_observer_impl::close_orbit(real t_sec) {
+    _row.clear();
+    _row.insert(_row.end(), {_orbit_start, t_sec - _orbit_start, static_cast<real>(++_orbits)});
+    _row.insert(_row.end(), {_angular_velocity.mean, _angular_velocity.min, _angular_velocity.max});
+    _row.insert(_row.end(), {_pointing.mean, _pointing.min, _pointing.max});
+    for (const auto& rod : _rods) {
+        _row.push_back(0.5 * (rod.max - rod.min));
+    }
+    _row.insert(_row.end(), {_eclipse.mean, _drag_torque.mean, _drag_torque.max});
+    _sink->write_rows(_row, 1);
+
+    _angular_velocity = {};
+    _pointing         = {};
+    _eclipse          = {};
+    _drag_torque      = {};
+    _rods.assign(_num_rods, {});
+}
+
+}  // namespace aos
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "aos/components/spacecraft.hpp"
+#include "aos/core/state.hpp"
+#include "aos/core/types.hpp"
+#include "aos/environment/environment.hpp"
+#include "aos/simulation/dynamics.hpp"
+#include "aos/simulation/observer.hpp"
+#include "aos/simulation/row_sink.hpp"
+#include "aos/simulation/statistics_observer.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace aos {
+
+class orbit_summary_observer_impl : public observer {
+public:
+
+    orbit_summary_observer_impl(std::shared_ptr<observer>          inner,
+                                const std::string&                 filename,
+                                std::shared_ptr<const spacecraft>  sat,
+                                std::shared_ptr<const environment> env,
+                                std::size_t                        num_rods,
+                                const observer_properties&         props,
+                                std::shared_ptr<dynamics>          dyn);
+
+    void write_header() override;
+    void write(const system_state& state, real time) override;
+    void flush() override;
+
+    // [rad] angle from the ascending node to the position in the orbit plane, in [0, 2 pi)
+    [[nodiscard]] static auto argument_of_latitude(const system_state& state) -> real;
+
+protected:
+
+    // one sample standing for weight_s seconds of the current orbit
+    void accumulate(const system_state& state, real time, real weight_s);
+
+    // write the finished orbit and start the next one at t_sec
+    void close_orbit(real t_sec);
+
+private:
+
+    std::shared_ptr<observer>          _inner;
+    std::unique_ptr<row_sink>          _sink;
+    std::shared_ptr<const spacecraft>  _sat;
+    std::shared_ptr<const environment> _env;
+    std::shared_ptr<const dynamics>    _dynamics;          // optional
+    std::size_t                        _num_rods;
+    std::vector<real>                  _row;
+    running_statistics                 _angular_velocity;  // [rad/s] |w|
+    running_statistics                 _pointing;          // [deg]
+    running_statistics                 _eclipse;           // [-] 1 - shadow factor
+    running_statistics                 _drag_torque;       // [Nm] |t_drag|
+    std::vector<running_statistics>    _rods;              // [A/m] magnetization
+    real                               _orbit_start{};     // [s]
+    real                               _t_previous{};      // [s]
+    real                               _u_previous{};      // [rad]
+    int                                _orbits{};          // rows written
+    bool                               _started{};
+    bool                               _in_orbit{};        // an ascending node was crossed
+};
+
+}  // namespace aos
@@ -0,0 +1,181 @@
+#include "sampler_impl.hpp"
+
+#include "aos/core/constants.hpp"
+#include "aos/core/state.hpp"
+#include "aos/core/types.hpp"
+#include "aos/simulation/sampler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+namespace aos {
+
+sampler_impl::sampler_impl(emit_function emit) : _emit(std::move(emit)) {}
+
+void sampler_impl::flush() {
+    if (_observed && (not _emitted || _latest_time > _emitted_time)) {
+        emit(_latest, _latest_time);
+    }
+}
+
+void sampler_impl::emit(const system_state& state, real time) {
+    _emit(state, time);
+    _emitted_time = time;
+    _emitted      = true;
+}
+
+void sampler_impl::observe(const system_state& state, real time) {
+    _latest      = state;
+    _latest_time = time;
+    _observed    = true;
+}
+
+auto sampler_impl::has_observed() const -> bool {
+    return _observed;
+}
+
+auto sampler_impl::latest() const -> const system_state& {
+    return _latest;
+}
+
+auto sampler_impl::latest_time() const -> real {
+    return _latest_time;
+}
+
+every_nth_sampler_impl::every_nth_sampler_impl(emit_function emit, std::size_t every) : sampler_impl(std::move(emit)), _every(every) {}
+
+void every_nth_sampler_impl::sample(const system_state& state, real time) {
+    if (_count++ % _every == 0) {
+        emit(state, time);
+    }
+    observe(state, time);
+}
+
+interval_sampler_impl::interval_sampler_impl(emit_function emit, real interval_s) : sampler_impl(std::move(emit)), _interval_s(interval_s) {}
+
+void interval_sampler_impl::sample(const system_state& state, real time) {
+    if (not has_observed()) {
+        _t_0 = time;
+        emit(state, time);
+        observe(state, time);
+        return;
+    }
+
+    const real t_prev = latest_time();
+    if (time <= t_prev) {
+        observe(state, time);
+        return;
+    }
+
+    // grid times are formed from the index, so rows do not drift over long runs
+    for (real t_row = _t_0 + (static_cast<real>(_next) * _interval_s); t_row <= time; t_row = _t_0 + (static_cast<real>(++_next) * _interval_s)) {
+        if (t_row == time) {
+            emit(state, time);
+        } else {
+            interpolate(latest(), state, (t_row - t_prev) / (time - t_prev), time - t_prev, _interpolated);
+            emit(_interpolated, t_row);
+        }
+    }
+    observe(state, time);
+}
+
+void interval_sampler_impl::interpolate(const system_state& a, const system_state& b, real s, real dt_s, system_state& result) {
+    // cubic Hermite basis
+    const real s2  = s * s;
+    const real s3  = s2 * s;
+    const real h00 = (2.0 * s3) - (3.0 * s2) + 1.0;
+    const real h10 = s3 - (2.0 * s2) + s;
+    const real h01 = (-2.0 * s3) + (3.0 * s2);
+    const real h11 = s3 - s2;
+
+    result.position_m           = (h00 * a.position_m) + (h10 * dt_s * a.velocity_m_s) + (h01 * b.position_m) + (h11 * dt_s * b.velocity_m_s);
+    result.velocity_m_s         = a.velocity_m_s + (s * (b.velocity_m_s - a.velocity_m_s));
+    result.attitude             = a.attitude.slerp(s, b.attitude);
+    result.angular_velocity_m_s = a.angular_velocity_m_s + (s * (b.angular_velocity_m_s - a.angular_velocity_m_s));
+    result.rod_magnetizations   = a.rod_magnetizations + (s * (b.rod_magnetizations - a.rod_magnetizations));
+}
+
+change_sampler_impl::change_sampler_impl(emit_function emit, const sampling_properties& properties)
+    : sampler_impl(std::move(emit)),
+      _angular_velocity_rad_s(properties.angular_velocity_rad_s > 0.0 ? properties.angular_velocity_rad_s : std::numeric_limits<real>::infinity()),
+      _attitude_cos(properties.attitude_deg > 0.0 ? std::cos(0.5 * properties.attitude_deg * deg_to_rad) : -1.0),
+      _max_gap_s(properties.interval_s > 0.0 ? properties.interval_s : std::numeric_limits<real>::infinity()) {}
+
+void change_sampler_impl::sample(const system_state& state, real time) {
+    // |q_last . q| = cos(angle / 2), independent of the quaternion sign
+    const bool changed = not _started                                                                          //
+                         || (state.angular_velocity_m_s - _last_angular_velocity).norm() > _angular_velocity_rad_s  //
+                         || std::abs(_last_attitude.dot(state.attitude)) < _attitude_cos                        //
+                         || time - _last_time >= _max_gap_s;
+
+    if (changed) {
+        emit(state, time);
+        _last_angular_velocity = state.angular_velocity_m_s;
+        _last_attitude         = state.attitude;
+        _last_time             = time;
+        _started               = true;
+    }
+    observe(state, time);
+}
+
+extrema_sampler_impl::extrema_sampler_impl(emit_function emit, real interval_s) : sampler_impl(std::move(emit)), _interval_s(interval_s) {}
+
+void extrema_sampler_impl::sample(const system_state& state, real time) {
+    if (not has_observed()) {
+        _t_0 = time;
+    }
+
+    const auto bucket = static_cast<std::size_t>(std::max(0.0, std::floor((time - _t_0) / _interval_s)));
+    if (_open && bucket != _bucket) {
+        emit_bucket();
+    }
+
+    const real omega = state.angular_velocity_m_s.norm();
+    auto       keep  = [&](slot_index index) {
+        _slots[index].state = state;
+        _slots[index].time  = time;
+        _slots[index].omega = omega;
+    };
+
+    if (not _open) {
+        for (const auto index : {slot_first, slot_min, slot_max}) {
+            keep(index);
+        }
+        _bucket = bucket;
+        _open   = true;
+    } else if (omega < _slots[slot_min].omega) {
+        keep(slot_min);
+    } else if (omega > _slots[slot_max].omega) {
+        keep(slot_max);
+    }
+    keep(slot_last);
+    observe(state, time);
+}
+
+void extrema_sampler_impl::flush() {
+    if (_open) {
+        emit_bucket();
+    }
+    sampler_impl::flush();
+}
+
+void extrema_sampler_impl::emit_bucket() {
+    std::array<const slot*, slot_count> order{&_slots[slot_first], &_slots[slot_min], &_slots[slot_max], &_slots[slot_last]};
+    std::ranges::sort(order, {}, &slot::time);
+
+    // a slot can hold the same state as another, e.g. the first state is also the minimum
+    real last_time = -std::numeric_limits<real>::infinity();
+    for (const slot* entry : order) {
+        if (entry->time > last_time) {
+            emit(entry->state, entry->time);
+            last_time = entry->time;
+        }
+    }
+    _open = false;
+}
+
+}  // namespace aos
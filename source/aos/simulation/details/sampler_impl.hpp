@@ -0,0 +1,121 @@
+#pragma once
+
+#include "aos/core/state.hpp"
+#include "aos/core/types.hpp"
+#include "aos/simulation/sampler.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace aos {
+
+// common part of the policies: forwards to the emit function and keeps the latest observed state for flush()
+class sampler_impl : public sampler {
+public:
+
+    explicit sampler_impl(emit_function emit);
+
+    // emits the latest observed state unless it already was
+    void flush() override;
+
+protected:
+
+    void emit(const system_state& state, real time);
+
+    // remember the state flush() emits
+    void observe(const system_state& state, real time);
+
+    [[nodiscard]] auto has_observed() const -> bool;
+    [[nodiscard]] auto latest() const -> const system_state&;
+    [[nodiscard]] auto latest_time() const -> real;
+
+private:
+
+    emit_function _emit;
+    system_state  _latest;
+    real          _latest_time{};
+    real          _emitted_time{};
+    bool          _observed{};
+    bool          _emitted{};
+};
+
+class every_nth_sampler_impl : public sampler_impl {
+public:
+
+    every_nth_sampler_impl(emit_function emit, std::size_t every);
+
+    void sample(const system_state& state, real time) override;
+
+private:
+
+    std::size_t _every;
+    std::size_t _count{};
+};
+
+// rows on the grid t_0 + k * interval; position by cubic Hermite (velocity as slope), attitude by slerp, the rest linear
+class interval_sampler_impl : public sampler_impl {
+public:
+
+    interval_sampler_impl(emit_function emit, real interval_s);
+
+    void sample(const system_state& state, real time) override;
+
+    // s in [0, 1] between a (at time 0) and b (at time dt_s)
+    static void interpolate(const system_state& a, const system_state& b, real s, real dt_s, system_state& result);
+
+private:
+
+    real         _interval_s;
+    real         _t_0{};
+    std::size_t  _next{1};       // grid index of the next row
+    system_state _interpolated;  // reused for every row
+};
+
+class change_sampler_impl : public sampler_impl {
+public:
+
+    change_sampler_impl(emit_function emit, const sampling_properties& properties);
+
+    void sample(const system_state& state, real time) override;
+
+private:
+
+    real _angular_velocity_rad_s;
+    real _attitude_cos;  // cos of half the attitude bound, rows once |q_last . q| drops below
+    real _max_gap_s;
+    vec3 _last_angular_velocity{vec3::Zero()};
+    quat _last_attitude{quat::Identity()};
+    real _last_time{};
+    bool _started{};
+};
+
+// M4 decimation on |w|: per bucket the first, last, smallest and largest |w| state, in time order
+class extrema_sampler_impl : public sampler_impl {
+public:
+
+    extrema_sampler_impl(emit_function emit, real interval_s);
+
+    void sample(const system_state& state, real time) override;
+    void flush() override;
+
+private:
+
+    struct slot {
+        system_state state;
+        real         time{};
+        real         omega{};
+    };
+
+    enum slot_index : uint8_t { slot_first, slot_min, slot_max, slot_last, slot_count };
+
+    void emit_bucket();
+
+    real                         _interval_s;
+    real                         _t_0{};
+    std::size_t                  _bucket{};  // index of the open bucket
+    std::array<slot, slot_count> _slots;
+    bool                         _open{};
+};
+
+}  // namespace aos
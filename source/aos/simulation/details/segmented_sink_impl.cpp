@@ -0,0 +1,126 @@
+#include "segmented_sink_impl.hpp"
+
+#include "aos/core/constants.hpp"
+#include "aos/core/types.hpp"
+#include "aos/simulation/observer.hpp"
+#include "aos/simulation/row_sink.hpp"
+#include "aos/simulation/segment_manifest.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <ios>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+namespace aos {
+
+segmented_sink_impl::segmented_sink_impl(const std::string& filename, const segment_properties& properties, sink_factory create_sink)
+    : _filename(filename),
+      _create_sink(std::move(create_sink)),
+      _max_rows(static_cast<std::uint64_t>(std::max(properties.rows, 0))),
+      _max_bytes(static_cast<std::uint64_t>(std::max<std::int64_t>(properties.bytes, 0))),
+      _period_s(std::max(properties.days, 0.0) * day_to_seconds) {
+    _sink = _create_sink(segment_filename(_filename, _segment));
+
+    _manifest.open(segment_manifest_filename(_filename), std::ios::binary);
+    if (not _manifest.is_open()) {
+        throw std::runtime_error("Observer could not open segment manifest: " + segment_manifest_filename(_filename));
+    }
+    _manifest << segment_manifest_header << '\n' << std::flush;
+}
+
+segmented_sink_impl::~segmented_sink_impl() {
+    if (_sink) {
+        close_segment();
+    }
+}
+
+void segmented_sink_impl::write_header(std::span<const observer_column> columns) {
+    // a segment holds a single header: a second run starts the next segment, an empty segment starts over
+    if (not _columns.empty()) {
+        if (_rows > 0) {
+            close_segment();
+            ++_segment;
+        }
+        _sink.reset();
+        _sink = _create_sink(segment_filename(_filename, _segment));
+        _rows = 0;
+    }
+
+    _columns.assign(columns.begin(), columns.end());
+    _sink->write_header(_columns);
+}
+
+void segmented_sink_impl::write_rows(std::span<const real> values, std::size_t num_rows) {
+    const std::size_t width = _columns.size();
+
+    for (std::size_t row = 0; row < num_rows; ++row) {
+        const auto row_values = values.subspan(row * width, width);
+        const real t_sec      = row_values[0];
+
+        if (segment_full(t_sec)) {
+            close_segment();
+            ++_segment;
+            open_segment();
+        }
+
+        _sink->write_rows(row_values, 1);
+        if (_rows++ == 0) {
+            _t_first = t_sec;
+        }
+        _t_last = t_sec;
+    }
+}
+
+void segmented_sink_impl::flush() {
+    _sink->flush();
+    _manifest.flush();
+}
+
+auto segmented_sink_impl::size() const -> std::uint64_t {
+    return _closed_bytes + _sink->size();
+}
+
+auto segmented_sink_impl::segment_full(real t_sec) const -> bool {
+    if (_rows == 0) {
+        return false;
+    }
+    return (_max_rows > 0 && _rows >= _max_rows) || (_max_bytes > 0 && _sink->size() >= _max_bytes) ||
+           (_period_s > 0.0 && std::floor(t_sec / _period_s) != std::floor(_t_first / _period_s));
+}
+
+void segmented_sink_impl::open_segment() {
+    _sink = _create_sink(segment_filename(_filename, _segment));
+    _sink->write_header(_columns);
+    _rows = 0;
+}
+
+void segmented_sink_impl::close_segment() {
+    _sink.reset();  // a binary segment gets its index here
+
+    const std::filesystem::path path(segment_filename(_filename, _segment));
+    std::error_code             error;
+    const auto                  bytes = std::filesystem::file_size(path, error);
+    _closed_bytes += error ? 0 : bytes;
+
+    const real nan = std::numeric_limits<real>::quiet_NaN();
+    _manifest << std::format("{},{},{},{},{},{}\n",
+                             _segment,
+                             path.filename().string(),
+                             _rows > 0 ? _t_first : nan,
+                             _rows > 0 ? _t_last : nan,
+                             _rows,
+                             error ? 0 : bytes)
+              << std::flush;
+}
+
+}  // namespace aos
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "aos/core/types.hpp"
+#include "aos/simulation/observer.hpp"
+#include "aos/simulation/row_sink.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace aos {
+
+// rows go to a sequence of complete files that are rotated by rows, bytes or simulated days, see segment_manifest.hpp
+class segmented_sink_impl : public row_sink {
+public:
+
+    // sink for one segment file
+    using sink_factory = std::function<std::unique_ptr<row_sink>(const std::string& filename)>;
+
+    segmented_sink_impl(const segmented_sink_impl&)                    = delete;
+    segmented_sink_impl(segmented_sink_impl&&)                         = delete;
+    auto operator=(const segmented_sink_impl&) -> segmented_sink_impl& = delete;
+    auto operator=(segmented_sink_impl&&) -> segmented_sink_impl&      = delete;
+
+    segmented_sink_impl(const std::string& filename, const segment_properties& properties, sink_factory create_sink);
+    ~segmented_sink_impl() override;  // closes and lists the last segment
+
+    void write_header(std::span<const observer_column> columns) override;
+    void write_rows(std::span<const real> values, std::size_t num_rows) override;
+    void flush() override;
+
+    // [bytes] of all segments
+    [[nodiscard]] auto size() const -> std::uint64_t override;
+
+protected:
+
+    // whether a row at t_sec goes to a new segment
+    [[nodiscard]] auto segment_full(real t_sec) const -> bool;
+
+    // start the next segment with the current header
+    void open_segment();
+
+    // write out the current segment and append it to the manifest
+    void close_segment();
+
+private:
+
+    std::string                  _filename;
+    sink_factory                 _create_sink;
+    std::unique_ptr<row_sink>    _sink;            // current segment
+    std::ofstream                _manifest;
+    std::vector<observer_column> _columns;
+    std::uint64_t                _max_rows;        // 0: no limit
+    std::uint64_t                _max_bytes;       // [bytes] 0: no limit
+    real                         _period_s;        // [s] 0: no limit
+    std::size_t                  _segment{};       // number of the current segment
+    std::uint64_t                _closed_bytes{};  // [bytes] of the closed segments
+    std::uint64_t                _rows{};          // in the current segment
+    real                         _t_first{};       // [s] first row of the current segment
+    real                         _t_last{};        // [s]
+};
+
+}  // namespace aos
@@ -0,0 +1,99 @@
+#include "statistics_observer_impl.hpp"
+
+#include "aos/components/spacecraft.hpp"
+#include "aos/core/state.hpp"
+#include "aos/core/types.hpp"
+#include "aos/environment/environment.hpp"
+#include "aos/simulation/dynamics.hpp"
+#include "aos/simulation/observer.hpp"
+#include "aos/simulation/statistics_observer.hpp"
+#include "aos/simulation/stop_criteria.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <print>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace aos {
+
+statistics_observer_impl::statistics_observer_impl(std::string                        filename,
+                                                   std::shared_ptr<const spacecraft>  sat,
+                                                   std::shared_ptr<const environment> env,
+                                                   const spacecraft_properties&       satellite_properties,
+                                                   const observer_properties&         props,
+                                                   std::shared_ptr<dynamics>          dyn)
+    : _filename(std::move(filename)), _sat(std::move(sat)), _env(std::move(env)), _properties(props.statistics), _rod_energy(satellite_properties) {
+    if (dyn) {
+        dyn->enable_diagnostics();
+        _dynamics = std::move(dyn);
+    }
+}
+
+void statistics_observer_impl::write_header() {}
+
+void statistics_observer_impl::write(const system_state& state, real time) {
+    const auto effects  = observed_environment(*_env, _dynamics.get(), state, time);
+    const real omega    = state.angular_velocity_m_s.norm();
+    const real pointing = stop_criteria::pointing_error_deg(state.attitude, _sat->magnet().magnetic_moment(), effects.magnetic_field_eci_T);
+
+    if (not _started) {
+        _statistics.t_start = time;
+        _started            = true;
+        _t_previous         = time;
+    }
+
+    // each sample stands for the time since the previous one
+    const real weight_s = time - _t_previous;
+    _statistics.angular_velocity.add(omega, weight_s);
+    _statistics.pointing.add(pointing, weight_s);
+    _orbit_angular_velocity.add(omega, weight_s);
+    _orbit_pointing.add(pointing, weight_s);
+
+    if (_properties.angular_velocity_rad_s > 0.0) {
+        _statistics.angular_velocity_below.update(omega, _properties.angular_velocity_rad_s, time);
+    }
+    if (_properties.pointing_deg > 0.0) {
+        _statistics.pointing_below.update(pointing, _properties.pointing_deg, time);
+    }
+
+    const vec3 field_body = state.attitude.normalized().inverse() * effects.magnetic_field_eci_T;
+    if (_rod_energy.update(state, field_body, time, stop_criteria::orbital_period_s(state))) {
+        _statistics.orbits                       = _rod_energy.complete_orbits();
+        _statistics.orbit_angular_velocity_rad_s = _orbit_angular_velocity.mean;
+        _statistics.orbit_pointing_deg           = _orbit_pointing.mean;
+        _statistics.orbit_rod_energy_J           = _rod_energy.last_orbit_energy();
+        _orbit_angular_velocity                  = {};
+        _orbit_pointing                          = {};
+    }
+
+    _statistics.t_end                        = time;
+    _statistics.final_angular_velocity_rad_s = omega;
+    _statistics.final_pointing_deg           = pointing;
+    _t_previous                              = time;
+}
+
+void statistics_observer_impl::flush() {
+    if (_filename.empty()) {
+        return;
+    }
+
+    std::filesystem::path file_path(_filename);
+    if (file_path.has_parent_path()) {
+        std::filesystem::create_directories(file_path.parent_path());
+    }
+
+    std::ofstream file(_filename);
+    if (not file.is_open()) {
+        throw std::runtime_error("Observer could not open output file: " + _filename);
+    }
+    std::println(file, "{}", _statistics.summary_line());
+}
+
+auto statistics_observer_impl::statistics() const -> const run_statistics& {
+    return _statistics;
+}
+
+}  // namespace aos
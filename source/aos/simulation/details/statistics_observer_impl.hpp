@@ -0,0 +1,50 @@
+#pragma once
+
+#include "aos/components/spacecraft.hpp"
+#include "aos/core/state.hpp"
+#include "aos/core/types.hpp"
+#include "aos/environment/environment.hpp"
+#include "aos/simulation/dynamics.hpp"
+#include "aos/simulation/observer.hpp"
+#include "aos/simulation/rod_energy_meter.hpp"
+#include "aos/simulation/statistics_observer.hpp"
+
+#include <memory>
+#include <string>
+
+namespace aos {
+
+class statistics_observer_impl : public statistics_observer {
+public:
+
+    statistics_observer_impl(std::string                        filename,
+                             std::shared_ptr<const spacecraft>  sat,
+                             std::shared_ptr<const environment> env,
+                             const spacecraft_properties&       satellite_properties,
+                             const observer_properties&         props,
+                             std::shared_ptr<dynamics>          dyn);
+
+    void write_header() override;
+    void write(const system_state& state, real time) override;
+
+    // writes the summary line, the file is rewritten on every call
+    void flush() override;
+
+    [[nodiscard]] auto statistics() const -> const run_statistics& override;
+
+private:
+
+    std::string                        _filename;
+    std::shared_ptr<const spacecraft>  _sat;
+    std::shared_ptr<const environment> _env;
+    std::shared_ptr<const dynamics>    _dynamics;  // optional
+    statistics_properties              _properties;
+    rod_energy_meter                   _rod_energy;
+    running_statistics                 _orbit_angular_velocity;  // current orbit
+    running_statistics                 _orbit_pointing;          // current orbit
+    run_statistics                     _statistics;
+    real                               _t_previous{};
+    bool                               _started{};
+};
+
+}  // namespace aos
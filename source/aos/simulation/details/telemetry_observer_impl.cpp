@@ -0,0 +1,143 @@
+#include "telemetry_observer_impl.hpp"
+
+#include "aos/core/state.hpp"
+#include "aos/core/types.hpp"
+#include "aos/simulation/observer.hpp"
+#include "aos/simulation/telemetry_format.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace aos {
+
+namespace {
+
+constexpr std::size_t state_columns = 11;  // time, r, q, w; the rods follow
+
+auto column_names(std::size_t num_rods) -> std::string {
+    std::string names = "time,r_x,r_y,r_z,q_w,q_x,q_y,q_z,w_x,w_y,w_z";
+    for (std::size_t i = 0; i < num_rods; ++i) {
+        names += ",M_" + std::to_string(i + 1);
+    }
+    return names;
+}
+
+auto align_up(std::size_t bytes) -> std::size_t {
+    return (bytes + telemetry_alignment - 1) / telemetry_alignment * telemetry_alignment;
+}
+
+}  // namespace
+
+telemetry_observer_impl::telemetry_observer_impl(std::shared_ptr<observer> inner, std::size_t num_rods, const telemetry_properties& props)
+    : _inner(std::move(inner)),
+      _name(props.name),
+      _num_columns(state_columns + num_rods),
+      _capacity(static_cast<std::size_t>(std::max(props.samples, 1))),
+      _interval_s(props.interval_s) {
+    const std::string names        = column_names(num_rods);
+    const std::size_t names_offset = sizeof(telemetry_header);
+    const std::size_t data_offset  = align_up(names_offset + names.size());
+    _mapping_bytes                 = data_offset + (_capacity * _num_columns * sizeof(real));
+
+    // a leftover object of a killed run with the same name is reused and cleared
+    const int fd = shm_open(_name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);  // NOLINT(cppcoreguidelines-pro-type-vararg)
+    if (fd < 0) {
+        throw std::runtime_error("Could not create telemetry shared memory " + _name + ": " + std::strerror(errno));
+    }
+
+    if (ftruncate(fd, static_cast<off_t>(_mapping_bytes)) == 0) {
+        _mapping = mmap(nullptr, _mapping_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    const int error = errno;
+    close(fd);
+
+    if (_mapping == nullptr || _mapping == MAP_FAILED) {
+        _mapping = nullptr;
+        shm_unlink(_name.c_str());
+        throw std::runtime_error("Could not map telemetry shared memory " + _name + ": " + std::strerror(error));
+    }
+
+    auto* bytes = static_cast<std::byte*>(_mapping);
+    _header     = new (_mapping) telemetry_header{};
+    _slots      = reinterpret_cast<real*>(bytes + data_offset);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+    _header->version      = telemetry_version;
+    _header->num_columns  = static_cast<std::uint32_t>(_num_columns);
+    _header->capacity     = _capacity;
+    _header->names_offset = names_offset;
+    _header->names_size   = names.size();
+    _header->data_offset  = data_offset;
+    std::memcpy(bytes + names_offset, names.data(), names.size());
+
+    std::atomic_thread_fence(std::memory_order_release);
+    _header->magic = telemetry_magic;
+}
+
+telemetry_observer_impl::~telemetry_observer_impl() {
+    if (_mapping == nullptr) {
+        return;
+    }
+
+    _header->finished.store(1, std::memory_order_release);
+    munmap(_mapping, _mapping_bytes);
+    shm_unlink(_name.c_str());  // attached readers keep their mapping
+}
+
+void telemetry_observer_impl::write_header() {
+    _inner->write_header();
+}
+
+void telemetry_observer_impl::write(const system_state& state, real time) {
+    if (time - _t_published >= _interval_s) {
+        publish(state, time);
+        _t_published = time;
+    }
+    _inner->write(state, time);
+}
+
+void telemetry_observer_impl::flush() {
+    _inner->flush();
+}
+
+void telemetry_observer_impl::publish(const system_state& state, real time) {
+    real* slot = _slots + ((_count % _capacity) * _num_columns);
+
+    const auto sequence = _header->sequence.load(std::memory_order_relaxed);
+    _header->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // NOLINTBEGIN(readability-magic-numbers)
+    slot[0]  = time;
+    slot[1]  = state.position_m.x();
+    slot[2]  = state.position_m.y();
+    slot[3]  = state.position_m.z();
+    slot[4]  = state.attitude.w();
+    slot[5]  = state.attitude.x();
+    slot[6]  = state.attitude.y();
+    slot[7]  = state.attitude.z();
+    slot[8]  = state.angular_velocity_m_s.x();
+    slot[9]  = state.angular_velocity_m_s.y();
+    slot[10] = state.angular_velocity_m_s.z();
+    for (std::size_t i = state_columns; i < _num_columns; ++i) {
+        slot[i] = state.rod_magnetizations(static_cast<Eigen::Index>(i - state_columns));
+    }
+    // NOLINTEND(readability-magic-numbers)
+
+    _header->count.store(++_count, std::memory_order_relaxed);
+    _header->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+}  // namespace aos
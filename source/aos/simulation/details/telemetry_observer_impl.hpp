@@ -0,0 +1,51 @@
+#pragma once
+
+#include "aos/core/state.hpp"
+#include "aos/core/types.hpp"
+#include "aos/simulation/observer.hpp"
+#include "aos/simulation/telemetry_format.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+
+namespace aos {
+
+class telemetry_observer_impl : public observer {
+public:
+
+    telemetry_observer_impl(const telemetry_observer_impl&)                    = delete;
+    telemetry_observer_impl(telemetry_observer_impl&&)                         = delete;
+    auto operator=(const telemetry_observer_impl&) -> telemetry_observer_impl& = delete;
+    auto operator=(telemetry_observer_impl&&) -> telemetry_observer_impl&      = delete;
+
+    telemetry_observer_impl(std::shared_ptr<observer> inner, std::size_t num_rods, const telemetry_properties& props);
+    ~telemetry_observer_impl() override;  // marks the ring finished, unmaps and removes it
+
+    void write_header() override;
+    void write(const system_state& state, real time) override;
+    void flush() override;
+
+protected:
+
+    // copy one sample into the next slot under the seqlock
+    void publish(const system_state& state, real time);
+
+private:
+
+    std::shared_ptr<observer> _inner;
+    std::string               _name;
+    std::size_t               _mapping_bytes{};
+    void*                     _mapping{};
+    telemetry_header*         _header{};
+    real*                     _slots{};
+    std::size_t               _num_columns;
+    std::size_t               _capacity;
+    std::uint64_t             _count{};
+    real                      _interval_s;
+    real                      _t_published{-std::numeric_limits<real>::infinity()};
+};
+
+}  // namespace aos
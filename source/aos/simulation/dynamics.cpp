@@ -1,6 +1,9 @@
 #include "dynamics.hpp"
 
+#include "aos/core/force_models.hpp"
+#include "aos/core/state.hpp"
 #include "aos/core/types.hpp"
+#include "aos/environment/environment.hpp"
 #include "aos/simulation/details/dynamics_impl.hpp"
 
 #include <memory>
@@ -8,6 +11,11 @@
 
 namespace aos {
 
+auto step_diagnostics::matches(real time, const vec3& position, const vec3& velocity) const -> bool {
+    // exact comparison: reuse only the very same evaluation, never a nearby one
+    return complete && time == t_sec && position == position_m && velocity == velocity_m_s;
+}
+
 dynamics::dynamics()  = default;
 dynamics::~dynamics() = default;
 
@@ -19,8 +27,37 @@ void dynamics::set_time_offset(real offset_s) {
     _time_offset = offset_s;
 }
 
-auto dynamics::create(std::shared_ptr<const spacecraft> spacecraft, std::shared_ptr<const environment> environment) -> std::shared_ptr<dynamics> {
-    return std::make_shared<dynamics_impl>(std::move(spacecraft), std::move(environment));
+void dynamics::enable_diagnostics() {
+    _diagnostics_enabled = true;
+}
+
+auto dynamics::diagnostics() const -> const step_diagnostics* {
+    return _diagnostics_enabled ? &_diagnostics : nullptr;
+}
+
+auto dynamics::diagnostics_enabled() const noexcept -> bool {
+    return _diagnostics_enabled;
+}
+
+void dynamics::record_diagnostics(real t_sec, const system_state& state, const environment_effects& env, bool complete) const {
+    _diagnostics.t_sec        = t_sec;
+    _diagnostics.position_m   = state.position_m;
+    _diagnostics.velocity_m_s = state.velocity_m_s;
+    _diagnostics.environment  = env;
+    _diagnostics.complete     = complete;
+}
+
+auto observed_environment(const environment& env, const dynamics* dyn, const system_state& state, real t_sec) -> environment_effects {
+    const auto* recorded = dyn != nullptr ? dyn->diagnostics() : nullptr;
+    if (recorded != nullptr && recorded->matches(t_sec, state.position_m, state.velocity_m_s)) {
+        return recorded->environment;
+    }
+    return env.compute_effects(t_sec, state.position_m, state.velocity_m_s);
+}
+
+auto dynamics::create(std::shared_ptr<spacecraft> spacecraft, std::shared_ptr<const environment> environment, const force_model_set& models)
+    -> std::shared_ptr<dynamics> {
+    return create_dynamics_impl(std::move(spacecraft), std::move(environment), models);
 }
 
 }  // namespace aos
@@ -1,14 +1,28 @@
 #pragma once
 
+#include "aos/core/force_models.hpp"
 #include "aos/core/state.hpp"
 #include "aos/core/types.hpp"
+#include "aos/environment/environment.hpp"
 
+#include <limits>
 #include <memory>
 
 namespace aos {
 
 class spacecraft;
-class environment;
+
+// environment of the most recent evaluation by the dynamics, recorded once dynamics::enable_diagnostics() was called
+struct step_diagnostics {
+    real                t_sec{std::numeric_limits<real>::quiet_NaN()};  // [s] absolute, time offset included
+    vec3                position_m{vec3::Zero()};
+    vec3                velocity_m_s{vec3::Zero()};
+    environment_effects environment{};
+    bool                complete{};  // every input evaluated, a reduced model set leaves the inputs of disabled models zero
+
+    // true if `environment` is the complete environment at exactly this time and orbit state
+    [[nodiscard]] auto matches(real time, const vec3& position, const vec3& velocity) const -> bool;
+};
 
 class dynamics {
 public:
@@ -23,15 +37,36 @@ public:
 
     virtual void step(const system_state& current_state, system_state& state_derivative, real t_sec) const = 0;
 
+    // called once per accepted step, may update the parts of the state that are not integrated
+    virtual void accept_step(system_state& state, real t_sec) = 0;
+
     [[nodiscard]]
     auto get_time_offset() const noexcept -> real;
     void set_time_offset(real offset_s);
 
-    static auto create(std::shared_ptr<const spacecraft> spacecraft, std::shared_ptr<const environment> environment) -> std::shared_ptr<dynamics>;
+    // from now on every environment evaluation is recorded, observers that need the environment of the observed state
+    // read it from diagnostics() instead of evaluating it a second time
+    void enable_diagnostics();
+
+    // nullptr until enable_diagnostics() was called
+    [[nodiscard]] auto diagnostics() const -> const step_diagnostics*;
+
+    static auto create(std::shared_ptr<spacecraft> spacecraft, std::shared_ptr<const environment> environment, const force_model_set& models = {})
+        -> std::shared_ptr<dynamics>;
+
+protected:
+
+    [[nodiscard]] auto diagnostics_enabled() const noexcept -> bool;
+    void               record_diagnostics(real t_sec, const system_state& state, const environment_effects& env, bool complete) const;
 
 private:
 
-    real _time_offset{};
+    real                     _time_offset{};
+    bool                     _diagnostics_enabled{};
+    mutable step_diagnostics _diagnostics;  // written by the const right-hand side
 };
 
+// environment at an observed state: the one dyn recorded if it belongs to exactly this state, evaluated otherwise (dyn may be null)
+[[nodiscard]] auto observed_environment(const environment& env, const dynamics* dyn, const system_state& state, real t_sec) -> environment_effects;
+
 }  // namespace aos
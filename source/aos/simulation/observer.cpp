@@ -1,26 +1,103 @@
 #include "observer.hpp"
 
 #include "aos/core/types.hpp"
+#include "aos/simulation/details/null_observer_impl.hpp"
 #include "aos/simulation/details/observer_impl.hpp"
 
 #include <toml++/toml.hpp>
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <stdexcept>
 #include <string>
 
 namespace aos {
 
+void statistics_properties::from_toml(const toml_table& table) {
+    angular_velocity_rad_s = table["angular_velocity"].value_or(0.0);
+    pointing_deg           = table["pointing"].value_or(0.0);
+}
+
+void telemetry_properties::from_toml(const toml_table& table) {
+    name       = table["name"].value_or<std::string>("");
+    samples    = table["samples"].value_or(default_samples);
+    interval_s = table["interval"].value_or(0.0);
+}
+
+auto segment_properties::enabled() const -> bool {
+    return rows > 0 || bytes > 0 || days > 0.0;
+}
+
+void segment_properties::from_toml(const toml_table& table) {
+    rows  = table["rows"].value_or(0);
+    bytes = table["bytes"].value_or<std::int64_t>(0);
+    days  = table["days"].value_or(0.0);
+}
+
 void observer_properties::from_toml(const toml_table& table) {
     exclude_elements   = table["exclude_elements"].value_or(false);
     exclude_magnitudes = table["exclude_magnitudes"].value_or(false);
     precission         = table["precission"].value_or(default_precission);
+    shortest           = table["shortest"].value_or(false);
+    buffer_rows        = table["buffer_rows"].value_or(default_buffer_rows);
+    index_rows         = table["index_rows"].value_or(0);
+    single_precision   = table["single_precision"].value_or(false);
+    orbit_summary      = table["orbit_summary"].value_or(false);
+
+    if (buffer_rows <= 0) {
+        throw std::invalid_argument("Observer buffer_rows must be positive.");
+    }
+    if (index_rows < 0) {
+        throw std::invalid_argument("Observer index_rows must not be negative.");
+    }
+
+    if (const auto* arr = table["diagnostics"].as_array()) {
+        diagnostics.clear();
+        diagnostics.reserve(arr->size());
+        for (std::size_t i = 0; i < arr->size(); ++i) {
+            diagnostics.push_back(arr->get(i)->value_or<std::string>(""));
+        }
+    }
+
+    if (const auto* sampling_table = table["sampling"].as_table()) {
+        sampling.from_toml(*sampling_table);
+    }
+    if (const auto* statistics_table = table["statistics"].as_table()) {
+        statistics.from_toml(*statistics_table);
+    }
+    if (const auto* telemetry_table = table["telemetry"].as_table()) {
+        telemetry.from_toml(*telemetry_table);
+    }
+    if (const auto* segments_table = table["segments"].as_table()) {
+        segments.from_toml(*segments_table);
+    }
+
+    const auto name = table["format"].value_or<std::string>("csv");
+    if (name == "csv") {
+        format = observer_format_csv;
+    } else if (name == "binary") {
+        format = observer_format_binary;
+    } else if (name == "statistics") {
+        format = observer_format_statistics;
+    } else {
+        throw std::runtime_error("Unknown observer format: " + name);
+    }
 }
 
 observer::~observer() = default;
 
+void observer::flush() {}
+
 auto observer::create(const std::string& filename, std::size_t num_rods, const observer_properties& properties) -> std::shared_ptr<observer> {
+    if (properties.format == observer_format_statistics) {
+        throw std::invalid_argument("Statistics output needs statistics_observer::create");
+    }
     return std::make_shared<observer_impl>(filename, num_rods, properties);
 }
 
+auto observer::create_null() -> std::shared_ptr<observer> {
+    return std::make_shared<null_observer_impl>();
+}
+
 }  // namespace aos
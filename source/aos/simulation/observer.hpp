@@ -2,20 +2,67 @@
 
 #include "aos/core/state.hpp"
 #include "aos/core/types.hpp"
+#include "aos/simulation/sampler.hpp"
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
-#include <ostream>
 #include <string>
+#include <vector>
 
 namespace aos {
 
+enum observer_format : uint8_t {
+    observer_format_csv,         // comma separated text
+    observer_format_binary,      // columnar chunks with a time index, see trajectory_format.hpp
+    observer_format_statistics,  // no trajectory, one summary line per run, see statistics_observer.hpp
+};
+
+struct statistics_properties {
+    real angular_velocity_rad_s{};  // [rad/s] threshold for the |w| crossing times, 0 disables
+    real pointing_deg{};            // [deg] threshold for the pointing error crossing times, 0 disables
+
+    void from_toml(const toml_table& table);
+};
+
+struct telemetry_properties {
+    static constexpr int default_samples = 4096;
+
+    std::string name;                      // POSIX shared-memory object ("/pmaos"), empty disables
+    int         samples{default_samples};  // ring capacity
+    real        interval_s{};              // [s] minimum simulated time between published samples, 0 publishes every state
+
+    void from_toml(const toml_table& table);
+};
+
+struct segment_properties {
+    int          rows{};   // rows per segment, 0 disables
+    std::int64_t bytes{};  // [bytes] a segment is closed once it holds at least this much, 0 disables
+    real         days{};   // [d] simulated days per segment, boundaries at multiples of it, 0 disables
+
+    [[nodiscard]] auto enabled() const -> bool;
+
+    void from_toml(const toml_table& table);
+};
+
 struct observer_properties {
-    static constexpr int default_precission = 5;
+    static constexpr int default_precission  = 5;
+    static constexpr int default_buffer_rows = 4096;
 
-    bool exclude_elements{};              // per-element entries
-    bool exclude_magnitudes{};            // magnitude (vector length) entries
-    int  precission{default_precission};  // output number decimal precision
+    bool                     exclude_elements{};                // per-element entries
+    bool                     exclude_magnitudes{};              // magnitude (vector length) entries
+    int                      precission{default_precission};    // output number decimal precision
+    bool                     shortest{};                        // csv: shortest round-trip values instead of fixed precission
+    int                      buffer_rows{default_buffer_rows};  // rows queued for the writer thread before write() waits
+    int                      index_rows{};                      // csv: sidecar time index entry every index_rows rows, 0 disables
+    observer_format          format{observer_format_csv};       // "csv", "binary" or "statistics"
+    bool                     single_precision{};                // binary: float32 values, time stays float64
+    sampling_properties      sampling;                          // which observed states become rows ([observer.sampling])
+    statistics_properties    statistics;                        // format = "statistics" ([observer.statistics])
+    telemetry_properties     telemetry;                         // live shared-memory ring ([observer.telemetry])
+    segment_properties       segments;                          // rolling output files and their manifest ([observer.segments])
+    bool                     orbit_summary{};                   // also one row per orbit in <output>_orbits, see orbit_summary_observer.hpp
+    std::vector<std::string> diagnostics;                       // verification: diagnostic channels to write, all if empty
 
     void from_toml(const toml_table& table);
 };
@@ -31,10 +78,16 @@ public:
 
     virtual ~observer();
 
-    virtual auto write_header() -> std::ostream&                              = 0;
-    virtual auto write(const system_state& state, real time) -> std::ostream& = 0;
+    virtual void write_header()                              = 0;
+    virtual void write(const system_state& state, real time) = 0;
+
+    // returns once every written row has reached the output, no-op by default
+    virtual void flush();
 
     static auto create(const std::string& filename, std::size_t num_rods, const observer_properties& properties) -> std::shared_ptr<observer>;
+
+    // observer that writes nothing
+    static auto create_null() -> std::shared_ptr<observer>;
 };
 
 }  // namespace aos
@@ -0,0 +1,39 @@
+#include "orbit_summary_observer.hpp"
+
+#include "aos/components/spacecraft.hpp"
+#include "aos/environment/environment.hpp"
+#include "aos/simulation/details/orbit_summary_observer_impl.hpp"
+#include "aos/simulation/dynamics.hpp"
+#include "aos/simulation/observer.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace aos {
+
+auto orbit_summary_observer::orbit_summary_filename(const std::string& output_filename) -> std::string {
+    std::filesystem::path path(output_filename);
+    path.replace_filename(path.stem().string() + "_orbits" + path.extension().string());
+    return path.string();
+}
+
+auto orbit_summary_observer::create(std::shared_ptr<observer>          inner,
+                                    const std::string&                 output_filename,
+                                    std::shared_ptr<const spacecraft>  satellite,
+                                    std::shared_ptr<const environment> environment,
+                                    std::size_t                        num_rods,
+                                    const observer_properties&         properties,
+                                    std::shared_ptr<dynamics>          dyn) -> std::shared_ptr<observer> {
+    return std::make_shared<orbit_summary_observer_impl>(std::move(inner),
+                                                         orbit_summary_filename(output_filename),
+                                                         std::move(satellite),
+                                                         std::move(environment),
+                                                         num_rods,
+                                                         properties,
+                                                         std::move(dyn));
+}
+
+}  // namespace aos
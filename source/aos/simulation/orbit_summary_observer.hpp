@@ -0,0 +1,42 @@
+#pragma once
+
+#include "aos/components/spacecraft.hpp"
+#include "aos/environment/environment.hpp"
+#include "aos/simulation/dynamics.hpp"
+#include "aos/simulation/observer.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace aos {
+
+/**
+ * @brief Reduces the observed states to one row per orbit in a second output, passing every state on to another observer.
+ *
+ * An orbit runs from one ascending node crossing (wrap of the argument of latitude) to the next; the arc before the
+ * first crossing and after the last one is not reported. A row holds the orbit start time and duration, time-weighted
+ * mean, minimum and maximum of |w| and of the angle between magnet and local field, the amplitude (half the peak to
+ * peak) of every rod magnetization, the eclipse fraction (mean of 1 - shadow factor) and mean and maximum of the drag
+ * torque magnitude. Rows go to orbit_summary_filename(output) in the format of the main output ([observer] format).
+ *
+ * The environment of each observed state comes from the dynamics' step diagnostics when it was computed there for
+ * that state (see step_diagnostics), otherwise it is evaluated once per state.
+ */
+class orbit_summary_observer {
+public:
+
+    // <stem>_orbits<extension> next to the main output
+    [[nodiscard]] static auto orbit_summary_filename(const std::string& output_filename) -> std::string;
+
+    // dyn may be null; throws std::runtime_error if the summary file cannot be opened
+    static auto create(std::shared_ptr<observer>          inner,
+                       const std::string&                 output_filename,
+                       std::shared_ptr<const spacecraft>  satellite,
+                       std::shared_ptr<const environment> environment,
+                       std::size_t                        num_rods,
+                       const observer_properties&         properties,
+                       std::shared_ptr<dynamics>          dyn = nullptr) -> std::shared_ptr<observer>;
+};
+
+}  // namespace aos
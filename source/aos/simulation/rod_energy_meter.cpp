@@ -0,0 +1,61 @@
+#include "rod_energy_meter.hpp"
+
+#include "aos/components/spacecraft.hpp"
+#include "aos/core/state.hpp"
+#include "aos/core/types.hpp"
+
+#include <cstddef>
+
+namespace aos {
+
+rod_energy_meter::rod_energy_meter(const spacecraft_properties& satellite) {
+    _rod_axes.reserve(satellite.rods.size());
+    for (const auto& rod : satellite.rods) {
+        _rod_axes.emplace_back(rod.orientation.normalized() * rod.volume_m3);
+    }
+    _fields.resize(static_cast<Eigen::Index>(_rod_axes.size()));
+}
+
+auto rod_energy_meter::has_rods() const -> bool {
+    return not _rod_axes.empty();
+}
+
+auto rod_energy_meter::update(const system_state& state, const vec3& field_body, real t_sec, real period_s) -> bool {
+    for (Eigen::Index i = 0; i < _fields.size(); ++i) {
+        _fields(i) = field_body.dot(_rod_axes[static_cast<std::size_t>(i)]);  // [T*m^3]
+    }
+
+    if (not _has_previous) {
+        _previous_magnetizations = state.rod_magnetizations;
+        _previous_fields         = _fields;
+        _orbit_start             = t_sec;
+        _has_previous            = true;
+        return false;
+    }
+
+    // trapezoid rule over the observed states
+    _orbit_energy += (0.5 * (_fields + _previous_fields).array() * (state.rod_magnetizations - _previous_magnetizations).array()).sum();
+
+    _previous_magnetizations = state.rod_magnetizations;
+    _previous_fields         = _fields;
+
+    if (t_sec - _orbit_start < period_s) {
+        return false;
+    }
+
+    ++_complete_orbits;
+    _last_orbit_energy = _orbit_energy;
+    _orbit_energy      = 0.0;
+    _orbit_start       = t_sec;
+    return true;
+}
+
+auto rod_energy_meter::complete_orbits() const -> int {
+    return _complete_orbits;
+}
+
+auto rod_energy_meter::last_orbit_energy() const -> real {
+    return _last_orbit_energy;
+}
+
+}  // namespace aos
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "aos/components/spacecraft.hpp"
+#include "aos/core/state.hpp"
+#include "aos/core/types.hpp"
+
+#include <vector>
+
+namespace aos {
+
+/**
+ * @brief Hysteresis energy the rods exchange with the field per orbit, W = sum over the rods of V * integral(B dM).
+ *
+ * B is the field component along the rod axis. The integral is a trapezoid rule over the observed states. An orbit
+ * is complete once one orbital period (passed in, usually from the vis-viva equation) has elapsed since the last
+ * boundary, so orbits are counted even for a spacecraft without rods.
+ */
+class rod_energy_meter {
+public:
+
+    explicit rod_energy_meter(const spacecraft_properties& satellite);
+
+    [[nodiscard]] auto has_rods() const -> bool;
+
+    // feed the next observed state (in time order), returns true when it completes an orbit
+    auto update(const system_state& state, const vec3& field_body, real t_sec, real period_s) -> bool;
+
+    [[nodiscard]] auto complete_orbits() const -> int;
+
+    // [J] exchanged in the last complete orbit
+    [[nodiscard]] auto last_orbit_energy() const -> real;
+
+private:
+
+    std::vector<vec3> _rod_axes;                 // [m^3] unit orientation scaled by the rod volume
+    vecX              _previous_magnetizations;  // [A/m]
+    vecX              _previous_fields;          // [T*m^3] field along each rod times its volume
+    vecX              _fields;                   // scratch for the current state
+    real              _orbit_start{};            // [s]
+    real              _orbit_energy{};           // [J] exchanged in the current orbit
+    real              _last_orbit_energy{};      // [J] exchanged in the last complete orbit
+    int               _complete_orbits{};
+    bool              _has_previous{};
+};
+
+}  // namespace aos
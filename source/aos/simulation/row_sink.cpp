@@ -0,0 +1,30 @@
+#include "row_sink.hpp"
+
+#include "aos/simulation/details/binary_sink_impl.hpp"
+#include "aos/simulation/details/csv_sink_impl.hpp"
+#include "aos/simulation/details/segmented_sink_impl.hpp"
+#include "aos/simulation/observer.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace aos {
+
+row_sink::~row_sink() = default;
+
+auto row_sink::create(const std::string& filename, const observer_properties& properties) -> std::unique_ptr<row_sink> {
+    auto create_file = [properties](const std::string& name) -> std::unique_ptr<row_sink> {
+        if (properties.format == observer_format_binary) {
+            return std::make_unique<binary_sink_impl>(name, properties.single_precision);
+        }
+        return std::make_unique<csv_sink_impl>(name, properties.precission, properties.shortest, static_cast<std::size_t>(properties.index_rows));
+    };
+
+    if (properties.segments.enabled()) {
+        return std::make_unique<segmented_sink_impl>(filename, properties.segments, create_file);
+    }
+    return create_file(filename);
+}
+
+}  // namespace aos
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "aos/core/types.hpp"
+#include "aos/simulation/observer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace aos {
+
+enum column_format : uint8_t {
+    column_format_fixed,     // fixed notation with the observer precision
+    column_format_shortest,  // shortest representation that round-trips
+};
+
+struct observer_column {
+    std::string   name;
+    column_format format{column_format_fixed};
+};
+
+/**
+ * @brief Destination of the rows an observer produces: one value per column, time first.
+ *
+ * A sink only formats and stores; it is driven from the writer thread of an async_writer, never concurrently.
+ */
+class row_sink {
+public:
+
+    row_sink()                                   = default;
+    row_sink(const row_sink&)                    = delete;
+    row_sink(row_sink&&)                         = delete;
+    auto operator=(const row_sink&) -> row_sink& = delete;
+    auto operator=(row_sink&&) -> row_sink&      = delete;
+
+    virtual ~row_sink();
+
+    virtual void write_header(std::span<const observer_column> columns) = 0;
+
+    // num_rows consecutive rows, values.size() == num_rows * number of columns
+    virtual void write_rows(std::span<const real> values, std::size_t num_rows) = 0;
+
+    // hand everything written so far to the operating system
+    virtual void flush() = 0;
+
+    // [bytes] in the file once everything written so far reached it (binary: without chunk padding and the index)
+    [[nodiscard]] virtual auto size() const -> std::uint64_t = 0;
+
+    // sink for properties.format, segmented if properties.segments asks for it (see segment_manifest.hpp);
+    // throws std::runtime_error if the file cannot be opened
+    static auto create(const std::string& filename, const observer_properties& properties) -> std::unique_ptr<row_sink>;
+};
+
+}  // namespace aos
@@ -0,0 +1,64 @@
+#include "sampler.hpp"
+
+#include "aos/core/types.hpp"
+#include "aos/simulation/details/sampler_impl.hpp"
+
+#include <toml++/toml.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace aos {
+
+void sampling_properties::from_toml(const toml_table& table) {
+    every                  = table["every"].value_or(default_every);
+    interval_s             = table["interval"].value_or(default_interval);
+    angular_velocity_rad_s = table["angular_velocity"].value_or(0.0);
+    attitude_deg           = table["attitude"].value_or(0.0);
+
+    const auto name = table["policy"].value_or<std::string>("all");
+    if (name == "all") {
+        policy = sampling_policy_all;
+    } else if (name == "every_nth") {
+        policy = sampling_policy_every_nth;
+    } else if (name == "interval") {
+        policy = sampling_policy_interval;
+    } else if (name == "change") {
+        policy = sampling_policy_change;
+    } else if (name == "extrema") {
+        policy = sampling_policy_extrema;
+    } else {
+        throw std::runtime_error("Unknown sampling policy: " + name);
+    }
+}
+
+sampler::~sampler() = default;
+
+auto sampler::create(const sampling_properties& properties, emit_function emit) -> std::unique_ptr<sampler> {
+    const bool needs_interval = properties.policy == sampling_policy_interval || properties.policy == sampling_policy_extrema;
+    if (needs_interval && properties.interval_s <= 0.0) {
+        throw std::invalid_argument("Sampling interval must be positive.");
+    }
+
+    switch (properties.policy) {
+        case sampling_policy_every_nth:
+            if (properties.every <= 0) {
+                throw std::invalid_argument("Sampling every must be positive.");
+            }
+            return std::make_unique<every_nth_sampler_impl>(std::move(emit), static_cast<std::size_t>(properties.every));
+        case sampling_policy_interval:
+            return std::make_unique<interval_sampler_impl>(std::move(emit), properties.interval_s);
+        case sampling_policy_change:
+            return std::make_unique<change_sampler_impl>(std::move(emit), properties);
+        case sampling_policy_extrema:
+            return std::make_unique<extrema_sampler_impl>(std::move(emit), properties.interval_s);
+        case sampling_policy_all:
+        default:
+            return std::make_unique<every_nth_sampler_impl>(std::move(emit), 1);
+    }
+}
+
+}  // namespace aos
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "aos/core/state.hpp"
+#include "aos/core/types.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace aos {
+
+enum sampling_policy : uint8_t {
+    sampling_policy_all,        // every observed state
+    sampling_policy_every_nth,  // one of every `every` observed states
+    sampling_policy_interval,   // states interpolated to a fixed time grid
+    sampling_policy_change,     // a state once w or the attitude moved by more than a bound since the last row
+    sampling_policy_extrema,    // first, last, min |w| and max |w| state of every time bucket
+};
+
+struct sampling_properties {
+    static constexpr int  default_every    = 10;
+    static constexpr real default_interval = 60.0;  // [s]
+
+    sampling_policy policy{sampling_policy_all};   // "all", "every_nth", "interval", "change" or "extrema"
+    int             every{default_every};          // every_nth: one row per `every` observed states
+    real            interval_s{default_interval};  // [s] interval: row spacing, extrema: bucket width, change: longest gap (0: none)
+    real            angular_velocity_rad_s{};      // [rad/s] change: bound on |w - w_last|, 0 disables
+    real            attitude_deg{};                // [deg] change: bound on the rotation since the last row, 0 disables
+
+    void from_toml(const toml_table& table);
+};
+
+/**
+ * @brief Decides which observed states become output rows (`[observer.sampling]` table).
+ *
+ * The simulation hands the observer every accepted step (or every checkpoint); a sampler in between keeps the output
+ * volume proportional to what happens instead of to the step count. Kept states go to the emit function, which builds
+ * and writes the row, so derived columns of dropped states are never computed. Every policy emits the first observed
+ * state, and flush() emits the last one, so a run is always bracketed.
+ */
+class sampler {
+public:
+
+    using emit_function = std::function<void(const system_state& state, real time)>;
+
+    sampler()                                  = default;
+    sampler(const sampler&)                    = delete;
+    sampler(sampler&&)                         = delete;
+    auto operator=(const sampler&) -> sampler& = delete;
+    auto operator=(sampler&&) -> sampler&      = delete;
+
+    virtual ~sampler();
+
+    // next observed state, in time order
+    virtual void sample(const system_state& state, real time) = 0;
+
+    // emit what is held back, e.g. the latest observed state or an open bucket
+    virtual void flush() = 0;
+
+    // throws std::invalid_argument for non-positive every/interval where the policy needs them
+    static auto create(const sampling_properties& properties, emit_function emit) -> std::unique_ptr<sampler>;
+};
+
+}  // namespace aos
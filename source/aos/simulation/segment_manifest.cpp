@@ -0,0 +1,86 @@
+#include "segment_manifest.hpp"
+
+#include "aos/core/types.hpp"
+
+#include <charconv>
+#include <cstddef>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <ios>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace aos {
+
+namespace {
+
+// the whole field as a number
+template <typename value_type>
+auto parse_field(std::string_view field, value_type& value) -> bool {
+    const auto result = std::from_chars(field.data(), field.data() + field.size(), value);
+    return result.ec == std::errc{} && result.ptr == field.data() + field.size();
+}
+
+}  // namespace
+
+auto segment_manifest_filename(const std::string& output_filename) -> std::string {
+    return output_filename + ".segments";
+}
+
+auto segment_filename(const std::string& output_filename, std::size_t segment) -> std::string {
+    std::filesystem::path path(output_filename);
+    path.replace_filename(std::format("{}_{:04}{}", path.stem().string(), segment, path.extension().string()));
+    return path.string();
+}
+
+auto is_segment_manifest(const std::string& filename) -> bool {
+    std::ifstream file(filename, std::ios::binary);
+    std::string   line;
+    return std::getline(file, line) && line == segment_manifest_header;
+}
+
+auto read_segment_manifest(const std::string& manifest_filename) -> std::vector<segment_entry> {
+    std::ifstream file(manifest_filename);
+    if (not file.is_open()) {
+        throw std::runtime_error("Could not open segment manifest: " + manifest_filename);
+    }
+
+    std::string line;
+    if (not std::getline(file, line) || line != segment_manifest_header) {
+        throw std::runtime_error("Not a segment manifest: " + manifest_filename);
+    }
+
+    const auto directory = std::filesystem::path(manifest_filename).parent_path();
+
+    std::vector<segment_entry> entries;
+    while (std::getline(file, line)) {
+        if (line.empty()) {
+            continue;
+        }
+
+        std::vector<std::string_view> fields;
+        for (std::size_t begin = 0, comma = 0; comma != std::string::npos; begin = comma + 1) {
+            comma = line.find(',', begin);
+            fields.emplace_back(std::string_view(line).substr(begin, comma == std::string::npos ? std::string::npos : comma - begin));
+        }
+
+        constexpr std::size_t num_fields = 6;
+
+        segment_entry entry{};
+        const bool    valid = fields.size() == num_fields && parse_field(fields[0], entry.segment) && parse_field(fields[2], entry.t_first) &&
+                           parse_field(fields[3], entry.t_last) && parse_field(fields[4], entry.rows) && parse_field(fields[5], entry.bytes);
+        if (not valid) {
+            throw std::runtime_error("Malformed segment manifest line: " + line);
+        }
+        entry.filename = (directory / fields[1]).string();
+        entries.push_back(std::move(entry));
+    }
+    return entries;
+}
+
+}  // namespace aos
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "aos/core/types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aos {
+
+/*
+ * Segmented output ([observer.segments]): instead of <stem><ext>, rows go to <stem>_0000<ext>, <stem>_0001<ext>, ...,
+ * each a complete file of the output format with the full header (and its own CSV index). A segment is closed before a
+ * row once it holds the configured number of rows or bytes, or once the row starts a new block of simulated days.
+ * Every closed segment is appended to the manifest <stem><ext>.segments as soon as it is closed:
+ *
+ *   segment,file,t_first,t_last,rows,bytes
+ *   one line per segment: its number, file name (relative to the manifest), first and last time (shortest round-trip
+ *   text, nan if it holds no rows), number of rows and size
+ *
+ * A segment listed in the manifest is final and can be compressed or analysed while the run goes on; the segment being
+ * written is listed once the run ends.
+ */
+
+inline constexpr std::string_view segment_manifest_header = "segment,file,t_first,t_last,rows,bytes";
+
+struct segment_entry {
+    std::size_t   segment;
+    std::string   filename;  // as found next to the manifest
+    real          t_first;   // [s]
+    real          t_last;    // [s]
+    std::uint64_t rows;
+    std::uint64_t bytes;
+};
+
+[[nodiscard]] auto segment_manifest_filename(const std::string& output_filename) -> std::string;
+
+// <stem>_<segment, 4 digits or more><extension> next to the output
+[[nodiscard]] auto segment_filename(const std::string& output_filename, std::size_t segment) -> std::string;
+
+// the segments listed in a manifest; throws std::runtime_error if it cannot be read or is malformed
+[[nodiscard]] auto read_segment_manifest(const std::string& manifest_filename) -> std::vector<segment_entry>;
+
+// whether the file starts like a manifest
+[[nodiscard]] auto is_segment_manifest(const std::string& filename) -> bool;
+
+}  // namespace aos
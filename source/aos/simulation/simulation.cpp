@@ -4,11 +4,17 @@
 #include "aos/core/constants.hpp"
 #include "aos/core/state.hpp"
 #include "aos/core/types.hpp"
+#include "aos/environment/details/environment_impl.hpp"
 #include "aos/environment/environment.hpp"
 #include "aos/environment/orbital_mechanics.hpp"
 #include "aos/simulation/config.hpp"
+#include "aos/simulation/details/dynamics_impl.hpp"
 #include "aos/simulation/dynamics.hpp"
 #include "aos/simulation/observer.hpp"
+#include "aos/simulation/orbit_summary_observer.hpp"
+#include "aos/simulation/statistics_observer.hpp"
+#include "aos/simulation/stop_criteria.hpp"
+#include "aos/simulation/telemetry_observer.hpp"
 
 #include <boost/numeric/odeint.hpp>
 #include <boost/numeric/odeint/algebra/vector_space_algebra.hpp>
@@ -28,6 +34,30 @@
 
 namespace aos {
 
+namespace {
+
+auto create_observer(const std::string&                  output_filename,
+                     const simulation_properties&        properties,
+                     const std::shared_ptr<spacecraft>&  satellite,
+                     const std::shared_ptr<environment>& environment,
+                     const std::shared_ptr<dynamics>&    dynamics) -> std::shared_ptr<observer> {
+    const auto num_rods = properties.satellite.rods.size();
+
+    auto output = properties.observer.format == observer_format_statistics
+                      ? statistics_observer::create(output_filename, satellite, environment, properties.satellite, properties.observer, dynamics)
+                      : observer::create(output_filename, num_rods, properties.observer);
+
+    if (properties.observer.orbit_summary && not output_filename.empty()) {
+        output = orbit_summary_observer::create(std::move(output), output_filename, satellite, environment, num_rods, properties.observer, dynamics);
+    }
+    if (not properties.observer.telemetry.name.empty()) {
+        output = telemetry_observer::create(std::move(output), num_rods, properties.observer.telemetry);
+    }
+    return output;
+}
+
+}  // namespace
+
 simulation::simulation(const std::string& output_filename, const simulation_properties& properties)
     : simulation(output_filename, properties, spacecraft::create(properties.satellite), environment::create(properties.environment)) {}
 
@@ -35,11 +65,9 @@ simulation::simulation(const std::string&                  output_filename,
                        const simulation_properties&        properties,
                        const std::shared_ptr<spacecraft>&  satellite,
                        const std::shared_ptr<environment>& environment)
-    : simulation(properties,
-                 satellite,
-                 environment,
-                 dynamics::create(satellite, environment),
-                 observer::create(output_filename, properties.satellite.rods.size(), properties.observer)) {}
+    : simulation(properties, satellite, environment, dynamics::create(satellite, environment, properties.models), nullptr) {
+    _observer = create_observer(output_filename, properties, satellite, environment, _dynamics);
+}
 
 simulation::simulation(const simulation_properties& properties,
                        std::shared_ptr<spacecraft>  satellite,
@@ -65,9 +93,45 @@ simulation::simulation(const simulation_properties& properties,
     _current_state.angular_velocity_m_s = properties.angular_velocity;
     _current_state.rod_magnetizations.resize(static_cast<std::ptrdiff_t>(properties.satellite.rods.size()));
     _current_state.rod_magnetizations.setZero();
+
+    if (properties.stop.enabled()) {
+        _stop.emplace(properties.stop, properties.satellite);
+        if (_stop->needs_magnetic_field()) {
+            _dynamics->enable_diagnostics();  // the field at an observed state comes from the step that produced it
+        }
+    }
 }
 
 void simulation::run() {
+    // the pre-instantiated configurations are final classes, so the system lambda calls (and can inline) the whole
+    // right-hand side directly; any other dynamics goes through the virtual interface
+    if (auto* model = dynamic_cast<dynamics_impl<environment_impl>*>(_dynamics.get())) {
+        integrate(*model);
+    } else if (auto* model = dynamic_cast<dynamics_impl<environment>*>(_dynamics.get())) {
+        integrate(*model);
+    } else {
+        integrate(*_dynamics);
+    }
+}
+
+auto simulation::current_state() const -> const system_state& {
+    return _current_state;
+}
+
+auto simulation::current_time() const -> real {
+    return _t_now;
+}
+
+auto simulation::converged() const -> bool {
+    return _converged;
+}
+
+void simulation::set_verbose(bool verbose) {
+    _verbose = verbose;
+}
+
+template <typename dynamics_type>
+void simulation::integrate(dynamics_type& model) {
     using aos::abs;
     using boost::numeric::odeint::make_controlled;
     using boost::numeric::odeint::runge_kutta_cash_karp54;
@@ -78,14 +142,25 @@ void simulation::run() {
     using stepper_type_dp5 = runge_kutta_dopri5<system_state, real, system_state, real, vector_space_algebra>;
     using stepper_type_k54 = runge_kutta_cash_karp54<system_state, real, system_state, real, vector_space_algebra>;
 
-    _observer->write_header() << '\n';
+    _observer->write_header();
+
+    auto system = [&model](const system_state& current_state, system_state& state_derivative, real t_sec) {
+        model.step(current_state, state_derivative, t_sec);
+    };
 
-    auto system = [this](const system_state& current_state, system_state& state_derivative, real t_sec) {
-        _dynamics->step(current_state, state_derivative, t_sec);
+    // history-dependent rods advance only on accepted steps
+    auto accept = [&model](system_state& state, real t_sec) {
+        model.accept_step(state, t_sec);
     };
 
-    auto observe = [this](const system_state& state, real time) {
-        _observer->write(state, time) << '\n';
+    auto observe = [&](system_state& state, real time) {
+        _t_now = time;
+        model.accept_step(state, time);
+        _observer->write(state, time);
+
+        if (check_convergence(state, time)) {
+            throw std::runtime_error("Converged");
+        }
 
         if (state.altitude_m() <= reentry_altitude_m) {
             throw std::runtime_error("Deorbited");
@@ -100,39 +175,50 @@ void simulation::run() {
         using boost::numeric::odeint::integrate_adaptive;
 
         if (_checkpoint_interval < 1.0) {
-            std::println("Starting simulation");
-            _dynamics->set_time_offset(0.0);
+            log("Starting simulation\n");
+            model.set_time_offset(0.0);
 
             try {
                 integrate_adaptive(stepper, system, _current_state, _t_start, _t_end, _dt_initial, observe);
             } catch (const std::runtime_error& e) {
-                std::println("\n[Terminated] Simulation stopped early: {}", e.what());
+                if (_converged) {
+                    log("\n[Converged] Stop criteria met at t = {:.1f} s\n", _t_now);
+                } else {
+                    log("\n[Terminated] Simulation stopped early: {}\n", e.what());
+                }
             }
         } else {
-            std::println("Starting simulation with checkpoints");
+            log("Starting simulation with checkpoints\n");
 
-            _observer->write(_current_state, _t_start) << '\n';
+            model.set_time_offset(_t_now);
+            model.accept_step(_current_state, 0.0);
+            _observer->write(_current_state, _t_start);
             while (_t_now < _t_end) {
                 const auto section_period = std::min(_checkpoint_interval, _t_end - _t_now);
 
-                _dynamics->set_time_offset(_t_now);
-                integrate_adaptive(stepper, system, _current_state, 0.0, section_period, _dt_initial);
+                model.set_time_offset(_t_now);
+                integrate_adaptive(stepper, system, _current_state, 0.0, section_period, _dt_initial, accept);
 
                 fix_integration_errors();
 
                 _t_now += section_period;
-                _observer->write(_current_state, _t_now) << '\n';
+                _observer->write(_current_state, _t_now);
                 // observer.flush();  // comment when not needed
-                std::print("Checkpoint: {} s / {} s\r", _t_now, _t_end);
+                log("Checkpoint: {} s / {} s\r", _t_now, _t_end);
+
+                if (check_convergence(_current_state, _t_now)) {
+                    log("\n[Converged] Stop criteria met at t = {:.1f} s\n", _t_now);
+                    break;
+                }
 
                 if (const auto altitude_m = _current_state.altitude_m(); altitude_m <= reentry_altitude_m) {
                     const auto altitude_km = altitude_m * meter_to_kilometer;
-                    std::println("\n[Terminated] Satellite deorbited at t = {:.1f} s. Altitude: {:.2f} km", _t_now + section_period, altitude_km);
+                    log("\n[Terminated] Satellite deorbited at t = {:.1f} s. Altitude: {:.2f} km\n", _t_now + section_period, altitude_km);
                     break;
                 }
 
                 if (_current_state.has_nan()) {
-                    std::println("\n[Terminated] Numerical instability (NaN detected) at t = {:.1f} s.", _t_now + section_period);
+                    log("\n[Terminated] Numerical instability (NaN detected) at t = {:.1f} s.\n", _t_now + section_period);
                     break;
                 }
             }
@@ -158,23 +244,29 @@ void simulation::run() {
         }
     }
 
-    std::print("\n");
+    _observer->flush();  // the output is complete once run() returns
+    log("\n");
+}
+
+auto simulation::check_convergence(const system_state& state, real t_sec) -> bool {
+    if (not _stop) {
+        return false;
+    }
+
+    vec3 magnetic_field_eci_T = vec3::Zero();  // NOLINT(readability-identifier-naming)
+    if (_stop->needs_magnetic_field()) {
+        magnetic_field_eci_T = observed_environment(*_environment, _dynamics.get(), state, t_sec).magnetic_field_eci_T;
+    }
+
+    _converged = _stop->update(state, magnetic_field_eci_T, t_sec);
+    return _converged;
 }
 
 void simulation::fix_integration_errors() {
     _current_state.attitude.normalize();  // fix drift
 
     // in case of integrator overshot
-    const auto rods = _satellite->hystresis().rods();
-    for (std::ptrdiff_t i = 0; i < _current_state.rod_magnetizations.size(); ++i) {
-        const auto& hysteresis = rods[i].hysteresis();
-
-        _current_state.rod_magnetizations(i) = std::clamp(  //
-            _current_state.rod_magnetizations(i),           //
-            -hysteresis.ms,                                 //
-            hysteresis.ms                                   //
-        );
-    }
+    _satellite->hystresis().clamp_magnetizations(_current_state.rod_magnetizations);
 }
 
 }  // namespace aos
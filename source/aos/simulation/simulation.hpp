@@ -7,9 +7,14 @@
 #include "aos/simulation/config.hpp"
 #include "aos/simulation/dynamics.hpp"
 #include "aos/simulation/observer.hpp"
+#include "aos/simulation/stop_criteria.hpp"
 
+#include <format>
 #include <memory>
+#include <optional>
+#include <print>
 #include <string>
+#include <utility>
 
 namespace aos {
 
@@ -29,16 +34,39 @@ public:
 
     void run();
 
+    // state at the end of run()
+    [[nodiscard]] auto current_state() const -> const system_state&;
+
+    // time reached by run(), t_end unless the run was terminated early
+    [[nodiscard]] auto current_time() const -> real;
+
+    // the run stopped early because the [stop] criteria were met
+    [[nodiscard]] auto converged() const -> bool;
+
+    // progress and termination messages on stdout, on by default
+    void set_verbose(bool verbose);
+
 protected:
 
+    // integration loop over the static type of the dynamics model, see run()
+    template <typename dynamics_type>
+    void integrate(dynamics_type& model);
+
     void fix_integration_errors();
 
+    // feeds an observed state to the stop criteria, true once they are met
+    auto check_convergence(const system_state& state, real t_sec) -> bool;
+
+    template <typename... arg_types>
+    void log(std::format_string<arg_types...> format, arg_types&&... args) const;
+
 private:
 
     std::shared_ptr<spacecraft>  _satellite;
     std::shared_ptr<environment> _environment;
     std::shared_ptr<dynamics>    _dynamics;
     std::shared_ptr<observer>    _observer;
+    std::optional<stop_criteria> _stop;
     system_state                 _current_state;
     real                         _t_start;
     real                         _t_end;
@@ -48,6 +76,15 @@ private:
     real                         _absolute_error;
     real                         _relative_error;
     int                          _stepper_function;
+    bool                         _converged{};
+    bool                         _verbose{true};
 };
 
+template <typename... arg_types>
+void simulation::log(std::format_string<arg_types...> format, arg_types&&... args) const {
+    if (_verbose) {
+        std::print(format, std::forward<arg_types>(args)...);
+    }
+}
+
 }  // namespace aos
@@ -0,0 +1,99 @@
+#include "statistics_observer.hpp"
+
+#include "aos/components/spacecraft.hpp"
+#include "aos/core/types.hpp"
+#include "aos/environment/environment.hpp"
+#include "aos/simulation/details/statistics_observer_impl.hpp"
+#include "aos/simulation/dynamics.hpp"
+#include "aos/simulation/observer.hpp"
+
+#include <array>
+#include <cmath>
+#include <format>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace aos {
+
+void running_statistics::add(real value, real weight_s) {
+    min = std::isnan(min) || value < min ? value : min;
+    max = std::isnan(max) || value > max ? value : max;
+
+    if (weight_s <= 0.0) {
+        if (weight <= 0.0) {
+            mean = value;  // nothing observed for a duration yet
+        }
+        return;
+    }
+
+    weight += weight_s;
+    const real delta = value - mean;
+    mean += (weight_s / weight) * delta;
+    m2 += weight_s * delta * (value - mean);
+}
+
+auto running_statistics::variance() const -> real {
+    return weight > 0.0 ? m2 / weight : 0.0;
+}
+
+auto running_statistics::standard_deviation() const -> real {
+    return std::sqrt(variance());
+}
+
+void threshold_crossing::update(real value, real threshold, real t_sec) {
+    if (value > threshold) {
+        below_since = statistics_unset;
+        return;
+    }
+
+    if (std::isnan(first_below)) {
+        first_below = t_sec;
+    }
+    if (std::isnan(below_since)) {
+        below_since = t_sec;
+    }
+}
+
+auto run_statistics::fields() const -> std::array<std::pair<std::string_view, real>, num_fields> {
+    return {{
+        {"w_final", final_angular_velocity_rad_s},
+        {"w_mean", angular_velocity.mean},
+        {"w_std", angular_velocity.standard_deviation()},
+        {"w_min", angular_velocity.min},
+        {"w_max", angular_velocity.max},
+        {"pointing_final", final_pointing_deg},
+        {"pointing_mean", pointing.mean},
+        {"pointing_std", pointing.standard_deviation()},
+        {"pointing_min", pointing.min},
+        {"pointing_max", pointing.max},
+        {"orbits", static_cast<real>(orbits)},
+        {"orbit_w_mean", orbit_angular_velocity_rad_s},
+        {"orbit_pointing_mean", orbit_pointing_deg},
+        {"orbit_rod_energy", orbit_rod_energy_J},
+        {"t_w_below", angular_velocity_below.first_below - t_start},
+        {"t_w_stable", angular_velocity_below.below_since - t_start},
+        {"t_pointing_below", pointing_below.first_below - t_start},
+        {"t_pointing_stable", pointing_below.below_since - t_start},
+    }};
+}
+
+auto run_statistics::summary_line() const -> std::string {
+    std::string line = std::format("t_end={}", t_end);
+    for (const auto& [name, value] : fields()) {
+        line += std::format(" {}={:.6g}", name, value);
+    }
+    return line;
+}
+
+auto statistics_observer::create(const std::string&                 filename,
+                                 std::shared_ptr<const spacecraft>  satellite,
+                                 std::shared_ptr<const environment> environment,
+                                 const spacecraft_properties&       satellite_properties,
+                                 const observer_properties&         properties,
+                                 std::shared_ptr<dynamics>          dyn) -> std::shared_ptr<statistics_observer> {
+    return std::make_shared<statistics_observer_impl>(filename, std::move(satellite), std::move(environment), satellite_properties, properties, std::move(dyn));
+}
+
+}  // namespace aos
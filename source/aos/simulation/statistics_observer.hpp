@@ -0,0 +1,91 @@
+#pragma once
+
+#include "aos/components/spacecraft.hpp"
+#include "aos/core/types.hpp"
+#include "aos/environment/environment.hpp"
+#include "aos/simulation/dynamics.hpp"
+#include "aos/simulation/observer.hpp"
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace aos {
+
+inline constexpr real statistics_unset = std::numeric_limits<real>::quiet_NaN();  // no sample (yet), or never crossed
+
+// time-weighted mean and variance (West's update), minimum and maximum of one quantity
+struct running_statistics {
+    real weight{};  // [s] observed time
+    real mean{};
+    real m2{};      // weighted sum of squared deviations
+    real min{statistics_unset};
+    real max{statistics_unset};
+
+    // a sample standing for `weight` seconds of the run; the first sample of a run has weight 0
+    void add(real value, real weight_s);
+
+    [[nodiscard]] auto variance() const -> real;
+    [[nodiscard]] auto standard_deviation() const -> real;
+};
+
+// times at which a quantity falls to or below a threshold
+struct threshold_crossing {
+    real first_below{statistics_unset};  // [s] first sample at or below
+    real below_since{statistics_unset};  // [s] start of the current stretch at or below, unset while above
+
+    void update(real value, real threshold, real t_sec);
+};
+
+struct run_statistics {
+    real               t_start{};
+    real               t_end{};
+    real               final_angular_velocity_rad_s{};
+    real               final_pointing_deg{};
+    running_statistics angular_velocity;                                // [rad/s] |w|
+    running_statistics pointing;                                        // [deg] angle between the magnet moment and the local field
+    int                orbits{};                                        // complete orbits
+    real               orbit_angular_velocity_rad_s{statistics_unset};  // [rad/s] mean |w| over the last complete orbit
+    real               orbit_pointing_deg{statistics_unset};            // [deg] mean pointing error over the last complete orbit
+    real               orbit_rod_energy_J{statistics_unset};            // [J] rod hysteresis energy of the last complete orbit
+    threshold_crossing angular_velocity_below;                          // [observer.statistics] angular_velocity
+    threshold_crossing pointing_below;                                  // [observer.statistics] pointing
+
+    static constexpr std::size_t num_fields = 18;
+
+    // name and value of every reduced quantity; crossing times are relative to t_start, the time to stabilize is the
+    // start of the final stretch below the threshold (NaN if the run ended above it)
+    [[nodiscard]] auto fields() const -> std::array<std::pair<std::string_view, real>, num_fields>;
+
+    // t_end and the fields as key=value pairs on one line
+    [[nodiscard]] auto summary_line() const -> std::string;
+};
+
+/**
+ * @brief Reduces a run to streaming statistics instead of writing its trajectory (`format = "statistics"`).
+ *
+ * Every observed state updates O(1) accumulators: time-weighted mean, variance and extrema of |w| and of the pointing
+ * error, per-orbit means and rod hysteresis energy (orbits from the vis-viva period, see rod_energy_meter) and the
+ * threshold crossing times. The pointing error needs the magnetic field, so each observed state costs one environment
+ * evaluation; checkpoints or a coarse output keep that small. flush() writes summary_line() to the output file, an
+ * empty filename keeps the summary in memory only (batch runs).
+ */
+class statistics_observer : public observer {
+public:
+
+    [[nodiscard]] virtual auto statistics() const -> const run_statistics& = 0;
+
+    // dyn may be null, otherwise the environment of an observed state is taken from its last evaluation, see observed_environment
+    static auto create(const std::string&                 filename,
+                       std::shared_ptr<const spacecraft>  satellite,
+                       std::shared_ptr<const environment> environment,
+                       const spacecraft_properties&       satellite_properties,
+                       const observer_properties&         properties,
+                       std::shared_ptr<dynamics>          dyn = nullptr) -> std::shared_ptr<statistics_observer>;
+};
+
+}  // namespace aos
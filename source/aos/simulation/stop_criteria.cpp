@@ -0,0 +1,114 @@
+#include "stop_criteria.hpp"
+
+#include "aos/components/permanent_magnet.hpp"
+#include "aos/components/spacecraft.hpp"
+#include "aos/core/constants.hpp"
+#include "aos/core/state.hpp"
+#include "aos/core/types.hpp"
+
+#include <toml++/toml.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+namespace aos {
+
+auto stop_criteria_properties::enabled() const -> bool {
+    return angular_velocity_rad_s > 0.0 || pointing_deg > 0.0 || rod_energy_tolerance > 0.0;
+}
+
+void stop_criteria_properties::from_toml(const toml_table& table) {
+    angular_velocity_rad_s = table["angular_velocity"].value_or(0.0);
+    pointing_deg           = table["pointing"].value_or(0.0);
+    rod_energy_tolerance   = table["rod_energy"].value_or(0.0);
+    orbits                 = table["orbits"].value_or(1.0);
+}
+
+void stop_criteria_properties::debug_print() const {
+    std::cout << "--  stop criteria  --"                             //
+              << "\n  angular velocity: " << angular_velocity_rad_s  //
+              << "\n  pointing:         " << pointing_deg            //
+              << "\n  rod energy:       " << rod_energy_tolerance    //
+              << "\n  orbits:           " << orbits                  //
+              << '\n';
+}
+
+stop_criteria::stop_criteria(const stop_criteria_properties& properties, const spacecraft_properties& satellite)
+    : _properties(properties), _magnet_moment_body(permanent_magnet(satellite.magnet).magnetic_moment()), _rod_energy(satellite) {
+    if (_properties.rod_energy_tolerance > 0.0 && not _rod_energy.has_rods()) {
+        throw std::invalid_argument("Stop criterion rod_energy needs at least one hysteresis rod.");
+    }
+}
+
+auto stop_criteria::needs_magnetic_field() const -> bool {
+    return _properties.pointing_deg > 0.0 || _properties.rod_energy_tolerance > 0.0;
+}
+
+auto stop_criteria::update(const system_state& state, const vec3& magnetic_field_eci_T, real t_sec) -> bool {
+    if (_converged || not _properties.enabled()) {
+        return _converged;
+    }
+
+    const real period_s = orbital_period_s(state);
+    const real window_s = _properties.orbits * period_s;
+
+    bool holding = true;
+    if (_properties.angular_velocity_rad_s > 0.0) {
+        holding = holding && state.angular_velocity_m_s.norm() <= _properties.angular_velocity_rad_s;
+    }
+    if (_properties.pointing_deg > 0.0) {
+        holding = holding && pointing_error_deg(state.attitude, _magnet_moment_body, magnetic_field_eci_T) <= _properties.pointing_deg;
+    }
+
+    if (not holding) {
+        _holding = false;
+    } else if (not _holding) {
+        _holding       = true;
+        _holding_since = t_sec;
+    }
+
+    bool plateau = true;
+    if (_properties.rod_energy_tolerance > 0.0) {
+        update_rod_energy(state, state.attitude.normalized().inverse() * magnetic_field_eci_T, t_sec, period_s);
+        plateau = static_cast<real>(_plateau_orbits) >= _properties.orbits;
+    }
+
+    _converged = _holding && t_sec - _holding_since >= window_s && plateau;
+    return _converged;
+}
+
+auto stop_criteria::converged() const -> bool {
+    return _converged;
+}
+
+auto stop_criteria::pointing_error_deg(const quat& attitude, const vec3& moment_body, const vec3& field_eci) -> real {
+    const vec3 m_eci  = attitude.normalized() * moment_body;
+    const real cosine = m_eci.normalized().dot(field_eci.normalized());
+    return std::acos(std::clamp(cosine, -1.0, 1.0)) * rad_to_deg;
+}
+
+auto stop_criteria::orbital_period_s(const system_state& state) -> real {
+    // vis-viva: 1/a = 2/r - v^2/mu
+    const real inverse_a = (2.0 / state.position_m.norm()) - (state.velocity_m_s.squaredNorm() / earth_mu_m3_s2);
+    if (inverse_a <= 0.0) {
+        return std::numeric_limits<real>::infinity();  // escape trajectory
+    }
+
+    const real semi_major_axis = 1.0 / inverse_a;
+    return 2.0 * pi * std::sqrt(semi_major_axis * semi_major_axis * semi_major_axis / earth_mu_m3_s2);
+}
+
+void stop_criteria::update_rod_energy(const system_state& state, const vec3& field_body, real t_sec, real period_s) {
+    const real previous_energy = _rod_energy.last_orbit_energy();
+    if (not _rod_energy.update(state, field_body, t_sec, period_s) || _rod_energy.complete_orbits() < 2) {
+        return;
+    }
+
+    const real change = std::abs(_rod_energy.last_orbit_energy() - previous_energy);
+    _plateau_orbits   = change <= _properties.rod_energy_tolerance * std::abs(previous_energy) ? _plateau_orbits + 1 : 0;
+}
+
+}  // namespace aos
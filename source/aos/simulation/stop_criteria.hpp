@@ -0,0 +1,67 @@
+#pragma once
+
+#include "aos/components/spacecraft.hpp"
+#include "aos/core/state.hpp"
+#include "aos/core/types.hpp"
+#include "aos/simulation/rod_energy_meter.hpp"
+
+namespace aos {
+
+struct stop_criteria_properties {
+    real angular_velocity_rad_s{};  // [rad/s] |w| must stay below, 0 disables
+    real pointing_deg{};            // [deg] angle between magnet moment and local field must stay below, 0 disables
+    real rod_energy_tolerance{};    // [-] relative change of the rod loop energy from one orbit to the next, 0 disables
+    real orbits{1.0};               // [-] number of orbits every enabled criterion has to hold
+
+    [[nodiscard]] auto enabled() const -> bool;
+
+    void from_toml(const toml_table& table);
+    void debug_print() const;
+
+    auto operator==(const stop_criteria_properties&) const -> bool = default;
+};
+
+/**
+ * @brief Convergence test over the observed states of one run (`[stop]` table).
+ *
+ * The run has converged once every enabled criterion has held for `orbits` orbital periods. The angular velocity and
+ * pointing bounds must hold continuously; a violation restarts the count. The rod criterion compares the hysteresis
+ * energy exchanged per orbit, W = sum over the rods of V * integral(B dM) along the rod axis, and holds once the
+ * relative change between consecutive orbits stayed below the tolerance for `orbits` orbits. The orbital period follows from
+ * the current state (vis-viva), so the test works for any orbit without configuration.
+ */
+class stop_criteria {
+public:
+
+    // throws std::invalid_argument for a rod_energy criterion on a spacecraft without rods, it could never hold
+    stop_criteria(const stop_criteria_properties& properties, const spacecraft_properties& satellite);
+
+    // pointing and rod energy need the magnetic field at the observed state
+    [[nodiscard]] auto needs_magnetic_field() const -> bool;
+
+    // feed the next observed state (in time order), returns converged()
+    auto update(const system_state& state, const vec3& magnetic_field_eci_T, real t_sec) -> bool;
+
+    [[nodiscard]] auto converged() const -> bool;
+
+    // [deg] angle between the body-frame magnet moment, rotated to ECI, and the field
+    [[nodiscard]] static auto pointing_error_deg(const quat& attitude, const vec3& moment_body, const vec3& field_eci) -> real;
+
+    [[nodiscard]] static auto orbital_period_s(const system_state& state) -> real;
+
+protected:
+
+    void update_rod_energy(const system_state& state, const vec3& field_body, real t_sec, real period_s);
+
+private:
+
+    stop_criteria_properties _properties;
+    vec3                     _magnet_moment_body;
+    rod_energy_meter         _rod_energy;
+    real                     _holding_since{};   // [s] start of the current run of held bounds
+    int                      _plateau_orbits{};  // consecutive orbits with the rod energy within the tolerance
+    bool                     _holding{};
+    bool                     _converged{};
+};
+
+}  // namespace aos
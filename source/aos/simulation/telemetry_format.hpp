@@ -0,0 +1,45 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace aos {
+
+/*
+ * Live telemetry ring in POSIX shared memory ([observer.telemetry], see telemetry_observer.hpp), native endian:
+ *
+ *   telemetry_header
+ *   names_size bytes at names_offset: the column names, comma separated
+ *   capacity slots from data_offset (a multiple of telemetry_alignment), num_columns float64 values each
+ *
+ * Sample n (counting from 0) lives in slot n % capacity, the newest one is count - 1. The header is a seqlock: the
+ * producer makes sequence odd, writes the slot and count, then makes sequence even again. A reader loads sequence
+ * (retrying while it is odd), copies count and the slots it wants, and keeps the copy only if sequence did not change in
+ * between. The producer never waits for or even knows about readers, attaching and detaching is free. magic is set last,
+ * once the segment is fully initialized.
+ */
+
+inline constexpr std::array<char, 8> telemetry_magic     = {'P', 'M', 'A', 'O', 'S', 'T', 'L', 'M'};
+inline constexpr std::uint32_t       telemetry_version   = 1;
+inline constexpr std::size_t         telemetry_alignment = 64;  // [bytes] cache line
+
+struct telemetry_header {
+    std::array<char, 8> magic;
+    std::uint32_t       version;
+    std::uint32_t       num_columns;
+    std::uint64_t       capacity;      // slots in the ring
+    std::uint64_t       names_offset;  // [bytes]
+    std::uint64_t       names_size;    // [bytes]
+    std::uint64_t       data_offset;   // [bytes] first slot
+
+    alignas(telemetry_alignment) std::atomic<std::uint64_t> sequence;  // odd while a sample is written
+    std::atomic<std::uint64_t> count;                                  // samples published so far
+    std::atomic<std::uint64_t> finished;                               // 1 once the run is over
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+static_assert(offsetof(telemetry_header, sequence) == telemetry_alignment && sizeof(telemetry_header) == 2 * telemetry_alignment);
+
+}  // namespace aos
@@ -0,0 +1,16 @@
+#include "telemetry_observer.hpp"
+
+#include "aos/simulation/details/telemetry_observer_impl.hpp"
+#include "aos/simulation/observer.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace aos {
+
+auto telemetry_observer::create(std::shared_ptr<observer> inner, std::size_t num_rods, const telemetry_properties& properties) -> std::shared_ptr<observer> {
+    return std::make_shared<telemetry_observer_impl>(std::move(inner), num_rods, properties);
+}
+
+}  // namespace aos
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "aos/simulation/observer.hpp"
+
+#include <cstddef>
+#include <memory>
+
+namespace aos {
+
+/**
+ * @brief Publishes the latest observed states into a shared-memory ring while passing them on to another observer.
+ *
+ * Every state written (at most one per `interval` simulated seconds) is copied into the POSIX shared-memory object
+ * `[observer.telemetry] name` as time, position, attitude, angular velocity and rod magnetizations; the ring keeps
+ * the newest `samples` of them (layout and seqlock protocol in telemetry_format.hpp). Publishing is a copy and two
+ * atomic stores, no system call, so a viewer (inspector.py --live) can attach to a running simulation and detach at any
+ * time without slowing it down. The object is removed when the observer is destroyed.
+ */
+class telemetry_observer {
+public:
+
+    // throws std::runtime_error if the shared-memory object cannot be created
+    static auto create(std::shared_ptr<observer> inner, std::size_t num_rods, const telemetry_properties& properties) -> std::shared_ptr<observer>;
+};
+
+}  // namespace aos
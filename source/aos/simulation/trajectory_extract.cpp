@@ -0,0 +1,129 @@
+#include "trajectory_extract.hpp"
+
+#include "aos/core/types.hpp"
+#include "aos/simulation/csv_index.hpp"
+#include "aos/simulation/segment_manifest.hpp"
+#include "aos/simulation/trajectory_format.hpp"
+#include "aos/simulation/trajectory_reader.hpp"
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <fstream>
+#include <ios>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace aos {
+
+namespace {
+
+auto is_binary_trajectory(const std::string& filename) -> bool {
+    std::ifstream       file(filename, std::ios::binary);
+    std::array<char, 8> magic{};
+    file.read(magic.data(), magic.size());
+    return file.gcount() == static_cast<std::streamsize>(magic.size()) && magic == trajectory_magic;
+}
+
+auto extract_csv(const std::string& filename, real t_begin, real t_end, bool header, std::ostream& out) -> std::size_t {
+    std::ifstream file(filename, std::ios::binary);
+    if (not file.is_open()) {
+        throw std::runtime_error("Could not open trajectory file: " + filename);
+    }
+
+    std::string line;
+    if (not std::getline(file, line)) {
+        throw std::runtime_error("Trajectory file has no header: " + filename);
+    }
+    if (header) {
+        out << line << '\n';
+    }
+
+    const auto index = read_csv_index(filename);
+    if (const auto offset = csv_index_seek(index, t_begin); offset > 0) {
+        file.seekg(static_cast<std::streamoff>(offset));
+    }
+
+    std::size_t rows = 0;
+    while (std::getline(file, line)) {
+        real       time{};
+        const auto result = std::from_chars(line.data(), line.data() + line.size(), time);
+        if (result.ec != std::errc{} || time < t_begin) {
+            continue;
+        }
+        if (time > t_end) {
+            break;
+        }
+
+        out << line << '\n';
+        ++rows;
+    }
+    return rows;
+}
+
+auto extract_binary(const std::string& filename, real t_begin, real t_end, bool header, std::ostream& out) -> std::size_t {
+    trajectory_reader reader(filename);
+
+    const auto& names = reader.column_names();
+    if (header) {
+        for (std::size_t i = 0; i < names.size(); ++i) {
+            out << (i == 0 ? "" : ",") << names[i];
+        }
+        out << '\n';
+    }
+
+    std::vector<std::vector<real>> columns;
+    columns.reserve(names.size());
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        columns.push_back(reader.read_column(i, t_begin, t_end));
+    }
+
+    const std::size_t rows = columns.empty() ? 0 : columns.front().size();
+
+    // sign, max_digits10 digits, point, longest exponent ("e-308") and the separator
+    constexpr std::size_t max_value_chars = std::numeric_limits<real>::max_digits10 + 8;
+
+    std::string text(names.size() * max_value_chars + 1, '\0');
+    for (std::size_t row = 0; row < rows; ++row) {
+        char* next = text.data();
+        char* last = text.data() + text.size();
+        for (std::size_t i = 0; i < columns.size(); ++i) {
+            if (i > 0) {
+                *next++ = ',';
+            }
+            next = std::to_chars(next, last, columns[i][row]).ptr;
+        }
+        *next++ = '\n';
+        out.write(text.data(), next - text.data());
+    }
+    return rows;
+}
+
+auto extract_file(const std::string& filename, real t_begin, real t_end, bool header, std::ostream& out) -> std::size_t {
+    return is_binary_trajectory(filename) ? extract_binary(filename, t_begin, t_end, header, out) : extract_csv(filename, t_begin, t_end, header, out);
+}
+
+}  // namespace
+
+auto extract_time_range(const std::string& filename, real t_begin, real t_end, std::ostream& out) -> std::size_t {
+    if (not is_segment_manifest(filename)) {
+        return extract_file(filename, t_begin, t_end, true, out);
+    }
+
+    // segments without rows have nan times and never overlap
+    std::size_t rows   = 0;
+    bool        header = true;
+    for (const auto& segment : read_segment_manifest(filename)) {
+        if (segment.t_last >= t_begin && segment.t_first <= t_end) {
+            rows   += extract_file(segment.filename, t_begin, t_end, header, out);
+            header  = false;
+        }
+    }
+    return rows;
+}
+
+}  // namespace aos
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "aos/core/types.hpp"
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+namespace aos {
+
+/**
+ * @brief Writes the rows with t_begin <= time <= t_end of a trajectory file to out as CSV, header first.
+ *
+ * A CSV file is scanned from the sidecar index entry before t_begin (see csv_index.hpp) up to the first row after
+ * t_end, without an index from its first row; its lines are copied unchanged. Of a binary file (trajectory_format.hpp)
+ * only the chunks in range are read, values are written as shortest round-trip text. Rows are expected in time order.
+ * Given a segment manifest (segment_manifest.hpp), the listed segments overlapping the range are extracted in turn
+ * under the header of the first one.
+ * Returns the number of rows written, throws std::runtime_error if the file cannot be read.
+ */
+auto extract_time_range(const std::string& filename, real t_begin, real t_end, std::ostream& out) -> std::size_t;
+
+}  // namespace aos
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace aos {
+
+/*
+ * Binary columnar trajectory file (observer format = "binary"), native little-endian:
+ *
+ *   trajectory_file_header
+ *   num_columns column records: uint8 value size (8 = float64, 4 = float32), uint8 zero, uint16 name length, name
+ *   zero padding up to data_offset
+ *   chunks, each at a multiple of trajectory_alignment:
+ *       uint64 num_rows
+ *       per column, num_rows values, the column block zero-padded to a multiple of 8 bytes
+ *   num_chunks trajectory_chunk index entries
+ *   trajectory_trailer
+ *
+ * A column of one chunk is a plain array, so a reader can map the file and view any column of any chunk in place
+ * (numpy: a frombuffer/memmap view at the column offset). The first column is always time, stored as float64. The index
+ * at the end gives the time range and offset of every chunk; a file without trailer (writer killed) can still be read
+ * by walking the chunks from data_offset.
+ */
+
+inline constexpr std::array<char, 8> trajectory_magic       = {'P', 'M', 'A', 'O', 'S', 'T', 'R', 'J'};
+inline constexpr std::array<char, 8> trajectory_index_magic = {'P', 'M', 'A', 'O', 'S', 'I', 'D', 'X'};
+inline constexpr std::uint32_t       trajectory_version     = 1;
+inline constexpr std::size_t         trajectory_alignment   = 64;  // [bytes] file header and chunks
+
+struct trajectory_file_header {
+    std::array<char, 8> magic;
+    std::uint32_t       version;
+    std::uint32_t       num_columns;
+    std::uint64_t       data_offset;  // [bytes] first chunk
+};
+
+struct trajectory_chunk {
+    double        t_first;   // [s] time of the first row
+    double        t_last;    // [s] time of the last row
+    std::uint64_t offset;    // [bytes] chunk start (its num_rows field)
+    std::uint64_t num_rows;  //
+};
+
+struct trajectory_trailer {
+    std::uint64_t       index_offset;  // [bytes] first trajectory_chunk entry
+    std::uint64_t       num_chunks;
+    std::array<char, 8> magic;
+};
+
+static_assert(sizeof(trajectory_file_header) == 24 && sizeof(trajectory_chunk) == 32 && sizeof(trajectory_trailer) == 24);
+
+// [bytes] size of a column block of a chunk
+constexpr auto trajectory_block_size(std::uint64_t num_rows, std::uint64_t value_size) -> std::uint64_t {
+    return ((num_rows * value_size) + 7) / 8 * 8;  // NOLINT(readability-magic-numbers)
+}
+
+}  // namespace aos
@@ -0,0 +1,185 @@
+#include "trajectory_reader.hpp"
+
+#include "aos/core/types.hpp"
+#include "aos/simulation/trajectory_format.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <ios>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace aos {
+
+trajectory_reader::trajectory_reader(const std::string& filename) : _file(filename, std::ios::binary) {
+    if (not _file.is_open()) {
+        throw std::runtime_error("Could not open trajectory file: " + filename);
+    }
+    _file_size = std::filesystem::file_size(filename);
+
+    trajectory_file_header header{};
+    if (_file_size < sizeof(header)) {
+        throw std::runtime_error("Not a trajectory file: " + filename);
+    }
+    read_bytes(0, &header, sizeof(header));
+    if (header.magic != trajectory_magic || header.version != trajectory_version) {
+        throw std::runtime_error("Not a trajectory file (or unsupported version): " + filename);
+    }
+    _data_offset = header.data_offset;
+
+    std::uint64_t offset = sizeof(header);
+    for (std::uint32_t i = 0; i < header.num_columns; ++i) {
+        std::array<std::uint8_t, 4> record{};
+        read_bytes(offset, record.data(), record.size());
+        const std::size_t length = record[2] | (static_cast<std::size_t>(record[3]) << 8U);
+
+        std::string name(length, '\0');
+        read_bytes(offset + record.size(), name.data(), length);
+        _names.push_back(std::move(name));
+        _value_sizes.push_back(record[0]);
+        offset += record.size() + length;
+    }
+
+    read_index();
+}
+
+auto trajectory_reader::column_names() const -> const std::vector<std::string>& {
+    return _names;
+}
+
+auto trajectory_reader::column_index(std::string_view name) const -> std::size_t {
+    const auto it = std::ranges::find(_names, name);
+    if (it == _names.end()) {
+        throw std::runtime_error("Unknown trajectory column: " + std::string(name));
+    }
+    return static_cast<std::size_t>(it - _names.begin());
+}
+
+auto trajectory_reader::num_rows() const -> std::uint64_t {
+    std::uint64_t rows = 0;
+    for (const auto& chunk : _chunks) {
+        rows += chunk.num_rows;
+    }
+    return rows;
+}
+
+auto trajectory_reader::chunks() const -> const std::vector<trajectory_chunk>& {
+    return _chunks;
+}
+
+auto trajectory_reader::complete() const -> bool {
+    return _complete;
+}
+
+auto trajectory_reader::read_column(std::size_t column) -> std::vector<real> {
+    std::vector<real> values;
+    values.reserve(num_rows());
+    for (const auto& chunk : _chunks) {
+        read_block(chunk, column, values);
+    }
+    return values;
+}
+
+auto trajectory_reader::read_column(std::size_t column, real t_begin, real t_end) -> std::vector<real> {
+    std::vector<real> values;
+    std::vector<real> block;
+
+    for (const auto& chunk : _chunks) {
+        if (chunk.t_last < t_begin || chunk.t_first > t_end) {
+            continue;
+        }
+
+        _times.clear();
+        block.clear();
+        read_block(chunk, 0, _times);
+        read_block(chunk, column, block);
+        for (std::size_t row = 0; row < block.size(); ++row) {
+            if (_times[row] >= t_begin && _times[row] <= t_end) {
+                values.push_back(block[row]);
+            }
+        }
+    }
+    return values;
+}
+
+void trajectory_reader::read_index() {
+    trajectory_trailer trailer{};
+    if (_file_size >= _data_offset + sizeof(trailer)) {
+        read_bytes(_file_size - sizeof(trailer), &trailer, sizeof(trailer));
+    }
+
+    const bool valid = trailer.magic == trajectory_index_magic && trailer.index_offset >= _data_offset &&
+                       trailer.index_offset + (trailer.num_chunks * sizeof(trajectory_chunk)) + sizeof(trailer) == _file_size;
+    if (not valid) {
+        scan_chunks();
+        return;
+    }
+
+    _chunks.resize(trailer.num_chunks);
+    read_bytes(trailer.index_offset, _chunks.data(), _chunks.size() * sizeof(trajectory_chunk));
+    _complete = true;
+}
+
+void trajectory_reader::scan_chunks() {
+    std::uint64_t offset = _data_offset;
+
+    while (offset + sizeof(std::uint64_t) <= _file_size) {
+        trajectory_chunk chunk{.t_first = 0.0, .t_last = 0.0, .offset = offset, .num_rows = 0};
+        read_bytes(offset, &chunk.num_rows, sizeof(chunk.num_rows));
+
+        std::uint64_t size = sizeof(chunk.num_rows);
+        for (const auto value_size : _value_sizes) {
+            size += trajectory_block_size(chunk.num_rows, value_size);
+        }
+
+        // a chunk cut short by the end of the file (or the start of an index) ends the scan
+        if (chunk.num_rows == 0 || offset + size > _file_size) {
+            break;
+        }
+
+        read_bytes(offset + sizeof(chunk.num_rows), &chunk.t_first, sizeof(chunk.t_first));
+        read_bytes(offset + sizeof(chunk.num_rows) + ((chunk.num_rows - 1) * sizeof(double)), &chunk.t_last, sizeof(chunk.t_last));
+        _chunks.push_back(chunk);
+
+        offset += (size + trajectory_alignment - 1) / trajectory_alignment * trajectory_alignment;
+    }
+}
+
+auto trajectory_reader::column_offset(const trajectory_chunk& chunk, std::size_t column) const -> std::uint64_t {
+    std::uint64_t offset = chunk.offset + sizeof(chunk.num_rows);
+    for (std::size_t i = 0; i < column; ++i) {
+        offset += trajectory_block_size(chunk.num_rows, _value_sizes[i]);
+    }
+    return offset;
+}
+
+void trajectory_reader::read_block(const trajectory_chunk& chunk, std::size_t column, std::vector<real>& values) {
+    const std::uint64_t offset = column_offset(chunk, column);
+    const std::size_t   first  = values.size();
+    values.resize(first + chunk.num_rows);
+
+    if (_value_sizes[column] == sizeof(double)) {
+        read_bytes(offset, values.data() + first, chunk.num_rows * sizeof(double));
+        return;
+    }
+
+    std::vector<float> narrow(chunk.num_rows);
+    read_bytes(offset, narrow.data(), narrow.size() * sizeof(float));
+    std::ranges::copy(narrow, values.begin() + static_cast<std::ptrdiff_t>(first));
+}
+
+void trajectory_reader::read_bytes(std::uint64_t offset, void* data, std::uint64_t size) {
+    _file.seekg(static_cast<std::streamoff>(offset));
+    _file.read(static_cast<char*>(data), static_cast<std::streamsize>(size));
+    if (not _file) {
+        throw std::runtime_error("Trajectory file is truncated");
+    }
+}
+
+}  // namespace aos
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "aos/core/types.hpp"
+#include "aos/simulation/trajectory_format.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aos {
+
+/**
+ * @brief Reads binary columnar trajectory files (see trajectory_format.hpp) column by column.
+ *
+ * Only the blocks of the requested column are read, and with a time range only the chunks the index places in that
+ * range. Values are returned as double whatever the stored width. A file whose writer did not finish (no trailer) is
+ * indexed by walking its chunks.
+ */
+class trajectory_reader {
+public:
+
+    // throws std::runtime_error if the file cannot be opened or is not a trajectory file
+    explicit trajectory_reader(const std::string& filename);
+
+    [[nodiscard]] auto column_names() const -> const std::vector<std::string>&;
+
+    // throws std::runtime_error for an unknown column
+    [[nodiscard]] auto column_index(std::string_view name) const -> std::size_t;
+
+    [[nodiscard]] auto num_rows() const -> std::uint64_t;
+    [[nodiscard]] auto chunks() const -> const std::vector<trajectory_chunk>&;
+
+    // false if the trailer was missing and the index was rebuilt
+    [[nodiscard]] auto complete() const -> bool;
+
+    [[nodiscard]] auto read_column(std::size_t column) -> std::vector<real>;
+
+    // rows with t_begin <= time <= t_end
+    [[nodiscard]] auto read_column(std::size_t column, real t_begin, real t_end) -> std::vector<real>;
+
+protected:
+
+    void read_index();
+    void scan_chunks();
+
+    // [bytes] start of the column block within the file
+    [[nodiscard]] auto column_offset(const trajectory_chunk& chunk, std::size_t column) const -> std::uint64_t;
+
+    void read_block(const trajectory_chunk& chunk, std::size_t column, std::vector<real>& values);
+    void read_bytes(std::uint64_t offset, void* data, std::uint64_t size);
+
+private:
+
+    std::ifstream                 _file;
+    std::uint64_t                 _file_size{};  // [bytes]
+    std::uint64_t                 _data_offset{};
+    std::vector<std::string>      _names;
+    std::vector<std::uint8_t>     _value_sizes;
+    std::vector<trajectory_chunk> _chunks;
+    std::vector<real>             _times;  // scratch for ranged reads
+    bool                          _complete{};
+};
+
+}  // namespace aos
@@ -5,11 +5,14 @@
 #include "aos/core/types.hpp"
 #include "aos/environment/environment.hpp"
 #include "aos/simulation/details/observer_impl.hpp"
+#include "aos/simulation/dynamics.hpp"
 #include "aos/simulation/observer.hpp"
+#include "aos/simulation/row_sink.hpp"
+#include "aos/verify/diagnostics.hpp"
 
 #include <memory>
-#include <ostream>
 #include <string>
+#include <vector>
 
 namespace aos {
 
@@ -19,15 +22,20 @@ public:
     verification_observer_impl(const std::string&                 filename,
                                std::shared_ptr<const spacecraft>  sat,
                                std::shared_ptr<const environment> env,
-                               const observer_properties&         props);
+                               const observer_properties&         props,
+                               std::shared_ptr<dynamics>          dyn);
 
-    auto write_header() -> std::ostream& override;
-    auto write(const system_state& state, real time) -> std::ostream& override;
+protected:
+
+    void append_columns(std::vector<observer_column>& columns) const override;
+    void append_values(const system_state& state, real time, std::vector<real>& row) const override;
 
 private:
 
     std::shared_ptr<const spacecraft>  _sat;
     std::shared_ptr<const environment> _env;
+    std::shared_ptr<const dynamics>    _dynamics;  // optional
+    std::vector<diagnostic_channel>    _channels;  // [observer] diagnostics
 };
 
 }  // namespace aos
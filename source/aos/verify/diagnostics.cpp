@@ -0,0 +1,176 @@
+#include "diagnostics.hpp"
+
+#include "aos/components/spacecraft.hpp"
+#include "aos/components/spacecraft_face.hpp"
+#include "aos/core/state.hpp"
+#include "aos/core/types.hpp"
+#include "aos/environment/environment.hpp"
+#include "aos/simulation/dynamics.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <format>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace aos {
+
+diagnostic_context::diagnostic_context(const spacecraft& sat, const environment& env, const dynamics* dyn, const system_state& state, real time)
+    : _sat(&sat), _env(&env), _dynamics(dyn), _state(&state), _time(time) {}
+
+auto diagnostic_context::satellite() const -> const spacecraft& {
+    return *_sat;
+}
+
+auto diagnostic_context::state() const -> const system_state& {
+    return *_state;
+}
+
+auto diagnostic_context::attitude_inverse() const -> quat {
+    return _state->attitude.conjugate();
+}
+
+auto diagnostic_context::effects() -> const environment_effects& {
+    if (not _environment) {
+        _environment = observed_environment(*_env, _dynamics, *_state, _time);
+    }
+    return *_environment;
+}
+
+auto diagnostic_context::field_body() -> vec3 {
+    return attitude_inverse() * effects().magnetic_field_eci_T;
+}
+
+auto diagnostic_context::faces() -> const face_effects_with_forces& {
+    if (not _faces) {
+        _faces = _sat->faces().compute_faces_effects_with_forces(effects(), attitude_inverse(), _state->angular_velocity_m_s);
+    }
+    return *_faces;
+}
+
+void diagnostics_registry::add(diagnostic_channel channel) {
+    if (std::ranges::any_of(_channels, [&](const auto& c) { return c.name == channel.name; })) {
+        throw std::invalid_argument("Duplicate diagnostic channel: " + channel.name);
+    }
+    _channels.push_back(std::move(channel));
+}
+
+auto diagnostics_registry::channels() const -> const std::vector<diagnostic_channel>& {
+    return _channels;
+}
+
+auto diagnostics_registry::select(const std::vector<std::string>& names) const -> std::vector<diagnostic_channel> {
+    for (const auto& name : names) {
+        if (std::ranges::none_of(_channels, [&](const auto& c) { return c.name == name; })) {
+            throw std::invalid_argument("Unknown diagnostic channel: " + name);
+        }
+    }
+
+    std::vector<diagnostic_channel> selected;
+    for (const auto& channel : _channels) {
+        if (names.empty() || std::ranges::find(names, channel.name) != names.end()) {
+            selected.push_back(channel);
+        }
+    }
+    return selected;
+}
+
+namespace {
+
+auto vector_columns(const std::string& prefix) -> diagnostic_channel::columns_function {
+    return [prefix](const spacecraft& /*sat*/) { return std::vector<std::string>{prefix + "_x", prefix + "_y", prefix + "_z"}; };
+}
+
+auto scalar_columns(const std::string& name) -> diagnostic_channel::columns_function {
+    return [name](const spacecraft& /*sat*/) { return std::vector<std::string>{name}; };
+}
+
+void append(std::vector<real>& row, const vec3& v) {
+    row.insert(row.end(), {v.x(), v.y(), v.z()});
+}
+
+// one channel of three columns, name_x to name_z
+auto vector_channel(const std::string& name, std::function<vec3(diagnostic_context&)> value) -> diagnostic_channel {
+    return {
+        .name    = name,
+        .columns = vector_columns(name),
+        .compute = [value = std::move(value)](diagnostic_context& ctx, std::vector<real>& row) { append(row, value(ctx)); },
+    };
+}
+
+auto scalar_channel(const std::string& name, std::function<real(diagnostic_context&)> value) -> diagnostic_channel {
+    return {
+        .name    = name,
+        .columns = scalar_columns(name),
+        .compute = [value = std::move(value)](diagnostic_context& ctx, std::vector<real>& row) { row.push_back(value(ctx)); },
+    };
+}
+
+// prefix_f<i>_x to prefix_f<i>_z for every face
+auto face_channel(const std::string& name, const std::string& prefix, vec3 face_forces::* member) -> diagnostic_channel {
+    return {
+        .name = name,
+        .columns =
+            [prefix](const spacecraft& sat) {
+                std::vector<std::string> columns;
+                for (std::size_t i = 0; i < sat.faces().size(); ++i) {
+                    for (const char* axis : {"x", "y", "z"}) {
+                        columns.push_back(std::format("{}_f{}_{}", prefix, i, axis));
+                    }
+                }
+                return columns;
+            },
+        .compute =
+            [member](diagnostic_context& ctx, std::vector<real>& row) {
+                for (const auto& forces : ctx.faces().forces_body) {
+                    append(row, forces.*member);
+                }
+            },
+    };
+}
+
+}  // namespace
+
+auto diagnostics_registry::builtin() -> diagnostics_registry {
+    diagnostics_registry registry;
+
+    // Sun + Mag + Grav
+    registry.add(vector_channel("sun", [](diagnostic_context& ctx) { return ctx.effects().r_sun_eci; }));
+    registry.add(vector_channel("mag", [](diagnostic_context& ctx) { return ctx.effects().magnetic_field_eci_T; }));
+    registry.add(vector_channel("mag_dot", [](diagnostic_context& ctx) { return ctx.effects().magnetic_field_dot_eci_T_s; }));
+    registry.add(vector_channel("grav", [](diagnostic_context& ctx) { return ctx.effects().gravity_eci_m_s2; }));
+
+    // Mag + Grav + Gyro Torques
+    registry.add(vector_channel("t_mag", [](diagnostic_context& ctx) { return ctx.satellite().magnet().compute_torque(ctx.field_body()); }));
+    registry.add(vector_channel("t_grav", [](diagnostic_context& ctx) {
+        const vec3 r_body = ctx.attitude_inverse() * ctx.state().position_m;
+        return ctx.satellite().inertia().compute_gravity_gradient_torque(r_body, ctx.effects().earth_mu);
+    }));
+    registry.add(vector_channel("t_gyro", [](diagnostic_context& ctx) {
+        return ctx.satellite().inertia().compute_gyroscopic_torque(ctx.state().angular_velocity_m_s);
+    }));
+
+    // Rods + Face Torques + Face Forces
+    registry.add(vector_channel("t_rods", [](diagnostic_context& ctx) {
+        return ctx.satellite().hystresis().compute_rod_torques(ctx.state().rod_magnetizations, ctx.field_body());
+    }));
+    registry.add(vector_channel("t_face", [](diagnostic_context& ctx) { return ctx.faces().torque_body; }));
+    registry.add(vector_channel("f_face", [](diagnostic_context& ctx) { return ctx.faces().force_body; }));
+
+    // Per-Face Drag + SRP (Body Frame)
+    registry.add(face_channel("face_drag", "d", &face_forces::force_drag_body));
+    registry.add(face_channel("face_srp", "s", &face_forces::force_srp_body));
+
+    // Environment
+    registry.add(scalar_channel("rho", [](diagnostic_context& ctx) { return ctx.effects().atmospheric_density_kg_m3; }));
+    registry.add(scalar_channel("shadow", [](diagnostic_context& ctx) { return ctx.effects().shadow_factor; }));
+    registry.add(scalar_channel("solar_p", [](diagnostic_context& ctx) { return ctx.effects().solar_pressure_Pa; }));
+    registry.add(vector_channel("v_rel", [](diagnostic_context& ctx) { return ctx.effects().v_earth_rel; }));
+
+    return registry;
+}
+
+}  // namespace aos
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "aos/components/spacecraft.hpp"
+#include "aos/components/spacecraft_face.hpp"
+#include "aos/core/state.hpp"
+#include "aos/core/types.hpp"
+#include "aos/environment/environment.hpp"
+#include "aos/simulation/dynamics.hpp"
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace aos {
+
+// inputs of the diagnostic channels for one observed state, the expensive ones evaluated on first use
+class diagnostic_context {
+public:
+
+    // dyn may be null, otherwise its recorded environment is used when it belongs to this state
+    diagnostic_context(const spacecraft& sat, const environment& env, const dynamics* dyn, const system_state& state, real time);
+
+    [[nodiscard]] auto satellite() const -> const spacecraft&;
+    [[nodiscard]] auto state() const -> const system_state&;
+    [[nodiscard]] auto attitude_inverse() const -> quat;
+
+    [[nodiscard]] auto effects() -> const environment_effects&;     // environment at the state
+    [[nodiscard]] auto field_body() -> vec3;                        // [T] magnetic field in the body frame
+    [[nodiscard]] auto faces() -> const face_effects_with_forces&;  // drag and srp, total and per face
+
+private:
+
+    const spacecraft*                       _sat;
+    const environment*                      _env;
+    const dynamics*                         _dynamics;
+    const system_state*                     _state;
+    real                                    _time;
+    std::optional<environment_effects>      _environment;
+    std::optional<face_effects_with_forces> _faces;
+};
+
+// named group of output columns computed from a diagnostic_context
+struct diagnostic_channel {
+    using columns_function = std::function<std::vector<std::string>(const spacecraft&)>;
+    using compute_function = std::function<void(diagnostic_context&, std::vector<real>&)>;
+
+    std::string      name;     // as listed in [observer] diagnostics
+    columns_function columns;  // column names, one value each
+    compute_function compute;  // appends the values in column order
+};
+
+/**
+ * @brief Diagnostic channels available to the verification observer.
+ *
+ * The observer writes the channels listed in `[observer] diagnostics`, in registry order, and computes only those: the
+ * environment is evaluated only if a selected channel reads it, the per-face forces only if a face channel is selected.
+ * builtin() holds the channels of the full verification output (environment inputs, torques, face forces).
+ */
+class diagnostics_registry {
+public:
+
+    // throws std::invalid_argument if the name is taken
+    void add(diagnostic_channel channel);
+
+    [[nodiscard]] auto channels() const -> const std::vector<diagnostic_channel>&;
+
+    // the named channels in registry order, every channel if names is empty; throws std::invalid_argument for an unknown name
+    [[nodiscard]] auto select(const std::vector<std::string>& names) const -> std::vector<diagnostic_channel>;
+
+    static auto builtin() -> diagnostics_registry;
+
+private:
+
+    std::vector<diagnostic_channel> _channels;
+};
+
+}  // namespace aos
@@ -2,19 +2,22 @@
 
 #include "aos/components/spacecraft.hpp"
 #include "aos/environment/environment.hpp"
+#include "aos/simulation/dynamics.hpp"
 #include "aos/simulation/observer.hpp"
 #include "aos/verify/details/verification_observer_impl.hpp"
 
 #include <memory>
 #include <string>
+#include <utility>
 
 namespace aos {
 
 auto verification_observer::create(const std::string&                 filename,
                                    std::shared_ptr<const spacecraft>  satellite,
                                    std::shared_ptr<const environment> environment,
-                                   const observer_properties&         properties) -> std::shared_ptr<observer> {
-    return std::make_shared<verification_observer_impl>(filename, satellite, environment, properties);
+                                   const observer_properties&         properties,
+                                   std::shared_ptr<dynamics>          dynamics) -> std::shared_ptr<observer> {
+    return std::make_shared<verification_observer_impl>(filename, std::move(satellite), std::move(environment), properties, std::move(dynamics));
 }
 
 }  // namespace aos
@@ -1,5 +1,6 @@
 #include "aos/components/spacecraft.hpp"
 #include "aos/environment/environment.hpp"
+#include "aos/simulation/dynamics.hpp"
 #include "aos/simulation/observer.hpp"
 
 #include <memory>
@@ -10,10 +11,13 @@ namespace aos {
 class verification_observer {
 public:
 
+    // with the dynamics of the run, a row reuses the environment its last right-hand side evaluation computed at the
+    // observed state (see step_diagnostics) and evaluates it only for other states, e.g. interpolated samples
     static auto create(const std::string&                 filename,
                        std::shared_ptr<const spacecraft>  satellite,
                        std::shared_ptr<const environment> environment,
-                       const observer_properties&         properties) -> std::shared_ptr<observer>;
+                       const observer_properties&         properties,
+                       std::shared_ptr<dynamics>          dynamics = nullptr) -> std::shared_ptr<observer>;
 };
 
 }  // namespace aos
@@ -0,0 +1,35 @@
+#include "aos/benchmark/csv_writer.hpp"
+#include "aos/benchmark/langevin.hpp"
+
+#include <algorithm>
+#include <array>
+#include <exception>
+#include <functional>
+#include <print>
+#include <span>
+#include <string_view>
+#include <utility>
+
+auto main(int argc, char** argv) -> int {
+    using benchmark_entry = std::pair<std::string_view, std::function<void()>>;
+
+    const auto benchmarks = std::to_array<benchmark_entry>({
+        {"csv_writer", aos::benchmark_csv_writer},
+        {"langevin", aos::benchmark_langevin},
+    });
+
+    const auto args = std::span(argv, argc).subspan(1);
+
+    try {
+        for (const auto& [name, function] : benchmarks) {
+            const bool selected = args.empty() || std::ranges::any_of(args, [&](const char* arg) { return name == arg; });
+            if (selected) {
+                function();
+            }
+        }
+        return 0;
+    } catch (const std::exception& ex) {
+        std::println(stderr, "Error: {}", ex.what());
+        return 1;
+    }
+}
@@ -0,0 +1,40 @@
+#include "aos/simulation/trajectory_extract.hpp"
+
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <print>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+// pmaos_extract <trajectory or segment manifest> <t_begin> <t_end> [output.csv]: rows of a time range as CSV, to stdout without output
+auto main(int argc, char** argv) -> int {
+    const auto args = std::span(argv, argc).subspan(1);
+    if (args.size() < 3 || args.size() > 4) {
+        std::println(stderr, "Usage: pmaos_extract <trajectory.csv|.bin|.segments> <t_begin> <t_end> [output.csv]");
+        return 1;
+    }
+
+    try {
+        const std::string filename = args[0];
+        const double      t_begin  = std::stod(args[1]);
+        const double      t_end    = std::stod(args[2]);
+
+        if (args.size() == 3) {
+            aos::extract_time_range(filename, t_begin, t_end, std::cout);
+            return 0;
+        }
+
+        std::ofstream output(args[3], std::ios::binary);
+        if (not output.is_open()) {
+            throw std::runtime_error(std::string("Could not open output file: ") + args[3]);
+        }
+        const auto rows = aos::extract_time_range(filename, t_begin, t_end, output);
+        std::println("{} rows in [{}, {}] s written to {}", rows, t_begin, t_end, args[3]);
+        return 0;
+    } catch (const std::exception& ex) {
+        std::println(stderr, "Error: {}", ex.what());
+        return 1;
+    }
+}
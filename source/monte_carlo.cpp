@@ -0,0 +1,41 @@
+#include "aos/batch/batch_runner.hpp"
+#include "aos/batch/monte_carlo.hpp"
+#include "aos/cli.hpp"
+#include "aos/simulation/config.hpp"
+
+#include <toml++/toml.hpp>
+
+#include <chrono>
+#include <exception>
+#include <print>
+
+auto main(int argc, char** argv) -> int {
+    aos::simulation_properties properties;
+    aos::batch_cli_options     options;
+    if (not aos::parse_batch_cli(argc, argv, properties, options)) {
+        return 1;
+    }
+
+    try {
+        aos::monte_carlo_properties spec;
+        if (const auto* table = toml::parse_file(options.spec_path)["monte_carlo"].as_table()) {
+            spec.from_toml(*table);
+        }
+        spec.debug_print();
+
+        const auto        start  = std::chrono::steady_clock::now();
+        const auto        design = aos::sample_monte_carlo(properties, spec);
+        aos::batch_runner runner(properties.environment, options.threads);
+
+        std::println("Running {} samples on {} threads", design.jobs.size(), runner.num_threads());
+        const auto results = runner.run(design, options.ensemble_lanes);
+        aos::batch_runner::write_table(options.output_path, design, results);
+
+        const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::println("Wrote {} ({:.1f} s)", options.output_path, seconds);
+        return 0;
+    } catch (const std::exception& ex) {
+        std::println(stderr, "Error: {}", ex.what());
+        return 1;
+    }
+}
@@ -21,8 +21,8 @@ auto main(int argc, char** argv) -> int {
     try {
         auto satellite   = aos::spacecraft::create(properties.satellite);
         auto environment = aos::environment::create(properties.environment);
-        auto dynamics    = aos::dynamics::create(satellite, environment);
-        auto observer    = aos::verification_observer::create(output_path, satellite, environment, properties.observer);
+        auto dynamics    = aos::dynamics::create(satellite, environment, properties.models);
+        auto observer    = aos::verification_observer::create(output_path, satellite, environment, properties.observer, dynamics);
         std::make_unique<aos::simulation>(properties, satellite, environment, dynamics, observer)->run();
         return 0;
     } catch (const std::exception& ex) {
@@ -0,0 +1,63 @@
+"""
+Reader for the live telemetry ring a running simulation publishes with [observer.telemetry] name = "/...".
+
+The ring is a POSIX shared-memory object (Linux: /dev/shm/<name>) laid out as in telemetry_format.hpp. Reading never
+blocks the simulation: a copy is kept only if the seqlock sequence was even and unchanged around it, otherwise retried.
+"""
+
+import mmap
+import os
+import struct
+
+import numpy as np
+import pandas as pd
+
+MAGIC = b"PMAOSTLM"
+VERSION = 1
+HEADER = struct.Struct("=8sIIQQQQ")    # magic, version, num_columns, capacity, names_offset, names_size, data_offset
+COUNTERS = struct.Struct("=QQQ")       # sequence, count, finished
+COUNTERS_OFFSET = 64
+
+
+class Telemetry:
+    def __init__(self, name):
+        with open(os.path.join("/dev/shm", name.lstrip("/")), "rb") as f:
+            self._map = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+
+        magic, version, self.num_columns, self.capacity, names_offset, names_size, self._data_offset = HEADER.unpack_from(self._map, 0)
+        if magic != MAGIC or version != VERSION:
+            self._map.close()
+            raise ValueError(f"{name} is not a telemetry ring (or not initialized yet)")
+        self.columns = self._map[names_offset:names_offset + names_size].decode().split(",")
+
+    def _counters(self):
+        return COUNTERS.unpack_from(self._map, COUNTERS_OFFSET)
+
+    @property
+    def finished(self):
+        """True once the simulation ended; the data stays readable until close()."""
+        return self._counters()[2] == 1
+
+    def latest(self, n=1):
+        """DataFrame of the newest n samples (fewer if not published yet), oldest first."""
+        slot_bytes = self.num_columns * 8
+        while True:
+            sequence, count, _ = self._counters()
+            if sequence % 2:
+                continue
+
+            num = min(n, count, self.capacity)
+            first = (count - num) % self.capacity
+            head = min(num, self.capacity - first)  # the copy wraps around the end of the ring at most once
+            begin = self._data_offset + first * slot_bytes
+            data = self._map[begin:begin + head * slot_bytes]
+            data += self._map[self._data_offset:self._data_offset + (num - head) * slot_bytes]
+
+            if self._counters()[0] == sequence:
+                break
+
+        values = np.frombuffer(data, dtype="=f8").reshape(-1, self.num_columns)
+        return pd.DataFrame(values, columns=self.columns)
+
+    def close(self):
+        self._map.close()
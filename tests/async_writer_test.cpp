@@ -0,0 +1,126 @@
+#include "aos/core/types.hpp"
+#include "aos/simulation/details/async_writer.hpp"
+#include "aos/simulation/row_sink.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <print>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using aos::async_writer;
+using aos::observer_column;
+using aos::real;
+using aos::row_sink;
+
+auto failures = 0;
+
+void check(bool condition, std::string_view what) {
+    if (not condition) {
+        std::println(stderr, "FAILED: {}", what);
+        ++failures;
+    }
+}
+
+// counts what reaches it, flushes slowly and throws once it has taken fail_after rows
+class test_sink : public row_sink {
+public:
+
+    explicit test_sink(std::size_t fail_after) : _fail_after(fail_after) {}
+
+    void write_header(std::span<const observer_column> columns) override {
+        headers.fetch_add(columns.empty() ? 0 : 1);
+    }
+
+    void write_rows(std::span<const real> /*values*/, std::size_t num_rows) override {
+        if (rows.fetch_add(num_rows) + num_rows > _fail_after) {
+            throw std::runtime_error("disk full");
+        }
+    }
+
+    void flush() override {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        flushes.fetch_add(1);
+    }
+
+    [[nodiscard]] auto size() const -> std::uint64_t override {
+        return 0;
+    }
+
+    std::atomic<int>         headers{};
+    std::atomic<std::size_t> rows{};
+    std::atomic<int>         flushes{};
+
+private:
+
+    std::size_t _fail_after;
+};
+
+const std::vector<observer_column> columns = {{"time"}, {"x"}};
+const std::vector<real>            row     = {0.0, 1.0};
+
+// flush() returns only after the sink flush it asked for, also when no rows came in since the previous one
+void flush_waits_for_the_sink() {
+    auto  sink = std::make_unique<test_sink>(SIZE_MAX);
+    auto& seen = *sink;
+
+    async_writer writer(std::move(sink), 16);
+    writer.write_header(columns);
+    writer.write(row);
+    writer.flush();
+    check(seen.flushes == 1, "flush: first sink flush completed");
+    writer.flush();
+    check(seen.flushes == 2, "flush: repeated sink flush completed");
+
+    writer.write_header(columns);
+    writer.flush();
+    check(seen.headers == 2 && seen.rows == 1, "flush: second header written after the rows of the first");
+}
+
+// a throwing sink surfaces on the producer thread instead of terminating the process
+void sink_errors_rethrow() {
+    async_writer writer(std::make_unique<test_sink>(3), 4);
+    writer.write_header(columns);
+
+    auto thrown = false;
+    try {
+        for (int i = 0; i < 1000; ++i) {
+            writer.write(row);
+        }
+        writer.flush();
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    check(thrown, "error: sink exception rethrown by write or flush");
+
+    thrown = false;
+    try {
+        writer.flush();
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    check(thrown, "error: later calls keep rethrowing");
+}
+
+}  // namespace
+
+auto main() -> int {
+    flush_waits_for_the_sink();
+    sink_errors_rethrow();
+
+    if (failures > 0) {
+        std::println(stderr, "{} check(s) failed", failures);
+        return EXIT_FAILURE;
+    }
+    std::println("all checks passed");
+    return EXIT_SUCCESS;
+}
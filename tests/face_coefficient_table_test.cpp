@@ -0,0 +1,119 @@
+#include "aos/components/face_coefficient_table.hpp"
+#include "aos/components/spacecraft_face.hpp"
+#include "aos/core/types.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <print>
+#include <string_view>
+
+namespace {
+
+using aos::face_coefficient_table;
+using aos::face_table_properties;
+using aos::real;
+using aos::spacecraft_face;
+using aos::spacecraft_face_list;
+using aos::vec3;
+
+constexpr real tolerance = 1e-9;
+
+auto failures = 0;
+
+void check(bool condition, std::string_view what) {
+    if (not condition) {
+        std::println(stderr, "FAILED: {}", what);
+        ++failures;
+    }
+}
+
+auto square_face(const vec3& center, const vec3& normal, real side) -> spacecraft_face {
+    return {
+        .center_of_pressure_m            = center,
+        .surface_normal                  = normal,
+        .surface_area_m2                 = side * side,
+        .drag_coefficient                = 2.2,
+        .specular_reflection_coefficient = 0.1,
+        .diffuse_reflection_coefficient  = 0.2,
+        .outline                         = {},
+    };
+}
+
+auto cube(real side) -> spacecraft_face_list {
+    spacecraft_face_list faces;
+    for (int axis = 0; axis < 3; ++axis) {
+        for (const real sign : {1.0, -1.0}) {
+            const vec3 normal = sign * vec3::Unit(axis);
+            faces.push_back(square_face(0.5 * side * normal, normal, side));
+        }
+    }
+    return faces;
+}
+
+auto table(const spacecraft_face_list& faces, bool self_shadowing) {
+    face_table_properties properties;
+    properties.self_shadowing = self_shadowing;
+    return face_coefficient_table::create(faces, properties);
+}
+
+// a two-sided panel is two coincident faces with opposite normals, the lit side must not be hidden by its back
+void two_sided_panel() {
+    for (const real sign : {1.0, -1.0}) {
+        const spacecraft_face_list faces{
+            square_face(vec3::Zero(), -sign * vec3::UnitZ(), 0.2),
+            square_face(vec3::Zero(), sign * vec3::UnitZ(), 0.2),
+        };
+        const auto shadowed   = table(faces, true);
+        const auto unshadowed = table(faces, false);
+
+        const vec3 sun_dir = sign * vec3::UnitZ();
+        check((shadowed->srp(sun_dir).force - unshadowed->srp(sun_dir).force).norm() <= tolerance * unshadowed->srp(sun_dir).force.norm(),
+              "two-sided panel: lit side receives the full radiation pressure");
+        check(std::abs(shadowed->drag(-sun_dir).force - unshadowed->drag(-sun_dir).force) <= tolerance * unshadowed->drag(-sun_dir).force,
+              "two-sided panel: windward side receives the full flow");
+    }
+}
+
+// faces of a convex body never shadow each other, also not along their shared edges
+void convex_body() {
+    const auto shadowed   = table(cube(0.1), true);
+    const auto unshadowed = table(cube(0.1), false);
+
+    for (const vec3& dir : {vec3(1.0, 1.0, 1.0).normalized(), vec3(0.3, -0.5, 0.8).normalized(), vec3(1.0, 0.0, 0.0)}) {
+        check((shadowed->srp(dir).force - unshadowed->srp(dir).force).norm() <= tolerance * unshadowed->srp(dir).force.norm(),
+              "convex body: srp force matches the unshadowed sum");
+        check(std::abs(shadowed->drag(dir).force - unshadowed->drag(dir).force) <= tolerance * unshadowed->drag(dir).force,
+              "convex body: drag force matches the unshadowed sum");
+    }
+}
+
+// a panel above the body shadows its top face, with either side facing the sun
+void occluding_panel() {
+    const vec3 sun_dir = vec3::UnitZ();
+    for (const real sign : {1.0, -1.0}) {
+        const spacecraft_face panel = square_face(vec3(0.0, 0.0, 0.2), sign * sun_dir, 0.3);
+
+        spacecraft_face_list faces = cube(0.1);
+        faces.push_back(panel);
+
+        // only the panel itself may receive light, and only when its front faces the sun
+        const vec3 expected = sign > 0.0 ? table({panel}, false)->srp(sun_dir).force : vec3::Zero();
+        check((table(faces, true)->srp(sun_dir).force - expected).norm() <= tolerance * table(cube(0.1), false)->srp(sun_dir).force.norm(),
+              "occluding panel: the body behind it is dark");
+    }
+}
+
+}  // namespace
+
+auto main() -> int {
+    two_sided_panel();
+    convex_body();
+    occluding_panel();
+
+    if (failures > 0) {
+        std::println(stderr, "{} check(s) failed", failures);
+        return EXIT_FAILURE;
+    }
+    std::println("all checks passed");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,78 @@
+#include "aos/components/hysteresis_rod.hpp"
+#include "aos/components/permanent_magnet.hpp"
+#include "aos/components/spacecraft.hpp"
+#include "aos/core/types.hpp"
+#include "aos/simulation/stop_criteria.hpp"
+
+#include <cstdlib>
+#include <print>
+#include <stdexcept>
+#include <string_view>
+
+namespace {
+
+using aos::permanent_magnet_cylindrical;
+using aos::spacecraft_properties;
+using aos::stop_criteria;
+using aos::stop_criteria_properties;
+using aos::vec3;
+
+auto failures = 0;
+
+void check(bool condition, std::string_view what) {
+    if (not condition) {
+        std::println(stderr, "FAILED: {}", what);
+        ++failures;
+    }
+}
+
+auto satellite(int rods) -> spacecraft_properties {
+    spacecraft_properties properties{};
+    properties.mass_kg = 1.3;
+
+    properties.magnet = {
+        .remanence_t           = 1.0,
+        .relative_permeability = 1.05,
+        .orientation           = vec3::UnitZ(),
+        .shape                 = permanent_magnet_cylindrical{.length_m = 0.002, .radius_m = 0.0075},
+    };
+    for (int rod = 0; rod < rods; ++rod) {
+        properties.rods.push_back({.volume_m3 = 2e-7, .orientation = vec3::Unit(rod), .hysteresis = {}});
+    }
+    return properties;
+}
+
+auto throws_invalid_argument(const stop_criteria_properties& properties, const spacecraft_properties& satellite) -> bool {
+    try {
+        const stop_criteria criteria(properties, satellite);
+    } catch (const std::invalid_argument&) {
+        return true;
+    }
+    return false;
+}
+
+// a rod energy plateau cannot be measured without rods, the criterion must not pass silently
+void rod_energy_needs_rods() {
+    stop_criteria_properties properties;
+    properties.rod_energy_tolerance = 0.01;
+
+    check(throws_invalid_argument(properties, satellite(0)), "rod_energy without rods throws");
+    check(not throws_invalid_argument(properties, satellite(2)), "rod_energy with rods is accepted");
+
+    properties.rod_energy_tolerance = 0.0;
+    properties.pointing_deg         = 10.0;
+    check(not throws_invalid_argument(properties, satellite(0)), "other criteria without rods are accepted");
+}
+
+}  // namespace
+
+auto main() -> int {
+    rod_energy_needs_rods();
+
+    if (failures > 0) {
+        std::println(stderr, "{} check(s) failed", failures);
+        return EXIT_FAILURE;
+    }
+    std::println("all checks passed");
+    return EXIT_SUCCESS;
+}
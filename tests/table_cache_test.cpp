@@ -0,0 +1,97 @@
+#include "aos/components/hysteresis_rod.hpp"
+#include "aos/components/spacecraft_face.hpp"
+#include "aos/components/table_cache.hpp"
+#include "aos/core/types.hpp"
+
+#include <cstdlib>
+#include <memory>
+#include <print>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using aos::everett_table;
+using aos::face_table_properties;
+using aos::hysteresis_parameters;
+using aos::hysteresis_table_properties;
+using aos::preisach_parameters;
+using aos::real;
+using aos::spacecraft_face;
+using aos::spacecraft_face_list;
+using aos::table_cache;
+using aos::vec3;
+
+auto failures = 0;
+
+void check(bool condition, std::string_view what) {
+    if (not condition) {
+        std::println(stderr, "FAILED: {}", what);
+        ++failures;
+    }
+}
+
+auto panel(real area) -> spacecraft_face_list {
+    return {{
+        .center_of_pressure_m            = vec3::Zero(),
+        .surface_normal                  = vec3::UnitX(),
+        .surface_area_m2                 = area,
+        .drag_coefficient                = 2.2,
+        .specular_reflection_coefficient = 0.1,
+        .diffuse_reflection_coefficient  = 0.2,
+        .outline                         = {},
+    }};
+}
+
+// equal keys share one table, different keys get their own
+void shared_by_key() {
+    table_cache tables;
+
+    auto material  = hysteresis_parameters::hymu80();
+    material.table = hysteresis_table_properties{};
+
+    auto other = material;
+    other.k *= 2.0;
+
+    check(tables.hysteresis(material) == tables.hysteresis(material), "hysteresis: same material, same table");
+    check(tables.hysteresis(material) != tables.hysteresis(other), "hysteresis: other material, other table");
+
+    const face_table_properties properties;
+    check(tables.face_coefficients(panel(0.01), properties) == tables.face_coefficients(panel(0.01), properties), "faces: same geometry, same table");
+    check(tables.face_coefficients(panel(0.01), properties) != tables.face_coefficients(panel(0.02), properties), "faces: other geometry, other table");
+}
+
+// concurrent callers wait for the single build instead of repeating it
+void built_once_concurrently() {
+    table_cache tables;
+
+    auto material  = preisach_parameters::hymu80();
+    material.nodes = 65;
+
+    std::vector<std::shared_ptr<const everett_table>> results(8);
+    {
+        std::vector<std::jthread> threads;
+        for (auto& result : results) {
+            threads.emplace_back([&] { result = tables.everett(material); });
+        }
+    }
+
+    for (const auto& result : results) {
+        check(result != nullptr and result == results.front(), "everett: one table for all threads");
+    }
+}
+
+}  // namespace
+
+auto main() -> int {
+    shared_by_key();
+    built_once_concurrently();
+
+    if (failures > 0) {
+        std::println(stderr, "{} check(s) failed", failures);
+        return EXIT_FAILURE;
+    }
+    std::println("all checks passed");
+    return EXIT_SUCCESS;
+}
@@ -33,23 +33,25 @@
 /* ------------------------- SHARED VARIABLES ------------------------ */
 /* ------------------------------------------------------------------- */
 
+/* scratch variables are per thread so concurrent gtd7 calls do not race */
+
 /* PARMB */
-static double gsurf;
-static double re;
+static _Thread_local double gsurf;
+static _Thread_local double re;
 
 /* GTS3C */
-static double dd;
+static _Thread_local double dd;
 
 /* DMIX */
-static double dm04, dm16, dm28, dm32, dm40, dm01, dm14;
+static _Thread_local double dm04, dm16, dm28, dm32, dm40, dm01, dm14;
 
 /* MESO7 */
-static double meso_tn1[5];
-static double meso_tn2[4];
-static double meso_tn3[5];
-static double meso_tgn1[2];
-static double meso_tgn2[2];
-static double meso_tgn3[2];
+static _Thread_local double meso_tn1[5];
+static _Thread_local double meso_tn2[4];
+static _Thread_local double meso_tn3[5];
+static _Thread_local double meso_tgn1[2];
+static _Thread_local double meso_tgn2[2];
+static _Thread_local double meso_tgn3[2];
 
 /* POWER7 */
 extern double pt[150];
@@ -66,12 +68,12 @@ extern double pdm[8][10];
 extern double pavgm[10];
 
 /* LPOLY */
-static double dfa;
-static double plg[4][9];
-static double ctloc, stloc;
-static double c2tloc, s2tloc;
-static double s3tloc, c3tloc;
-static double apdf, apt[4];
+static _Thread_local double dfa;
+static _Thread_local double plg[4][9];
+static _Thread_local double ctloc, stloc;
+static _Thread_local double c2tloc, s2tloc;
+static _Thread_local double s3tloc, c3tloc;
+static _Thread_local double apdf, apt[4];
 
 
 
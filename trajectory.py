@@ -0,0 +1,168 @@
+"""
+Loader for simulation output: CSV, or the binary columnar format written with [observer] format = "binary".
+
+Binary files are memory-mapped; every column of a chunk is a contiguous little-endian array, so a column that lives in
+a single chunk is returned as a zero-copy view and only the pages of the requested columns are touched. A CSV file with
+a sidecar time index (<file>.idx, [observer] index_rows) is read only between the index entries around a time range.
+Segmented output ([observer.segments]) is read through its manifest <file>.segments, only segments in range are opened.
+"""
+
+import io
+import os
+import struct
+
+import numpy as np
+import pandas as pd
+
+MAGIC = b"PMAOSTRJ"
+SEGMENT_MANIFEST_HEADER = b"segment,file,t_first,t_last,rows,bytes"
+INDEX_MAGIC = b"PMAOSIDX"
+ALIGNMENT = 64
+HEADER = struct.Struct("<8sIIQ")       # magic, version, num_columns, data_offset
+CHUNK = np.dtype([("t_first", "<f8"), ("t_last", "<f8"), ("offset", "<u8"), ("num_rows", "<u8")])
+TRAILER = struct.Struct("<QQ8s")       # index_offset, num_chunks, magic
+
+
+def is_binary(path):
+    with open(path, "rb") as f:
+        return f.read(len(MAGIC)) == MAGIC
+
+
+def is_segment_manifest(path):
+    with open(path, "rb") as f:
+        return f.readline().rstrip(b"\r\n") == SEGMENT_MANIFEST_HEADER
+
+
+def read_segment_manifest(path):
+    """DataFrame (segment, file, t_first, t_last, rows, bytes) of the closed segments, file as a path next to the manifest."""
+    segments = pd.read_csv(path)
+    segments["file"] = [os.path.join(os.path.dirname(path), name) for name in segments["file"]]
+    return segments
+
+
+def _block_size(num_rows, value_size):
+    return (num_rows * value_size + 7) // 8 * 8
+
+
+class Trajectory:
+    """Columns of a binary trajectory file, read lazily from a memory map."""
+
+    def __init__(self, path):
+        self.buffer = np.memmap(path, dtype=np.uint8, mode="r")
+        magic, version, num_columns, self.data_offset = HEADER.unpack_from(self.buffer, 0)
+        if magic != MAGIC or version != 1:
+            raise ValueError(f"'{path}' is not a trajectory file")
+
+        self.columns, self.dtypes = [], []
+        offset = HEADER.size
+        for _ in range(num_columns):
+            value_size, _, length = struct.unpack_from("<BBH", self.buffer, offset)
+            self.columns.append(bytes(self.buffer[offset + 4:offset + 4 + length]).decode())
+            self.dtypes.append(np.dtype("<f8" if value_size == 8 else "<f4"))
+            offset += 4 + length
+
+        self.chunks = self._read_index()
+
+    def _read_index(self):
+        size = len(self.buffer)
+        if size >= self.data_offset + TRAILER.size:
+            index_offset, num_chunks, magic = TRAILER.unpack_from(self.buffer, size - TRAILER.size)
+            if magic == INDEX_MAGIC and index_offset + num_chunks * CHUNK.itemsize + TRAILER.size == size:
+                return np.frombuffer(self.buffer, dtype=CHUNK, count=num_chunks, offset=index_offset)
+
+        # unfinished file: walk the chunks
+        chunks, offset = [], self.data_offset
+        while offset + 8 <= size:
+            num_rows = int(np.frombuffer(self.buffer, dtype="<u8", count=1, offset=offset)[0])
+            chunk_size = 8 + sum(_block_size(num_rows, dtype.itemsize) for dtype in self.dtypes)
+            if num_rows == 0 or offset + chunk_size > size:
+                break
+            times = np.frombuffer(self.buffer, dtype="<f8", count=num_rows, offset=offset + 8)
+            chunks.append((times[0], times[-1], offset, num_rows))
+            offset += (chunk_size + ALIGNMENT - 1) // ALIGNMENT * ALIGNMENT
+        return np.array(chunks, dtype=CHUNK)
+
+    def _block(self, chunk, column):
+        offset = int(chunk["offset"]) + 8
+        num_rows = int(chunk["num_rows"])
+        for dtype in self.dtypes[:column]:
+            offset += _block_size(num_rows, dtype.itemsize)
+        return np.frombuffer(self.buffer, dtype=self.dtypes[column], count=num_rows, offset=offset)
+
+    def column(self, name, t_start=None, t_end=None):
+        """Values of one column, optionally restricted to t_start <= time <= t_end."""
+        column = self.columns.index(name)
+        chunks = self.chunks
+        if t_start is not None:
+            chunks = chunks[chunks["t_last"] >= t_start]
+        if t_end is not None:
+            chunks = chunks[chunks["t_first"] <= t_end]
+
+        blocks = [self._block(chunk, column) for chunk in chunks]
+        values = blocks[0] if len(blocks) == 1 else np.concatenate(blocks) if blocks else np.empty(0, self.dtypes[column])
+        if t_start is None and t_end is None:
+            return values
+
+        times = np.concatenate([self._block(chunk, 0) for chunk in chunks]) if len(chunks) else np.empty(0)
+        mask = np.ones(len(times), dtype=bool)
+        if t_start is not None:
+            mask &= times >= t_start
+        if t_end is not None:
+            mask &= times <= t_end
+        return values[mask]
+
+
+def read_csv_index(path):
+    """DataFrame (time, offset) of the sidecar index of a CSV file, None if it has none."""
+    try:
+        return pd.read_csv(path + ".idx")
+    except FileNotFoundError:
+        return None
+
+
+def _read_csv_window(path, index, columns, t_start, t_end):
+    """Rows between the index entries around [t_start, t_end]; the caller still filters by time."""
+    with open(path, "rb") as f:
+        names = [name.strip() for name in f.readline().decode().split(",")]
+        begin = f.tell()
+        end = None
+        if t_start is not None:
+            before = index[index["time"] < t_start]
+            if not before.empty:
+                begin = int(before["offset"].iloc[-1])
+        if t_end is not None:
+            after = index[index["time"] > t_end]
+            if not after.empty:
+                end = int(after["offset"].iloc[0])
+        f.seek(begin)
+        data = f.read() if end is None else f.read(max(end - begin, 0))
+    return pd.read_csv(io.BytesIO(data), header=None, names=names, usecols=columns)
+
+
+def read_dataframe(path, columns=None, t_start=None, t_end=None):
+    """DataFrame of a CSV or binary trajectory file or segment manifest; for binary files only the listed columns are read."""
+    if is_segment_manifest(path):
+        segments = read_segment_manifest(path)
+        if t_start is not None:
+            segments = segments[segments["t_last"] >= t_start]
+        if t_end is not None:
+            segments = segments[segments["t_first"] <= t_end]
+        frames = [read_dataframe(name, columns, t_start, t_end) for name in segments["file"]]
+        return pd.concat(frames, ignore_index=True) if frames else pd.DataFrame(columns=columns)
+
+    if not is_binary(path):
+        index = read_csv_index(path) if t_start is not None or t_end is not None else None
+        if index is not None and not index.empty:
+            df = _read_csv_window(path, index, columns, t_start, t_end)
+        else:
+            df = pd.read_csv(path, usecols=columns)
+            df.columns = df.columns.str.strip()
+        if t_start is not None:
+            df = df[df["time"] >= t_start]
+        if t_end is not None:
+            df = df[df["time"] <= t_end]
+        return df
+
+    trajectory = Trajectory(path)
+    names = trajectory.columns if columns is None else columns
+    return pd.DataFrame({name: trajectory.column(name, t_start, t_end) for name in names})